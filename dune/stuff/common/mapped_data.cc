@@ -0,0 +1,179 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include "mapped_data.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/stuff/common/exceptions.hh>
+
+namespace Dune {
+namespace Stuff {
+namespace Common {
+namespace {
+
+
+static const char cache_magic[8] = {'D', 'S', 'C', 'D', 'A', 'T', 'A', '\0'};
+static const std::uint64_t cache_version = 2;
+
+// 64 bytes, so the values following the header are aligned
+struct CacheHeader
+{
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t size;
+  std::uint64_t source_size;
+  std::int64_t source_mtime;
+  double min;
+  double max;
+  std::uint64_t checksum;
+}; // struct CacheHeader
+
+static_assert(sizeof(CacheHeader) == 64, "");
+
+
+//! FNV-1a on the bytes of the header before the checksum
+std::uint64_t checksum(const CacheHeader& header)
+{
+  const unsigned char* bytes = reinterpret_cast< const unsigned char* >(&header);
+  std::uint64_t hash = 14695981039346656037ull;
+  for (size_t ii = 0; ii < offsetof(CacheHeader, checksum); ++ii) {
+    hash ^= bytes[ii];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+} // ... checksum(...)
+
+
+} // namespace
+
+
+MappedDataFile::MappedDataFile(const std::string& filename, const std::string& cache_filename)
+  : cache_filename_(cache_filename.empty() ? filename + ".bin" : cache_filename)
+  , mapping_(nullptr)
+  , mapping_length_(0)
+  , data_(nullptr)
+  , size_(0)
+  , min_(std::numeric_limits< double >::max())
+  , max_(std::numeric_limits< double >::lowest())
+{
+  struct stat source;
+  const bool have_source = (::stat(filename.c_str(), &source) == 0);
+  const unsigned long long source_size = have_source ? source.st_size : 0;
+  const long long source_mtime = have_source ? source.st_mtime : 0;
+  if (map_cache(have_source, source_size, source_mtime))
+    return;
+  std::ifstream datafile(filename);
+  if (!datafile.is_open())
+    DUNE_THROW(Dune::IOError, "could not open '" << filename << "' (nor a valid '" << cache_filename_ << "')!");
+  double tmp = 0;
+  while (datafile >> tmp) {
+    values_.push_back(tmp);
+    min_ = std::min(min_, tmp);
+    max_ = std::max(max_, tmp);
+  }
+  datafile.close();
+  if (values_.empty())
+    DUNE_THROW(Dune::IOError, "'" << filename << "' does not contain any values!");
+  data_ = values_.data();
+  size_ = values_.size();
+  // map the values we just wrote, so they are shared with other processes
+  if (write_cache(source_size, source_mtime) && map_cache(true, source_size, source_mtime))
+    std::vector< double >().swap(values_);
+} // MappedDataFile(...)
+
+MappedDataFile::~MappedDataFile()
+{
+  if (mapping_)
+    ::munmap(mapping_, mapping_length_);
+}
+
+bool MappedDataFile::map_cache(const bool check_source,
+                               const unsigned long long source_size,
+                               const long long source_mtime)
+{
+  const int fd = ::open(cache_filename_.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat cache;
+  if (::fstat(fd, &cache) != 0 || size_t(cache.st_size) < sizeof(CacheHeader)) {
+    ::close(fd);
+    return false;
+  }
+  const size_t length = cache.st_size;
+  void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+  CacheHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  const double* values = reinterpret_cast< const double* >(static_cast< const char* >(mapping) + sizeof(header));
+  // the cache is moved into place only after it has been written completely, so checking the header suffices
+  const bool valid = std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0
+                     && header.version == cache_version
+                     && header.checksum == checksum(header)
+                     && header.size > 0
+                     && length == sizeof(header) + header.size*sizeof(double)
+                     && (!check_source
+                         || (header.source_size == source_size && header.source_mtime == source_mtime));
+  if (!valid) {
+    ::munmap(mapping, length);
+    return false;
+  }
+  if (mapping_)
+    ::munmap(mapping_, mapping_length_);
+  mapping_ = mapping;
+  mapping_length_ = length;
+  data_ = values;
+  size_ = header.size;
+  min_ = header.min;
+  max_ = header.max;
+  return true;
+} // ... map_cache(...)
+
+bool MappedDataFile::write_cache(const unsigned long long source_size, const long long source_mtime) const
+{
+  CacheHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+  header.version = cache_version;
+  header.size = size_;
+  header.source_size = source_size;
+  header.source_mtime = source_mtime;
+  header.min = min_;
+  header.max = max_;
+  header.checksum = checksum(header);
+  // several processes may do this at the same time, so each writes its own file and moves it into place
+  const std::string tmp_filename = cache_filename_ + "." + std::to_string(::getpid()) + ".tmp";
+  std::ofstream cache(tmp_filename, std::ios::binary | std::ios::trunc);
+  if (!cache.is_open())
+    return false;
+  cache.write(reinterpret_cast< const char* >(&header), sizeof(header));
+  cache.write(reinterpret_cast< const char* >(data_), size_*sizeof(double));
+  cache.close();
+  if (!cache || std::rename(tmp_filename.c_str(), cache_filename_.c_str()) != 0) {
+    std::remove(tmp_filename.c_str());
+    return false;
+  }
+  return true;
+} // ... write_cache(...)
+
+
+} // namespace Common
+} // namespace Stuff
+} // namespace Dune
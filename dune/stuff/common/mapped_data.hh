@@ -0,0 +1,98 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_COMMON_MAPPED_DATA_HH
+#define DUNE_STUFF_COMMON_MAPPED_DATA_HH
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Dune {
+namespace Stuff {
+namespace Common {
+
+
+/**
+ * \brief Read-only access to the numbers of a (large) ascii data file, backed by a memory mapped binary cache.
+ *
+ *        The first time an ascii file (whitespace separated numbers) is read, its values are written to a binary
+ *        cache file (cache_filename, filename + ".bin" by default). The cache starts with a header holding the number
+ *        of values, the size and modification time of the ascii file, the minimal and maximal value and a checksum of
+ *        the header. Subsequent reads only map the cache read-only into memory, provided its header is still valid for
+ *        the ascii file; the values themselves are not read (the cache is moved into place once it is complete).
+ *        Since the mapping is shared, all processes on a node reading the same file share the memory of its values.
+ *        The cache is also used if the ascii file does not exist.
+ *
+ *        If the cache can not be written (or mapped), the values are kept in memory instead.
+ */
+class MappedDataFile
+{
+public:
+  //! \throws Dune::IOError if neither filename nor a valid cache can be read, or if filename contains no values
+  explicit MappedDataFile(const std::string& filename, const std::string& cache_filename = "");
+
+  MappedDataFile(const MappedDataFile& other) = delete;
+
+  MappedDataFile& operator=(const MappedDataFile& other) = delete;
+
+  ~MappedDataFile();
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  const double* data() const
+  {
+    return data_;
+  }
+
+  const double& operator[](const size_t ii) const
+  {
+    return data_[ii];
+  }
+
+  double min() const
+  {
+    return min_;
+  }
+
+  double max() const
+  {
+    return max_;
+  }
+
+  //! true if the values are memory mapped from the cache
+  bool mapped() const
+  {
+    return mapping_ != nullptr;
+  }
+
+  const std::string& cache_filename() const
+  {
+    return cache_filename_;
+  }
+
+private:
+  bool map_cache(const bool check_source, const unsigned long long source_size, const long long source_mtime);
+  bool write_cache(const unsigned long long source_size, const long long source_mtime) const;
+
+  const std::string cache_filename_;
+  void* mapping_;
+  size_t mapping_length_;
+  std::vector< double > values_;
+  const double* data_;
+  size_t size_;
+  double min_;
+  double max_;
+}; // class MappedDataFile
+
+
+} // namespace Common
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_COMMON_MAPPED_DATA_HH
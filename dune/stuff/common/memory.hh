@@ -7,6 +7,10 @@
 #define DUNE_STUFF_MEMORY_HH
 
 #include <memory>
+#include <vector>
+#include <new>
+#include <cstdint>
+#include <algorithm>
 #include <boost/noncopyable.hpp>
 
 namespace Dune {
@@ -251,6 +255,132 @@ private:
 }; // class StorageProvider
 
 
+/**
+ *  \brief Places objects of arbitrary types in a few larger blocks of memory and destroys them all at once.
+ *
+ *  reset() destroys all objects in reverse order of creation but keeps the memory, so that an arena which is refilled
+ *  with objects of the same types after a reset() does not allocate any more. Objects created by new may be handed over
+ *  by adopt(), they are deleted on reset(). Not thread safe. Not copyable, but movable: the objects stay where they are
+ *  and belong to the new arena afterwards.
+ */
+class ObjectArena
+  : public boost::noncopyable
+{
+  typedef void (*DestroyType)(void*);
+
+public:
+  explicit ObjectArena(const size_t block_size = 1024)
+    : block_size_(block_size)
+    , current_block_(0)
+    , offset_(0)
+  {}
+
+  //! takes over all objects (and the memory) of other, which is left empty
+  ObjectArena(ObjectArena&& other)
+    : boost::noncopyable()
+    , block_size_(other.block_size_)
+    , blocks_(std::move(other.blocks_))
+    , current_block_(other.current_block_)
+    , offset_(other.offset_)
+    , objects_(std::move(other.objects_))
+  {
+    other.blocks_.clear();
+    other.current_block_ = 0;
+    other.offset_ = 0;
+    other.objects_.clear();
+  }
+
+  ~ObjectArena()
+  {
+    reset();
+  }
+
+  template< class T, class... Args >
+  T* create(Args&&... args)
+  {
+    reserve_record();
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward< Args >(args)...);
+    objects_.emplace_back(static_cast< void* >(object), &destroy< T >);
+    return object;
+  } // ... create(...)
+
+  //! takes ownership of object, which has to be created by new
+  template< class T >
+  T* adopt(T* object)
+  {
+    std::unique_ptr< T > guard(object);
+    reserve_record();
+    objects_.emplace_back(const_cast< void* >(static_cast< const void* >(guard.release())), &destroy_and_delete< T >);
+    return object;
+  } // ... adopt(...)
+
+  //! destroys all objects, the memory is kept for reuse
+  void reset()
+  {
+    for (auto it = objects_.rbegin(); it != objects_.rend(); ++it)
+      it->second(it->first);
+    objects_.clear();
+    current_block_ = 0;
+    offset_ = 0;
+  } // ... reset()
+
+  //! number of objects currently living in the arena
+  size_t size() const
+  {
+    return objects_.size();
+  }
+
+private:
+  struct Block
+  {
+    std::unique_ptr< char[] > memory;
+    size_t size;
+  };
+
+  template< class T >
+  static void destroy(void* object)
+  {
+    static_cast< T* >(object)->~T();
+  }
+
+  template< class T >
+  static void destroy_and_delete(void* object)
+  {
+    delete static_cast< T* >(object);
+  }
+
+  //! grows the record geometrically, so that emplace_back() cannot throw once the object exists
+  void reserve_record()
+  {
+    if (objects_.size() == objects_.capacity())
+      objects_.reserve(std::max(size_t(16), 2 * objects_.capacity()));
+  }
+
+  void* allocate(const size_t size, const size_t alignment)
+  {
+    for (; current_block_ < blocks_.size(); ++current_block_, offset_ = 0) {
+      Block& block = blocks_[current_block_];
+      const auto address = reinterpret_cast< std::uintptr_t >(block.memory.get()) + offset_;
+      const size_t padding = (alignment - address % alignment) % alignment;
+      if (offset_ + padding + size <= block.size) {
+        offset_ += padding + size;
+        return block.memory.get() + offset_ - size;
+      }
+    }
+    // none of the existing blocks has enough room left
+    const size_t new_size = std::max(block_size_, size + alignment);
+    blocks_.push_back(Block{std::unique_ptr< char[] >(new char[new_size]), new_size});
+    return allocate(size, alignment);
+  } // ... allocate(...)
+
+  const size_t block_size_;
+  std::vector< Block > blocks_;
+  size_t current_block_;
+  size_t offset_;
+  std::vector< std::pair< void*, DestroyType > > objects_;
+}; // class ObjectArena
+
+
 } // namespace Common
 } // namespace Stuff
 } // namespace Dune
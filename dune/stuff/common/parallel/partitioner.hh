@@ -2,6 +2,8 @@
 #define DUNE_STUFF_COMMON_PARALLEL_PARTITIONER_HH
 
 #include <cstddef>
+#include <algorithm>
+#include <vector>
 
 namespace Dune {
 namespace Stuff {
@@ -33,6 +35,136 @@ private:
   const IndexSetType& index_set_;
 };
 
+
+/** \brief Partitioner that colors its partitions for race-free parallel intersection assembly
+ *
+ * The codim-0 entities of the grid view are grouped into (at most) num_partitions partitions of consecutive entities
+ * in iteration order. The partitions are then greedily colored, such that two partitions of the same color neither
+ * share a vertex nor touch a common neighboring entity. Thus all partitions of one color may be walked concurrently,
+ * even if a codim-1 functor writes to the data of both the inside and the outside entity of an intersection or a
+ * codim-0 functor writes to data attached to the vertices of its entity.
+ *
+ * usable with \ref Dune::SeedListPartitioning as well as with Walker::walk_colored()
+ **/
+template <class GridViewType>
+class ColoredPartitioner {
+public:
+  typedef typename GridViewType::IndexSet IndexSetType;
+  typedef typename GridViewType::template Codim<0>::Entity EntityType;
+  typedef typename EntityType::EntitySeed EntitySeedType;
+
+  ColoredPartitioner(const GridViewType& grid_view, const std::size_t num_partitions)
+    : index_set_(grid_view.indexSet())
+    , partition_of_entity_(index_set_.size(0), 0)
+  {
+    const std::size_t num_entities = index_set_.size(0);
+    const std::size_t partitions = std::max(std::size_t(1), std::min(num_partitions, num_entities));
+    seeds_.resize(partitions);
+    std::size_t count = 0;
+    for (auto it = grid_view.template begin<0>(); it != grid_view.template end<0>(); ++it, ++count) {
+      const std::size_t pp = (count * partitions) / std::max(std::size_t(1), num_entities);
+      partition_of_entity_[index_set_.index(*it)] = pp;
+      seeds_[pp].emplace_back(it->seed());
+    }
+    // partitions touching an entity (by containing it or one of its face neighbors) must not share a color
+    std::vector<std::vector<std::size_t>> conflicts(partitions);
+    std::vector<std::size_t> touching;
+    for (auto it = grid_view.template begin<0>(); it != grid_view.template end<0>(); ++it) {
+      const auto& entity = *it;
+      touching.assign(1, partition(entity));
+      const auto i_it_end = grid_view.iend(entity);
+      for (auto i_it = grid_view.ibegin(entity); i_it != i_it_end; ++i_it) {
+        if (i_it->neighbor()) {
+          const auto neighbor_ptr = i_it->outside();
+          touching.push_back(partition(*neighbor_ptr));
+        }
+      }
+      for (const auto& pp : touching)
+        for (const auto& qq : touching)
+          if (pp != qq)
+            conflicts[pp].push_back(qq);
+    }
+    // partitions containing entities with a common vertex must not share a color
+    static const int dimension = GridViewType::dimension;
+    std::vector<std::vector<std::size_t>> partitions_of_vertex(index_set_.size(dimension));
+    for (auto it = grid_view.template begin<0>(); it != grid_view.template end<0>(); ++it) {
+      const std::size_t pp = partition(*it);
+      const int corners = it->geometry().corners();
+      for (int ii = 0; ii < corners; ++ii) {
+        auto& partitions_of_corner = partitions_of_vertex[index_set_.subIndex(*it, ii, dimension)];
+        if (std::find(partitions_of_corner.begin(), partitions_of_corner.end(), pp) == partitions_of_corner.end())
+          partitions_of_corner.push_back(pp);
+      }
+    }
+    for (const auto& vertex_partitions : partitions_of_vertex)
+      for (const auto& pp : vertex_partitions)
+        for (const auto& qq : vertex_partitions)
+          if (pp != qq)
+            conflicts[pp].push_back(qq);
+    // greedy coloring in partition order, deterministic
+    color_of_partition_.assign(partitions, 0);
+    std::vector<std::size_t> used_colors;
+    for (std::size_t pp = 0; pp < partitions; ++pp) {
+      auto& neighbors = conflicts[pp];
+      std::sort(neighbors.begin(), neighbors.end());
+      neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+      used_colors.clear();
+      for (const auto& qq : neighbors)
+        if (qq < pp)
+          used_colors.push_back(color_of_partition_[qq]);
+      std::sort(used_colors.begin(), used_colors.end());
+      std::size_t color = 0;
+      for (const auto& used : used_colors)
+        if (used == color)
+          ++color;
+        else if (used > color)
+          break;
+      color_of_partition_[pp] = color;
+      if (color >= partitions_of_color_.size())
+        partitions_of_color_.resize(color + 1);
+      partitions_of_color_[color].push_back(pp);
+    }
+  } // ColoredPartitioner(...)
+
+  std::size_t partition(const EntityType &e) const
+  {
+    return partition_of_entity_[index_set_.index(e)];
+  }
+
+  std::size_t partitions() const
+  {
+    return seeds_.size();
+  }
+
+  std::size_t color(const std::size_t partition) const
+  {
+    return color_of_partition_[partition];
+  }
+
+  std::size_t colors() const
+  {
+    return partitions_of_color_.size();
+  }
+
+  const std::vector<std::size_t>& partitions_of_color(const std::size_t color) const
+  {
+    return partitions_of_color_[color];
+  }
+
+  //! seeds of all entities in the given partition, in iteration order
+  const std::vector<EntitySeedType>& seeds(const std::size_t partition) const
+  {
+    return seeds_[partition];
+  }
+
+private:
+  const IndexSetType& index_set_;
+  std::vector<std::size_t> partition_of_entity_;
+  std::vector<std::vector<EntitySeedType>> seeds_;
+  std::vector<std::size_t> color_of_partition_;
+  std::vector<std::vector<std::size_t>> partitions_of_color_;
+};
+
 }
 }
 
@@ -10,6 +10,7 @@
 #include "threadmanager.hh"
 
 #include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/memory.hh>
 #include <dune/common/exceptions.hh>
 
 #include <dune/stuff/fem.hh>
@@ -43,6 +44,8 @@ size_t Dune::Stuff::ThreadManager::thread()
 {
   const auto tbb_id = std::this_thread::get_id();
   static std::map<decltype(tbb_id), size_t> thread_ids;
+  static std::mutex thread_ids_mutex;
+  std::lock_guard<std::mutex> lock(thread_ids_mutex);
   const auto it = thread_ids.find(tbb_id);
   if (it==thread_ids.end())
     thread_ids.emplace(tbb_id, thread_ids.size());
@@ -75,29 +78,43 @@ Dune::Stuff::ThreadManager::ThreadManager()
 
 #else // if HAVE_TBB
 
+// w/o TBB all threading goes through our own WorkStealingPool
+
 size_t Dune::Stuff::ThreadManager::max_threads()
 {
-    return 1;
+  return max_threads_;
 }
 
 size_t Dune::Stuff::ThreadManager::current_threads()
 {
-    return 1;
+  return max_threads_;
 }
 
 size_t Dune::Stuff::ThreadManager::thread()
 {
-    return 1;
+  return WorkStealingPool::current_worker();
 }
 
 void Dune::Stuff::ThreadManager::set_max_threads(const size_t count)
 {
-  if (count > 1)
-    DUNE_THROW(InvalidStateException, "Trying to use more than one thread w/o TBB");
+  if (count < 1)
+    DUNE_THROW(InvalidStateException, "Trying to use less than one thread");
+  max_threads_ = count;
+  WITH_DUNE_FEM(Dune::Fem::ThreadManager::setMaxNumberThreads(boost::numeric_cast< int >(count));)
 }
 
 Dune::Stuff::ThreadManager::ThreadManager()
- : max_threads_(1)
+ : max_threads_(DSC_CONFIG_GET("threading.max_count", 1u))
 {}
 
-#endif // HAVE_DUNE_FEM
+#endif // HAVE_TBB
+
+std::shared_ptr< Dune::Stuff::WorkStealingPool > Dune::Stuff::ThreadManager::pool()
+{
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  const size_t threads = current_threads();
+  // callers still using the previous pool keep it alive
+  if (!pool_ || pool_->size() != threads)
+    pool_ = std::make_shared<WorkStealingPool>(threads);
+  return pool_;
+}
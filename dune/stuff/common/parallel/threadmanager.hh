@@ -6,7 +6,12 @@
 #ifndef DUNE_STUFF_COMMON_THREADMANAGER_HH
 #define DUNE_STUFF_COMMON_THREADMANAGER_HH
 
+#include <memory>
+#include <mutex>
 #include <thread>
+
+#include <dune/stuff/common/parallel/threadpool.hh>
+
 #if HAVE_TBB
 # include <tbb/task_scheduler_init.h>
 #endif
@@ -35,6 +40,11 @@ struct ThreadManager
   //! set maximal number of threads available during run
   void set_max_threads( const size_t count );
 
+  /** work-stealing pool with current_threads() workers, (re)created on demand
+   *  A pool handed out before a set_max_threads() stays valid as long as the caller holds on to it.
+   **/
+  std::shared_ptr< WorkStealingPool > pool();
+
   ~ThreadManager() = default;
 private:
   friend ThreadManager& threadManager();
@@ -42,6 +52,8 @@ private:
   ThreadManager();
 
   size_t max_threads_;
+  std::shared_ptr< WorkStealingPool > pool_;
+  std::mutex pool_mutex_;
 #if HAVE_TBB
   std::unique_ptr<tbb::task_scheduler_init> tbb_init_;
 #endif
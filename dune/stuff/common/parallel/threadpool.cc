@@ -0,0 +1,164 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include "threadpool.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace {
+
+
+thread_local size_t current_worker_index = 0;
+thread_local const WorkStealingPool* current_worker_pool = nullptr;
+
+
+} // namespace
+
+
+WorkStealingPool::WorkStealingPool(const size_t num_threads)
+  : generation_(0)
+  , shutdown_(false)
+  , pending_(0)
+{
+  const size_t workers = std::max(size_t(1), num_threads);
+  for (size_t ii = 0; ii < workers; ++ii)
+    queues_.emplace_back(new WorkQueue());
+  // worker 0 is the thread calling run()
+  for (size_t ii = 1; ii < workers; ++ii)
+    threads_.emplace_back(&WorkStealingPool::worker_main, this, ii);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard< std::mutex > lock(state_mutex_);
+    shutdown_ = true;
+  }
+  wake_up_.notify_all();
+  for (auto& thread : threads_)
+    thread.join();
+}
+
+size_t WorkStealingPool::size() const
+{
+  return queues_.size();
+}
+
+size_t WorkStealingPool::current_worker()
+{
+  return current_worker_index;
+}
+
+void WorkStealingPool::run(std::vector< TaskType >&& tasks)
+{
+  if (tasks.empty())
+    return;
+  // nested call from one of our own tasks or nothing to share: do it ourselves
+  if (current_worker_pool == this || size() == 1) {
+    for (auto& task : tasks)
+      task();
+    return;
+  }
+  // pending_ and first_exception_ belong to one run at a time
+  std::lock_guard< std::mutex > run_lock(run_mutex_);
+  const size_t num_tasks = tasks.size();
+  {
+    // has to be set before the first task is visible to a worker still busy with the last run
+    std::lock_guard< std::mutex > lock(state_mutex_);
+    first_exception_ = nullptr;
+    pending_ = num_tasks;
+  }
+  // distribute contiguous blocks of tasks, so that neighbouring tasks are likely to be processed by the same worker
+  for (size_t ii = 0; ii < num_tasks; ++ii) {
+    auto& queue = *queues_[(ii * size()) / num_tasks];
+    std::lock_guard< std::mutex > lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(tasks[ii]));
+  }
+  {
+    std::lock_guard< std::mutex > lock(state_mutex_);
+    ++generation_;
+  }
+  wake_up_.notify_all();
+  const auto previous_pool = current_worker_pool;
+  const auto previous_index = current_worker_index;
+  current_worker_pool = this;
+  current_worker_index = 0;
+  work_until_done(0);
+  current_worker_pool = previous_pool;
+  current_worker_index = previous_index;
+  std::unique_lock< std::mutex > lock(state_mutex_);
+  all_done_.wait(lock, [&]() { return pending_ == 0; });
+  if (first_exception_)
+    std::rethrow_exception(first_exception_);
+} // ... run(...)
+
+bool WorkStealingPool::pop(const size_t worker, TaskType& task)
+{
+  auto& queue = *queues_[worker];
+  std::lock_guard< std::mutex > lock(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+  task = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  return true;
+}
+
+bool WorkStealingPool::steal(const size_t thief, TaskType& task)
+{
+  for (size_t ii = 1; ii < size(); ++ii) {
+    auto& queue = *queues_[(thief + ii) % size()];
+    std::lock_guard< std::mutex > lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+} // ... steal(...)
+
+void WorkStealingPool::work_until_done(const size_t worker)
+{
+  // all tasks of a run are queued before the workers are woken up, so once there is nothing left to pop or steal the
+  // remaining tasks are being processed by other workers and this one may go back to sleep
+  TaskType task;
+  while (pop(worker, task) || steal(worker, task)) {
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard< std::mutex > lock(state_mutex_);
+      if (!first_exception_)
+        first_exception_ = std::current_exception();
+    }
+    task = nullptr;
+    if (--pending_ == 0) {
+      std::lock_guard< std::mutex > lock(state_mutex_);
+      all_done_.notify_all();
+    }
+  }
+} // ... work_until_done(...)
+
+void WorkStealingPool::worker_main(const size_t worker)
+{
+  current_worker_index = worker;
+  current_worker_pool = this;
+  size_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock< std::mutex > lock(state_mutex_);
+      wake_up_.wait(lock, [&]() { return shutdown_ || generation_ != seen_generation; });
+      if (shutdown_)
+        return;
+      seen_generation = generation_;
+    }
+    work_until_done(worker);
+  }
+} // ... worker_main(...)
+
+
+} // namespace Stuff
+} // namespace Dune
@@ -0,0 +1,106 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_COMMON_PARALLEL_THREADPOOL_HH
+#define DUNE_STUFF_COMMON_PARALLEL_THREADPOOL_HH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace Dune {
+namespace Stuff {
+
+
+/** \brief Portable work-stealing thread pool, does not depend on TBB.
+ *
+ *  Each worker owns a queue of tasks. A worker takes tasks from the front of its own queue and, once that is empty,
+ *  steals from the back of the queues of the other workers. The thread calling run() (or parallel_for()) takes part in
+ *  the work as worker 0, so a pool of size 1 does not spawn any threads at all.
+ *
+ *  Calls to run() from within a task of the same pool are executed serially by the calling worker. Calls to run() from
+ *  several other threads at once are serialized, i.e. one run() waits until the previous one is finished. Workers
+ *  without anything left to do (or steal) wait for the next run() instead of spinning.
+ *
+ *  \see ThreadManager::pool()
+ **/
+class WorkStealingPool
+  : public boost::noncopyable
+{
+public:
+  typedef std::function< void() > TaskType;
+
+  explicit WorkStealingPool(const size_t num_threads);
+
+  ~WorkStealingPool();
+
+  //! number of workers, including the calling thread
+  size_t size() const;
+
+  //! index of the calling thread within the pool it is working for, 0 for all other threads
+  static size_t current_worker();
+
+  //! executes all tasks and returns once all of them are finished, rethrows the first exception thrown by a task
+  void run(std::vector< TaskType >&& tasks);
+
+  /**
+   *  \brief Splits [first, last) into (at most) num_chunks contiguous chunks and calls functor(chunk_first, chunk_last)
+   *         for each of them in parallel.
+   */
+  template< class ChunkFunctorType >
+  void parallel_for(const size_t first, const size_t last, const size_t num_chunks, ChunkFunctorType functor)
+  {
+    if (last <= first)
+      return;
+    const size_t count = last - first;
+    const size_t chunks = std::max(size_t(1), std::min(num_chunks, count));
+    std::vector< TaskType > tasks;
+    tasks.reserve(chunks);
+    for (size_t cc = 0; cc < chunks; ++cc) {
+      const size_t chunk_first = first + (cc * count) / chunks;
+      const size_t chunk_last = first + ((cc + 1) * count) / chunks;
+      tasks.emplace_back([=, &functor]() { functor(chunk_first, chunk_last); });
+    }
+    run(std::move(tasks));
+  } // ... parallel_for(...)
+
+private:
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque< TaskType > tasks;
+  };
+
+  bool pop(const size_t worker, TaskType& task);
+  bool steal(const size_t thief, TaskType& task);
+  void work_until_done(const size_t worker);
+  void worker_main(const size_t worker);
+
+  std::vector< std::unique_ptr< WorkQueue > > queues_;
+  std::vector< std::thread > threads_;
+  std::mutex run_mutex_;
+  std::mutex state_mutex_;
+  std::condition_variable wake_up_;
+  std::condition_variable all_done_;
+  size_t generation_;
+  bool shutdown_;
+  std::atomic< size_t > pending_;
+  std::exception_ptr first_exception_;
+}; // class WorkStealingPool
+
+
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_COMMON_PARALLEL_THREADPOOL_HH
@@ -8,6 +8,9 @@
 
 #include <deque>
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <type_traits>
 #if HAVE_TBB
 # include <tbb/enumerable_thread_specific.h>
@@ -23,6 +26,8 @@ namespace Stuff {
 
 
 /** Automatic Storage of non-static, N thread-local values
+ *  The values are sized for threadManager().max_threads() at construction. Workers of a larger pool, created after a
+ *  later set_max_threads(), get their values (copies of the initial one) on first use.
  **/
 template <class ValueImp>
 class FallbackPerThreadValue : public boost::noncopyable {
@@ -33,11 +38,13 @@ public:
 private:
   typedef FallbackPerThreadValue<ValueImp> ThisType;
   typedef std::deque<std::unique_ptr<ValueType>> ContainerType;
+  typedef std::map<size_t, std::unique_ptr<ValueType>> OverflowType;
 
 public:
   //! Initialization by copy construction of ValueType
   explicit FallbackPerThreadValue( ConstValueType& value )
-    : values_( threadManager().max_threads())
+    : prototype_(Common::make_unique<ValueType>(value))
+    , values_( threadManager().max_threads())
   {
     std::generate(values_.begin(), values_.end(),
                   [=](){return Common::make_unique<ValueType>(value);});
@@ -46,47 +53,48 @@ public:
   //! Initialization by in-place construction ValueType with \param ctor_args
   template < class... InitTypes >
   explicit FallbackPerThreadValue( InitTypes&& ...ctor_args )
-    : values_( threadManager().max_threads() )
+    : prototype_(Common::make_unique<ValueType>(ctor_args...))
+    , values_( threadManager().max_threads() )
   {
-#if __GNUC__
-    // cannot unpack in lambda due to https://gcc.gnu.org/bugzilla/show_bug.cgi?id=47226
-    ValueType v(ctor_args...);
-    std::generate(values_.begin(), values_.end(),
-                  [&](){return Common::make_unique<ValueType>(v);});
-#else
     std::generate(values_.begin(), values_.end(),
-                  [&](){return Common::make_unique<ValueType>(ctor_args...);});
-#endif
+                  [&](){return Common::make_unique<ValueType>(*prototype_);});
   }
 
   ThisType& operator = (ConstValueType&& value) {
+    prototype_ = Common::make_unique<ValueType>(value);
     std::generate(values_.begin(), values_.end(), [=](){return Common::make_unique<ValueType>(value);});
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    for (auto& element : overflow_)
+      element.second = Common::make_unique<ValueType>(value);
     return *this;
   }
 
   operator ValueType() const { return this->operator *(); }
 
   ValueType& operator * () {
-    return *values_[threadManager().thread()];
+    return get(threadManager().thread());
   }
 
   ConstValueType& operator * () const {
-    return *values_[threadManager().thread()];
+    return get(threadManager().thread());
   }
 
   ValueType* operator -> () {
-    return values_[threadManager().thread()].get();
+    return &get(threadManager().thread());
   }
 
   ConstValueType* operator -> () const {
-    return values_[threadManager().thread()].get();
+    return &get(threadManager().thread());
   }
 
   template <class BinaryOperation>
   ValueType accumulate(ValueType init, BinaryOperation op) const {
     typedef const typename ContainerType::value_type ptr;
     auto l = [&](ConstValueType& a, ptr& b){return op(a, *b);};
-    return std::accumulate(values_.begin(), values_.end(), init, l);
+    const auto result = std::accumulate(values_.begin(), values_.end(), init, l);
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    return std::accumulate(overflow_.begin(), overflow_.end(), result,
+                           [&](ConstValueType& a, const typename OverflowType::value_type& b){return op(a, *b.second);});
   }
 
   ValueType sum() const {
@@ -94,7 +102,20 @@ public:
   }
 
 private:
-   ContainerType values_;
+  ValueType& get(const size_t thread) const {
+    if (thread < values_.size())
+      return *values_[thread];
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    auto& value = overflow_[thread];
+    if (!value)
+      value = Common::make_unique<ValueType>(*prototype_);
+    return *value;
+  }
+
+  std::unique_ptr<ValueType> prototype_;
+  ContainerType values_;
+  mutable OverflowType overflow_;
+  mutable std::mutex overflow_mutex_;
 };
 
 #if HAVE_TBB
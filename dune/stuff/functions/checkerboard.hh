@@ -6,9 +6,12 @@
 #ifndef DUNE_STUFF_FUNCTION_CHECKERBOARD_HH
 #define DUNE_STUFF_FUNCTION_CHECKERBOARD_HH
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <cmath>
 #include <memory>
+#include <type_traits>
 
 #include <dune/common/exceptions.hh>
 
@@ -48,6 +51,12 @@ class Checkerboard
       , value_(value)
     {}
 
+    void rebind(const EntityType& ent, const RangeType& value)
+    {
+      this->bind_entity(ent);
+      value_ = value;
+    }
+
     Localfunction(const Localfunction& /*other*/) = delete;
 
     Localfunction& operator=(const Localfunction& /*other*/) = delete;
@@ -63,6 +72,17 @@ class Checkerboard
       ret = value_;
     }
 
+    virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override
+    {
+#ifndef NDEBUG
+      for (const auto& point : xx)
+        assert(this->is_a_valid_point(point));
+#endif
+      if (ret.size() < xx.size())
+        ret.resize(xx.size());
+      std::fill(ret.begin(), ret.begin() + xx.size(), value_);
+    }
+
     virtual void jacobian(const DomainType& UNUSED_UNLESS_DEBUG(xx), JacobianRangeType& ret) const override
     {
       assert(this->is_a_valid_point(xx));
@@ -82,7 +102,7 @@ class Checkerboard
     {
       ret *= RangeFieldType(0);
     }
-    const RangeType value_;
+    RangeType value_;
   }; // class Localfunction
 
 public:
@@ -188,11 +208,86 @@ public:
     return name_;
   }
 
+  /**
+   * \brief Stores the subdomain of each element of grid_view.
+   *
+   *        Afterwards, local_function() and rebind() look up the subdomain of an entity by its index in grid_view
+   *        instead of computing it from its center. All entities passed to them have to belong to grid_view then.
+   *        The stored subdomains are only used as long as the size of the index set of grid_view is the same as
+   *        during precompute(), otherwise (e.g. after a refinement) the subdomains are computed from the centers again.
+   * \attention The stored subdomains are invalid once the grid is modified without changing the number of elements
+   *            (e.g. by load balancing), call precompute() again afterwards.
+   */
+  template< class GridViewType >
+  void precompute(const GridViewType& grid_view)
+  {
+    static_assert(std::is_same< typename GridViewType::template Codim< 0 >::Entity, EntityType >::value,
+                  "GridViewType does not match EntityType!");
+    typedef typename GridViewType::IndexSet IndexSetType;
+    const auto& index_set = grid_view.indexSet();
+    auto precomputed = std::make_shared< PrecomputedSubdomains >();
+    precomputed->index_set = &index_set;
+    precomputed->index = &index_of< IndexSetType >;
+    precomputed->size = &size_of< IndexSetType >;
+    precomputed->subdomains.resize(index_set.size(0));
+    const auto it_end = grid_view.template end< 0 >();
+    for (auto it = grid_view.template begin< 0 >(); it != it_end; ++it) {
+      const auto& entity = *it;
+      precomputed->subdomains[index_set.index(entity)] = find_subdomain(entity);
+    }
+    precomputed_ = precomputed;
+  } // ... precompute(...)
+
   virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& entity) const override
+  {
+    return std::unique_ptr< Localfunction >(new Localfunction(entity, find_value(entity)));
+  }
+
+  virtual bool rebind(LocalfunctionType& local_func, const EntityType& entity) const override
+  {
+    const auto local_function_ptr = dynamic_cast< Localfunction* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(entity, find_value(entity));
+    return true;
+  }
+
+private:
+  //! the subdomains of the elements of a grid view by their index, see precompute()
+  struct PrecomputedSubdomains
+  {
+    const void* index_set;
+    size_t (*index)(const void*, const EntityType&);
+    size_t (*size)(const void*);
+    std::vector< size_t > subdomains;
+  }; // struct PrecomputedSubdomains
+
+  template< class IndexSetType >
+  static size_t index_of(const void* index_set, const EntityType& entity)
+  {
+    return static_cast< const IndexSetType* >(index_set)->index(entity);
+  }
+
+  template< class IndexSetType >
+  static size_t size_of(const void* index_set)
+  {
+    return static_cast< const IndexSetType* >(index_set)->size(0);
+  }
+
+  const RangeType& find_value(const EntityType& entity) const
+  {
+    const PrecomputedSubdomains* precomputed = precomputed_.get();
+    if (precomputed && precomputed->size(precomputed->index_set) == precomputed->subdomains.size())
+      return (*values_)[precomputed->subdomains[precomputed->index(precomputed->index_set, entity)]];
+    return (*values_)[find_subdomain(entity)];
+  }
+
+  size_t find_subdomain(const EntityType& entity) const
   {
     // decide on the subdomain the center of the entity belongs to
     const auto center = entity.geometry().center();
-    std::vector< size_t > whichPartition(dimDomain, 0);
+    static_assert(dimDomain <= 3, "Not implemented for dimDomain > 3!");
+    std::array< size_t, 3 > whichPartition = {{0, 0, 0}};
     const auto& ll = *lowerLeft_;
     const auto& ur = *upperRight_;
     const auto& ne = *numElements_;
@@ -209,16 +304,15 @@ public:
       subdomain = whichPartition[0] + whichPartition[1]*ne[0];
     else
       subdomain = whichPartition[0] + whichPartition[1]*ne[0] + whichPartition[2]*ne[1]*ne[0];
-    // return the component that belongs to the subdomain
-    return std::unique_ptr< Localfunction >(new Localfunction(entity, (*values_)[subdomain]));
-  } // ... local_function(...)
+    return subdomain;
+  } // ... find_subdomain(...)
 
-private:
   std::shared_ptr< const Common::FieldVector< DomainFieldType, dimDomain > > lowerLeft_;
   std::shared_ptr< const Common::FieldVector< DomainFieldType, dimDomain > > upperRight_;
   std::shared_ptr< const Common::FieldVector< size_t, dimDomain > > numElements_;
   std::shared_ptr< const std::vector< RangeType > > values_;
   std::string name_;
+  std::shared_ptr< const PrecomputedSubdomains > precomputed_;
 }; // class Checkerboard
 
 
@@ -8,6 +8,7 @@
 
 #include <type_traits>
 #include <memory>
+#include <vector>
 
 #include <dune/common/typetraits.hh>
 
@@ -98,8 +99,10 @@ public:
   typedef typename LocalfunctionInterface< E, D, d, R, r, rC >::DomainType        DomainType;
   typedef typename LocalfunctionInterface< E, D, d, R, r, rC >::RangeType         RangeType;
   typedef typename LocalfunctionInterface< E, D, d, R, r, rC >::JacobianRangeType JacobianRangeType;
+  typedef typename LeftLocalfunctionType::RangeType                               LeftRangeType;
 
 private:
+  // the operands are local functions or FusedLocalfunction, both provide evaluate() and jacobian()
   template< Combination cc, bool anything = true >
   class Call
   {
@@ -120,23 +123,39 @@ private:
       return std::max(left_order, right_order);
     }
 
-    static void evaluate(const LeftLocalfunctionType& left_local,
-                         const RightLocalfunctionType& right_local,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
                          const DomainType& xx,
-                         RangeType& ret,
-                         RangeType& tmp_ret)
+                         RangeType& ret)
     {
+      RangeType tmp_ret;
       left_local.evaluate(xx, ret);
       right_local.evaluate(xx, tmp_ret);
       ret -= tmp_ret;
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& left_local,
-                         const RightLocalfunctionType& right_local,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
+                         const std::vector< DomainType >& xx,
+                         std::vector< RangeType >& ret,
+                         std::vector< LeftRangeType >& /*left_ret*/,
+                         std::vector< RangeType >& tmp_ret)
+    {
+      left_local.evaluate(xx, ret);
+      right_local.evaluate(xx, tmp_ret);
+      for (size_t ii = 0; ii < xx.size(); ++ii)
+        ret[ii] -= tmp_ret[ii];
+    } // ... evaluate(...)
+
+    template< class LeftLocalType, class RightLocalType >
+    static void jacobian(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
                          const DomainType& xx,
-                         JacobianRangeType& ret,
-                         JacobianRangeType& tmp_ret)
+                         JacobianRangeType& ret)
     {
+      JacobianRangeType tmp_ret;
       left_local.jacobian(xx, ret);
       right_local.jacobian(xx, tmp_ret);
       ret -= tmp_ret;
@@ -157,23 +176,39 @@ private:
       return std::max(left_order, right_order);
     }
 
-    static void evaluate(const LeftLocalfunctionType& left_local,
-                         const RightLocalfunctionType& right_local,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
                          const DomainType& xx,
-                         RangeType& ret,
-                         RangeType& tmp_ret)
+                         RangeType& ret)
     {
+      RangeType tmp_ret;
       left_local.evaluate(xx, ret);
       right_local.evaluate(xx, tmp_ret);
       ret += tmp_ret;
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& left_local,
-                         const RightLocalfunctionType& right_local,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
+                         const std::vector< DomainType >& xx,
+                         std::vector< RangeType >& ret,
+                         std::vector< LeftRangeType >& /*left_ret*/,
+                         std::vector< RangeType >& tmp_ret)
+    {
+      left_local.evaluate(xx, ret);
+      right_local.evaluate(xx, tmp_ret);
+      for (size_t ii = 0; ii < xx.size(); ++ii)
+        ret[ii] += tmp_ret[ii];
+    } // ... evaluate(...)
+
+    template< class LeftLocalType, class RightLocalType >
+    static void jacobian(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
                          const DomainType& xx,
-                         JacobianRangeType& ret,
-                         JacobianRangeType& tmp_ret)
+                         JacobianRangeType& ret)
     {
+      JacobianRangeType tmp_ret;
       left_local.jacobian(xx, ret);
       right_local.jacobian(xx, tmp_ret);
       ret += tmp_ret;
@@ -195,22 +230,37 @@ private:
       return left_order + right_order;
     }
 
-    static void evaluate(const LeftLocalfunctionType& left_local,
-                         const RightLocalfunctionType& right_local,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
                          const DomainType& xx,
-                         RangeType& ret,
-                         RangeType& /*tmp_ret*/)
+                         RangeType& ret)
     {
-      auto left_value = left_local.evaluate(xx);
+      LeftRangeType left_value;
+      left_local.evaluate(xx, left_value);
       right_local.evaluate(xx, ret);
       ret *= left_value;
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& /*left_local*/,
-                         const RightLocalfunctionType& /*right_local*/,
+    template< class LeftLocalType, class RightLocalType >
+    static void evaluate(const LeftLocalType& left_local,
+                         const RightLocalType& right_local,
+                         const std::vector< DomainType >& xx,
+                         std::vector< RangeType >& ret,
+                         std::vector< LeftRangeType >& left_ret,
+                         std::vector< RangeType >& /*tmp_ret*/)
+    {
+      left_local.evaluate(xx, left_ret);
+      right_local.evaluate(xx, ret);
+      for (size_t ii = 0; ii < xx.size(); ++ii)
+        ret[ii] *= left_ret[ii];
+    } // ... evaluate(...)
+
+    template< class LeftLocalType, class RightLocalType >
+    static void jacobian(const LeftLocalType& /*left_local*/,
+                         const RightLocalType& /*right_local*/,
                          const DomainType& /*xx*/,
-                         JacobianRangeType& /*ret*/,
-                         JacobianRangeType& /*tmp_ret*/)
+                         JacobianRangeType& /*ret*/)
     {
       DUNE_THROW(NotImplemented, "If you need this, implement it!");
     }
@@ -227,29 +277,153 @@ public:
     return Call< comb >::order(left_order, right_order);
   }
 
-  static void evaluate(const LeftLocalfunctionType& left_local,
-                       const RightLocalfunctionType& right_local,
+  template< class LeftLocalType, class RightLocalType >
+  static void evaluate(const LeftLocalType& left_local,
+                       const RightLocalType& right_local,
                        const DomainType& xx,
-                       RangeType& ret,
-                       RangeType& tmp_ret)
+                       RangeType& ret)
+  {
+    Call< comb >::evaluate(left_local, right_local, xx, ret);
+  }
+
+  template< class LeftLocalType, class RightLocalType >
+  static void evaluate(const LeftLocalType& left_local,
+                       const RightLocalType& right_local,
+                       const std::vector< DomainType >& xx,
+                       std::vector< RangeType >& ret,
+                       std::vector< LeftRangeType >& left_ret,
+                       std::vector< RangeType >& tmp_ret)
   {
-    Call< comb >::evaluate(left_local, right_local, xx, ret, tmp_ret);
+    Call< comb >::evaluate(left_local, right_local, xx, ret, left_ret, tmp_ret);
   }
 
-  static void jacobian(const LeftLocalfunctionType& left_local,
-                       const RightLocalfunctionType& right_local,
+  template< class LeftLocalType, class RightLocalType >
+  static void jacobian(const LeftLocalType& left_local,
+                       const RightLocalType& right_local,
                        const DomainType& xx,
-                       JacobianRangeType& ret,
-                       JacobianRangeType& tmp_ret)
+                       JacobianRangeType& ret)
   {
-    Call< comb >::jacobian(left_local, right_local, xx, ret, tmp_ret);
+    Call< comb >::jacobian(left_local, right_local, xx, ret);
   }
 }; // class SelectCombined
 
 
+//! Base of Combined, marks functions whose operands are known at compile time.
+class CombinedBase
+{};
+
+
+/**
+ * \brief Local function of one operand of a combined function.
+ *
+ *        If the operand is a function derived from Combined itself, its type and the types of its operands are known
+ *        at compile time. Instead of asking it for its (heap allocated) local function, the local functions of its
+ *        operands are held directly and combined by non virtual calls, recursively. Thus a whole tree like f + g*h is
+ *        evaluated by a single local function, which holds the local functions of the leafs f, g and h by value and
+ *        calls each of them once per evaluation.
+ *
+ * \note Most likely you do not want to use this class directly, but Combined.
+ */
+template< class FunctionType, bool is_combined = std::is_base_of< CombinedBase, FunctionType >::value >
+class FusedLocalfunction
+{
+public:
+  typedef typename FunctionType::EntityType        EntityType;
+  typedef typename FunctionType::LocalfunctionType LocalfunctionType;
+  typedef typename LocalfunctionType::DomainType        DomainType;
+  typedef typename LocalfunctionType::RangeType         RangeType;
+  typedef typename LocalfunctionType::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& entity)
+    : local_function_(function.local_function(entity))
+  {}
+
+  void rebind(const FunctionType& function, const EntityType& entity)
+  {
+    function.reuse_local_function(entity, local_function_);
+  }
+
+  size_t order() const
+  {
+    return local_function_->order();
+  }
+
+  void evaluate(const DomainType& xx, RangeType& ret) const
+  {
+    local_function_->evaluate(xx, ret);
+  }
+
+  void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const
+  {
+    local_function_->evaluate(xx, ret);
+  }
+
+  void jacobian(const DomainType& xx, JacobianRangeType& ret) const
+  {
+    local_function_->jacobian(xx, ret);
+  }
+
+private:
+  std::unique_ptr< LocalfunctionType > local_function_;
+}; // class FusedLocalfunction
+
+
+template< class FunctionType >
+class FusedLocalfunction< FunctionType, true >
+{
+  typedef typename FunctionType::LeftOperandType  LeftType;
+  typedef typename FunctionType::RightOperandType RightType;
+  typedef SelectCombined< LeftType, RightType, FunctionType::combination > Select;
+public:
+  typedef typename FunctionType::EntityType EntityType;
+  typedef typename Select::DomainType        DomainType;
+  typedef typename Select::RangeType         RangeType;
+  typedef typename Select::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& entity)
+    : left_(function.left(), entity)
+    , right_(function.right(), entity)
+  {}
+
+  void rebind(const FunctionType& function, const EntityType& entity)
+  {
+    left_.rebind(function.left(), entity);
+    right_.rebind(function.right(), entity);
+  }
+
+  size_t order() const
+  {
+    return Select::order(left_.order(), right_.order());
+  }
+
+  void evaluate(const DomainType& xx, RangeType& ret) const
+  {
+    Select::evaluate(left_, right_, xx, ret);
+  }
+
+  void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const
+  {
+    std::vector< typename Select::LeftRangeType > left_values;
+    std::vector< RangeType > values;
+    Select::evaluate(left_, right_, xx, ret, left_values, values);
+  }
+
+  void jacobian(const DomainType& xx, JacobianRangeType& ret) const
+  {
+    Select::jacobian(left_, right_, xx, ret);
+  }
+
+private:
+  FusedLocalfunction< LeftType > left_;
+  FusedLocalfunction< RightType > right_;
+}; // class FusedLocalfunction< ..., true >
+
+
 /**
  * \brief Generic combined local function.
  *
+ *        Operands which are combined functions themselves are fused into this local function, see FusedLocalfunction.
+ *
  * \note Most likely you do not want to use this class directly, but Combined.
  */
 template< class LeftType, class RightType, Combination type >
@@ -277,32 +451,48 @@ public:
 
   CombinedLocalFunction(const LeftType& left, const RightType& right, const EntityType& ent)
     : BaseType(ent)
-    , left_local_(left.local_function(this->entity()))
-    , right_local_(right.local_function(this->entity()))
-    , tmp_range_(0.0)
-    , tmp_jacobian_(0.0)
+    , left_local_(left, this->entity())
+    , right_local_(right, this->entity())
   {}
 
+  void rebind(const LeftType& left, const RightType& right, const EntityType& ent)
+  {
+    this->bind_entity(ent);
+    left_local_.rebind(left, this->entity());
+    right_local_.rebind(right, this->entity());
+  }
+
   virtual size_t order() const override final
   {
-    return Select::order(left_local_->order(), right_local_->order());
+    return Select::order(left_local_.order(), right_local_.order());
   }
 
   virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
   {
-    Select::evaluate(*left_local_, *right_local_, xx, ret, tmp_range_);
+    Select::evaluate(left_local_, right_local_, xx, ret);
+  }
+
+  /**
+   * \brief Evaluates both operands at all points in one call each.
+   * \note  The temporaries are local to each call (not members), since the same local function may be evaluated from
+   *        several threads and operands given through the interface may again be a CombinedLocalFunction of this
+   *        very type.
+   */
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override final
+  {
+    std::vector< typename Select::LeftRangeType > left_values;
+    std::vector< RangeType > values;
+    Select::evaluate(left_local_, right_local_, xx, ret, left_values, values);
   }
 
   virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
   {
-    Select::jacobian(*left_local_, *right_local_, xx, ret, tmp_jacobian_);
+    Select::jacobian(left_local_, right_local_, xx, ret);
   }
 
 private:
-  const std::unique_ptr< const typename LeftType::LocalfunctionType > left_local_;
-  const std::unique_ptr< const typename RightType::LocalfunctionType > right_local_;
-  mutable RangeType tmp_range_;
-  mutable JacobianRangeType tmp_jacobian_;
+  FusedLocalfunction< LeftType > left_local_;
+  FusedLocalfunction< RightType > right_local_;
 }; // class CombinedLocalFunction
 
 
@@ -347,6 +537,9 @@ Difference< ConstantType, ConstantType > stupid_difference()
   return Difference< ConstantType, ConstantType >(one, two)
 }
 \endcode
+ *
+ *        If an operand is itself a Difference, Sum or Product of known operand types (as returned by make_sum and
+ *        friends), its local function is fused into the one of this function, see FusedLocalfunction.
  *
  * \note  Most likely you do not want to use this class diretly, but one of Difference, Sum or Product.
  */
@@ -358,6 +551,7 @@ class Combined
                                          typename SelectCombined< LeftType, RightType, comb >::R,
                                          SelectCombined< LeftType, RightType, comb >::r,
                                          SelectCombined< LeftType, RightType, comb >::rC >
+  , public CombinedBase
 {
   typedef LocalizableFunctionInterface
       < typename SelectCombined< LeftType, RightType, comb >::E,
@@ -374,6 +568,10 @@ public:
   typedef typename BaseType::EntityType        EntityType;
   typedef typename BaseType::LocalfunctionType LocalfunctionType;
 
+  typedef LeftType              LeftOperandType;
+  typedef RightType             RightOperandType;
+  static const Combination combination = comb;
+
   Combined(const LeftType& left, const RightType& right, const std::string nm = "")
     : left_(Common::make_unique< LeftStorageType >(left))
     , right_(Common::make_unique< RightStorageType >(right))
@@ -410,6 +608,17 @@ public:
     return DSC::make_unique< RealLocalFunctionType >(left_->storage_access(), right_->storage_access(), entity);
   } // ... local_function(...)
 
+  //! rebinds the local functions of both operands as well
+  virtual bool rebind(LocalfunctionType& local_func, const EntityType& entity) const override final
+  {
+    typedef CombinedLocalFunction< LeftType, RightType, comb > RealLocalFunctionType;
+    const auto local_function_ptr = dynamic_cast< RealLocalFunctionType* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(left_->storage_access(), right_->storage_access(), entity);
+    return true;
+  } // ... rebind(...)
+
   virtual ThisType* copy() const
   {
     DUNE_THROW(NotImplemented, "Are you kidding me?");
@@ -426,6 +635,16 @@ public:
     return name_;
   }
 
+  const LeftType& left() const
+  {
+    return left_->storage_access();
+  }
+
+  const RightType& right() const
+  {
+    return right_->storage_access();
+  }
+
 private:
   std::unique_ptr< const LeftStorageType > left_;
   std::unique_ptr< const RightStorageType > right_;
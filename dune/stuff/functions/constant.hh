@@ -8,7 +8,9 @@
 #ifndef DUNE_STUFF_FUNCTIONS_CONSTANT_HH
 #define DUNE_STUFF_FUNCTIONS_CONSTANT_HH
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <dune/stuff/common/configuration.hh>
 
@@ -176,6 +178,13 @@ public:
     ret = constant_;
   }
 
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override final
+  {
+    if (ret.size() < xx.size())
+      ret.resize(xx.size());
+    std::fill(ret.begin(), ret.begin() + xx.size(), constant_);
+  }
+
   virtual void jacobian(const DomainType& /*x*/, JacobianRangeType& ret) const override final
   {
     jacobian_helper(ret, internal::ChooseVariant< rangeDimCols >());
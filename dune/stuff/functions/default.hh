@@ -92,13 +92,14 @@ public:
   {
     assert(comp >= 0);
     assert(comp < boost::numeric_cast< int >(dimRange));
-    const auto local_func = function_.local_function(en);
-    local_func->evaluate(xx, tmp_value_);
+    function_.reuse_local_function(en, local_func_);
+    local_func_->evaluate(xx, tmp_value_);
     return Call< dimRange, dimRangeCols >::evaluate(comp, tmp_value_);
   }
 
 private:
   const FunctionType& function_;
+  mutable std::unique_ptr< typename FunctionType::LocalfunctionType > local_func_;
   mutable typename FunctionType::RangeType tmp_value_;
   const std::string name_;
 }; // class VisualizationAdapter
@@ -166,6 +166,12 @@ public:
     , func_local_(func.local_function(this->entity()))
   {}
 
+  void rebind(const FunctionType& func, const EntityType& ent)
+  {
+    this->bind_entity(ent);
+    func.reuse_local_function(this->entity(), func_local_);
+  }
+
   virtual size_t order() const override final
   {
     return Select::order(func_local_->order());
@@ -182,7 +188,7 @@ public:
   }
 
 private:
-  const std::unique_ptr< const typename FunctionType::LocalfunctionType > func_local_;
+  std::unique_ptr< typename FunctionType::LocalfunctionType > func_local_;
 }; // class DerivedLocalFunction
 
 
@@ -236,6 +242,17 @@ public:
     return DSC::make_unique< RealLocalFunctionType >(func_->storage_access(), entity);
   } // ... local_function(...)
 
+  //! rebinds the local function of the underlying function as well
+  virtual bool rebind(LocalfunctionType& local_func, const EntityType& entity) const override final
+  {
+    typedef DerivedLocalFunction< FunctionType, derivative > RealLocalFunctionType;
+    const auto local_function_ptr = dynamic_cast< RealLocalFunctionType* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(func_->storage_access(), entity);
+    return true;
+  } // ... rebind(...)
+
   virtual ThisType* copy() const
   {
     DUNE_THROW(NotImplemented, "Are you kidding me?");
@@ -8,12 +8,15 @@
 #ifndef DUNE_STUFF_FUNCTIONS_EXPRESSION_HH
 #define DUNE_STUFF_FUNCTIONS_EXPRESSION_HH
 
-#include <vector>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
+#include <dune/common/unused.hh>
 
+#include <dune/stuff/common/color.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/exceptions.hh>
 
@@ -33,9 +36,6 @@ class Expression
   typedef LocalizableFunctionInterface
       < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >               BaseType;
   typedef Expression< EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols > ThisType;
-  typedef MathExpressionBase
-      < DomainFieldImp, domainDim, RangeFieldImp, rangeDim*rangeDimCols > MathExpressionFunctionType;
-  typedef MathExpressionBase < DomainFieldImp, domainDim, RangeFieldImp, domainDim > MathExpressionGradientType;
 
 public:
   using typename BaseType::EntityType;
@@ -136,7 +136,7 @@ public:
     }
     // build function and gradient
     build_function(variable, expressions);
-    build_gradients(variable, gradient_expressions);
+    build_program(variable, gradient_expressions);
   }
 
   /**
@@ -151,16 +151,22 @@ public:
              const std::string nm = static_id(),
              const std::vector< std::vector< std::string > > gradient_expressions
                 = std::vector< std::vector< std::string > >())
-    : function_(new MathExpressionFunctionType(variable, expressions))
+    : variable_(variable)
+    , expressions_(expressions)
     , order_(ord)
     , name_(nm)
   {
     static_assert(dimRangeCols == 1, "This constructor does not make sense for dimRangeCols > 1!");
+    if (expressions_.size() < dimRange)
+      DUNE_THROW(Dune::InvalidStateException,
+                 "\n" << Common::colorStringRed("ERROR:") << " 'expressions' too short (is " << expressions_.size()
+                 << ", should be " << dimRange << ")!");
+    expressions_.resize(dimRange);
     GradientStringVectorType gradient_expressions_vec;
     if (gradient_expressions.size() > 0) {
       gradient_expressions_vec.emplace_back(gradient_expressions);
     }
-    build_gradients(variable, gradient_expressions_vec);
+    build_program(variable, gradient_expressions_vec);
   }
 
   /**
@@ -186,7 +192,7 @@ public:
     , name_(nm)
   {
     build_function(variable, expressions);
-    build_gradients(variable, gradient_expressions);
+    build_program(variable, gradient_expressions);
   }
 
   Expression(const ThisType& other) = default;
@@ -194,10 +200,11 @@ public:
   ThisType& operator=(const ThisType& other)
   {
     if (this != &other) {
-      function_ = other.function_;
+      variable_ = other.variable_;
+      expressions_ = other.expressions_;
       order_ = other.order_;
       name_ = other.name_;
-      gradients_ = other.gradients_;
+      program_ = other.program_;
     }
     return *this;
   }
@@ -220,28 +227,54 @@ public:
   virtual void evaluate(const DomainType& xx, RangeType& ret) const override
   {
     evaluate_helper(xx, ret, internal::ChooseVariant< dimRangeCols >());
+    check_value(xx, ret);
+  } // ... evaluate(...)
+
+  //! evaluates several points at a time, see MathExpressionProgram::evaluate_lanes()
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override
+  {
+    if (ret.size() < xx.size())
+      ret.resize(xx.size());
+    program_->evaluate_points(0, xx, [&](const size_t pp, const size_t ii, const double value) {
+      assign(ret[pp], ii, value, internal::ChooseVariant< dimRangeCols >());
+    });
+    for (size_t pp = 0; pp < xx.size(); ++pp)
+      check_value(xx[pp], ret[pp]);
+  } // ... evaluate(...)
+
+  virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override
+  {
+    if (program_->groups() < 2)
+      DUNE_THROW(NotImplemented, "This function does not provide any gradients!");
+    jacobian_helper(xx, ret, internal::ChooseVariant< dimRangeCols >());
+  } // ... jacobian(...)
+
+private:
+  void check_value(const DomainType& DUNE_UNUSED(xx), const RangeType& DUNE_UNUSED(ret)) const
+  {
 #ifndef NDEBUG
 # ifndef DUNE_STUFF_FUNCTIONS_EXPRESSION_DISABLE_CHECKS
     bool failure = false;
     std::string type;
+    FieldVector< RangeFieldType, dimRangeCols > tmp_row;
     for (size_t rr = 0; rr < dimRange; ++rr) {
-      tmp_row_ = ret[rr];
+      tmp_row = ret[rr];
       for (size_t cc = 0; cc < dimRangeCols; ++cc) {
-        if (DSC::isnan(tmp_row_[cc])) {
+        if (DSC::isnan(tmp_row[cc])) {
           failure = true;
           type = "NaN";
-        } else if (DSC::isinf(tmp_row_[cc])) {
+        } else if (DSC::isinf(tmp_row[cc])) {
           failure = true;
           type = "inf";
-        } else if (std::abs(tmp_row_[cc]) > (0.9 * std::numeric_limits< double >::max())) {
+        } else if (std::abs(tmp_row[cc]) > (0.9 * std::numeric_limits< double >::max())) {
           failure = true;
           type = "an unlikely value";
         }
         if (failure)
           DUNE_THROW(Stuff::Exceptions::internal_error,
                      "evaluating this function yielded " << type << "!\n"
-                     << "The variable of this function is:     " << function_->variable() << "\n"
-                     << "The expression of this functional is: " << function_->expression().at(0) << "\n"
+                     << "The variable of this function is:     " << variable_ << "\n"
+                     << "The expression of this functional is: " << expressions_.at(0) << "\n"
                      << "You tried to evaluate it with:   xx = " << xx << "\n"
                      << "The result was:                       " << ret << "\n\n"
                      << "You can disable this check by defining DUNE_STUFF_FUNCTIONS_EXPRESSION_DISABLE_CHECKS\n");
@@ -249,85 +282,106 @@ public:
     }
 # endif // DUNE_STUFF_FUNCTIONS_EXPRESSION_DISABLE_CHECKS
 #endif // NDEBUG
-  } // ... evaluate(...)
+  } // ... check_value(...)
 
-  virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override
-  {
-    if (gradients_.size() == 0) {
-      DUNE_THROW(NotImplemented, "This function does not provide any gradients!");
-    } else {
-      assert(gradients_.size() == dimRangeCols);
-      jacobian_helper(xx, ret, internal::ChooseVariant< dimRangeCols >());
-    }
-  } // ... jacobian(...)
-
-private:
   // fill the rows of the dimRange x dimRangeCols matrix (aka vector< vector< string > > expression) in a vector of
-  // length dimRange*dimRangeCols, e.g. [3 4; 1 2] becomes [3 4 1 2], in order to create function_
+  // length dimRange*dimRangeCols, e.g. [3 4; 1 2] becomes [3 4 1 2], in order to create program_
   void build_function(const std::string variable,
                       const ExpressionStringVectorType& expressions)
   {
     assert(expressions.size() >= dimRange);
-    std::vector< std::string > reordered_expressions;
+    variable_ = variable;
+    expressions_.clear();
     for (size_t rr = 0; rr < dimRange; ++rr) {
       assert(expressions[rr].size() >= dimRangeCols);
       for (size_t cc = 0; cc < dimRangeCols; ++cc) {
-        reordered_expressions.emplace_back(expressions[rr][cc]);
+        expressions_.emplace_back(expressions[rr][cc]);
       }
     }
-    function_ = std::make_shared< MathExpressionFunctionType >(variable, reordered_expressions);
   } // ... build_function(...)
 
-  void build_gradients(const std::string variable,
-                       const GradientStringVectorType& gradient_expressions)
+  // compiles expressions_ and all gradient expressions (flattened as [cc][rr][dd]) into one program,
+  // which evaluates each of them in one pass and shares the common subexpressions
+  void build_program(const std::string variable,
+                     const GradientStringVectorType& gradient_expressions)
   {
     assert(gradient_expressions.size() == 0 || gradient_expressions.size() >= dimRangeCols);
+    auto program = std::make_shared< MathExpressionProgram >(variable, size_t(dimDomain));
+    program->add(expressions_);
     if (gradient_expressions.size() > 0) {
+      std::vector< std::string > flattened_gradient_expressions;
       for (size_t cc = 0; cc < dimRangeCols; ++cc) {
-        gradients_.emplace_back(std::vector< std::shared_ptr< const MathExpressionGradientType > >());
         assert(gradient_expressions[cc].size() >= dimRange);
         for (size_t rr = 0; rr < dimRange; ++rr) {
           const auto& gradient_expression = gradient_expressions[cc][rr];
           assert(gradient_expression.size() >= dimDomain);
-          gradients_[cc].emplace_back(new MathExpressionGradientType(variable, gradient_expression));
+          for (size_t dd = 0; dd < dimDomain; ++dd)
+            flattened_gradient_expressions.emplace_back(gradient_expression[dd]);
         }
       }
+      program->add(flattened_gradient_expressions);
     }
-  } // ... build_gradients(...)
+    program_ = program;
+  } // ... build_program(...)
+
+  //! the registers of the program live on the stack, thus several threads may evaluate the same function
+  void evaluate_program(const size_t group, const DomainType& xx, double* values) const
+  {
+    double arg[dimDomain];
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      arg[dd] = xx[dd];
+    program_->evaluate(group, arg, values);
+  }
 
   template< size_t rC >
   void evaluate_helper(const DomainType& xx, RangeType& ret, internal::ChooseVariant< rC >) const
   {
-    function_->evaluate(xx, tmp_vector_);
+    double values[dimRange*dimRangeCols];
+    evaluate_program(0, xx, values);
     for (size_t rr = 0; rr < dimRange; ++rr) {
       auto& retRow = ret[rr];
       for (size_t cc = 0; cc < dimRangeCols; ++cc)
-        retRow[cc] = tmp_vector_[rr*dimRangeCols + cc];
+        retRow[cc] = values[rr*dimRangeCols + cc];
     }
   } // ... evaluate_helper(...)
 
   void evaluate_helper(const DomainType& xx, RangeType& ret, internal::ChooseVariant< 1 >) const
   {
-    function_->evaluate(xx, ret);
+    double values[dimRange];
+    evaluate_program(0, xx, values);
+    for (size_t rr = 0; rr < dimRange; ++rr)
+      ret[rr] = values[rr];
   } // ... evaluate_helper(..., ...< 1 >)
 
+  template< size_t rC >
+  static void assign(RangeType& ret, const size_t ii, const double value, internal::ChooseVariant< rC >)
+  {
+    ret[ii / dimRangeCols][ii % dimRangeCols] = value;
+  }
+
+  static void assign(RangeType& ret, const size_t ii, const double value, internal::ChooseVariant< 1 >)
+  {
+    ret[ii] = value;
+  }
+
   template< size_t rC >
   void jacobian_helper(const DomainType& xx, JacobianRangeType& ret, internal::ChooseVariant< rC >) const
   {
-    for (size_t cc = 0; cc < dimRangeCols; ++cc) {
-      assert(gradients_[cc].size() == dimRange);
-      for (size_t rr = 0; rr < dimRange; ++rr) {
-        gradients_[cc][rr]->evaluate(xx, ret[cc][rr]);
-      }
-    }
+    double values[dimRangeCols*dimRange*dimDomain];
+    evaluate_program(1, xx, values);
+    for (size_t cc = 0; cc < dimRangeCols; ++cc)
+      for (size_t rr = 0; rr < dimRange; ++rr)
+        for (size_t dd = 0; dd < dimDomain; ++dd)
+          ret[cc][rr][dd] = values[(cc*dimRange + rr)*dimDomain + dd];
   } // ... jacobian_helper(...)
 
   void jacobian_helper(const DomainType& xx, JacobianRangeType& ret, internal::ChooseVariant< 1 >) const
   {
-      assert(gradients_[0].size() == dimRange);
-      for (size_t rr = 0; rr < dimRange; ++rr) {
-        gradients_[0][rr]->evaluate(xx, ret[rr]);
-      }
+    double values[dimRange*dimDomain];
+    evaluate_program(1, xx, values);
+    for (size_t rr = 0; rr < dimRange; ++rr)
+      for (size_t dd = 0; dd < dimDomain; ++dd)
+        ret[rr][dd] = values[rr*dimDomain + dd];
   } // ... jacobian_helper(..., ...< 1 >)
 
   template< size_t rC >
@@ -383,13 +437,12 @@ private:
     }
   } // ... get_gradient(...)
 
-  std::shared_ptr< const MathExpressionFunctionType > function_;
+  std::string variable_;
+  //! the rows of the expression matrix, see build_function()
+  std::vector< std::string > expressions_;
   size_t order_;
   std::string name_;
-  mutable FieldVector< RangeFieldType, dimRange*dimRangeCols > tmp_vector_;
-  mutable FieldVector< RangeFieldType, dimRangeCols > tmp_row_;
-  mutable FieldVector< RangeFieldType, dimDomain > tmp_gradient_row_;
-  std::vector< std::vector< std::shared_ptr< const MathExpressionGradientType > > > gradients_;
+  std::shared_ptr< const MathExpressionProgram > program_;
 }; // class Expression
 
 
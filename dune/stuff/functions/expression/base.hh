@@ -8,6 +8,8 @@
 #ifndef DUNE_STUFF_FUNCTION_EXPRESSION_BASE_HH
 #define DUNE_STUFF_FUNCTION_EXPRESSION_BASE_HH
 
+#include <algorithm>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -18,7 +20,7 @@
 #include <dune/stuff/common/string.hh>
 #include <dune/stuff/common/color.hh>
 
-#include "mathexpr.hh"
+#include "program.hh"
 
 namespace Dune {
 namespace Stuff {
@@ -52,27 +54,9 @@ public:
     setup(_variable, _expressions);
   }
 
-  MathExpressionBase(const ThisType& _other)
-  {
-    setup(_other.variable(), _other.expression());
-  }
+  MathExpressionBase(const ThisType& _other) = default;
 
-  ThisType& operator=(const ThisType& _other)
-  {
-    if (this != &_other) {
-      cleanup();
-      variable_ = "";
-      variables_ = std::vector< std::string >();
-      expressions_ = std::vector< std::string >();
-      setup(_other.variable(), _other.expression());
-    }
-    return this;
-  }
-
-  ~MathExpressionBase()
-  {
-    cleanup();
-  }
+  ThisType& operator=(const ThisType& _other) = default;
 
   std::string variable() const
   {
@@ -87,16 +71,11 @@ public:
   void evaluate(const Dune::FieldVector< DomainFieldType, dimDomain >& arg,
                 Dune::FieldVector< RangeFieldType, dimRange >& ret) const
   {
-    // copy arg
-    for (typename Dune::FieldVector< DomainFieldType, dimDomain >::size_type ii = 0; ii < dimDomain; ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::FieldVector< RangeFieldType, dimRange >::size_type ii = 0; ii < dimRange; ++ii)
-      ret[ii] = op_[ii]->Val();
+    evaluate_code(arg, dimDomain, ret);
   }
 
   /**
-   *  \attention  arg will be used up to its size, ret will be resized!
+   *  \attention  arg will be used up to its size (missing entries are treated as 0), ret will be resized!
    */
   void evaluate(const Dune::DynamicVector< DomainFieldType >& arg,
                 Dune::DynamicVector< RangeFieldType >& ret) const
@@ -105,12 +84,7 @@ public:
     assert(arg.size() > 0);
     if (ret.size() != dimRange)
       ret = Dune::DynamicVector< RangeFieldType >(dimRange);
-    // copy arg
-    for (size_t ii = 0; ii < std::min(domainDim, arg.size()); ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::DynamicVector< RangeFieldType >::size_type ii = 0; ii < dimRange; ++ii)
-      ret[ii] = op_[ii]->Val();
+    evaluate_code(arg, std::min(size_t(dimDomain), arg.size()), ret);
   }
 
   void evaluate(const Dune::FieldVector< DomainFieldType, dimDomain >& arg,
@@ -119,27 +93,30 @@ public:
     // check for sizes
     if (ret.size() != dimRange)
       ret = Dune::DynamicVector< RangeFieldType >(dimRange);
-    // copy arg
-    for (typename Dune::FieldVector< DomainFieldType, dimDomain >::size_type ii = 0; ii < dimDomain; ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (typename Dune::DynamicVector< RangeFieldType >::size_type ii = 0; ii < dimRange; ++ii)
-      ret[ii] = op_[ii]->Val();
+    evaluate_code(arg, dimDomain, ret);
   }
 
   /**
-   *  \attention  arg will be used up to its size
+   *  \attention  arg will be used up to its size (missing entries are treated as 0)
    */
   void evaluate(const Dune::DynamicVector< DomainFieldType >& arg,
                 Dune::FieldVector< RangeFieldType, dimRange >& ret) const
   {
     assert(arg.size() > 0);
-    // copy arg
-    for (size_t ii = 0; ii < std::min(dimDomain, arg.size()); ++ii)
-      *(arg_[ii]) = arg[ii];
-    // copy ret
-    for (size_t ii = 0; ii < dimRange; ++ii)
-      ret[ii] = op_[ii]->Val();
+    evaluate_code(arg, std::min(size_t(dimDomain), arg.size()), ret);
+  }
+
+  /**
+   *  \brief Evaluates at all points, several points at a time (see MathExpressionProgram::evaluate_lanes()).
+   *  \attention ret will be resized!
+   */
+  void evaluate(const std::vector< Dune::FieldVector< DomainFieldType, dimDomain > >& args,
+                std::vector< Dune::FieldVector< RangeFieldType, dimRange > >& rets) const
+  {
+    rets.resize(args.size());
+    program_->evaluate_points(0, args, [&](const size_t pp, const size_t ii, const double value) {
+      rets[pp][ii] = value;
+    });
   }
 
   void report(const std::string _name = "dune.stuff.function.mathexpressionbase",
@@ -160,6 +137,22 @@ public:
   } // void report(const std::string, std::ostream&, const std::string&) const
 
 private:
+  /**
+   *  Evaluates the compiled program with its registers on the stack of the caller, thus several threads may evaluate
+   *  the same expression.
+   */
+  template< class ArgType, class RetType >
+  void evaluate_code(const ArgType& arg, const size_t num_args, RetType& ret) const
+  {
+    double vars[dimDomain];
+    for (size_t ii = 0; ii < dimDomain; ++ii)
+      vars[ii] = (ii < num_args) ? arg[ii] : 0.0;
+    double values[dimRange];
+    program_->evaluate(0, vars, values);
+    for (size_t ii = 0; ii < dimRange; ++ii)
+      ret[ii] = values[ii];
+  } // ... evaluate_code(...)
+
   void setup(const std::string& _variable, const std::vector< std::string >& _expression)
   {
     static_assert((dimDomain > 0), "Really?");
@@ -174,42 +167,15 @@ private:
       expressions_.push_back(_expression[ii]);
     // set variable (i.e. "x")
     variable_ = _variable;
-    // fill variables (i.e. "x[0]", "x[1]", ...)
-    for (size_t ii = 0; ii < dimDomain; ++ii) {
-      std::stringstream variableStream;
-      variableStream << variable_ << "[" << ii << "]";
-      variables_.push_back(variableStream.str());
-    }
-    // create expressions
-    for (size_t ii = 0; ii < dimDomain; ++ii) {
-      arg_[ii] = new DomainFieldType(0.0);
-      var_arg_[ii] = new RVar(variables_[ii].c_str(), arg_[ii]);
-      vararray_[ii] = var_arg_[ii];
-    }
-    for (size_t ii = 0; ii < dimRange; ++ ii) {
-      op_[ii] = new ROperation(expressions_[ii].c_str(), dimDomain, vararray_);
-    }
+    // compile the expressions in the variables x[0], x[1], ...
+    auto program = std::make_shared< MathExpressionProgram >(variable_, size_t(dimDomain));
+    program->add(expressions_);
+    program_ = program;
   } // void setup(const std::string& _variable, const std::vector< std::string >& expressions)
 
-  void cleanup()
-  {
-    for (size_t ii = 0; ii < dimRange; ++ii) {
-      delete op_[ii];
-    }
-    for (size_t ii = 0; ii < dimDomain; ++ii) {
-      delete var_arg_[ii];
-      delete arg_[ii];
-    }
-  } // void cleanup()
-
   std::string                variable_;
-  std::vector< std::string > variables_;
   std::vector< std::string > expressions_;
-  size_t actualDimRange_;
-  mutable DomainFieldType* arg_[dimDomain];
-  RVar* var_arg_[dimDomain];
-  RVar* vararray_[dimDomain];
-  ROperation* op_[dimRange];
+  std::shared_ptr< const MathExpressionProgram > program_;
 }; // class MathExpressionBase
 
 
@@ -17,6 +17,8 @@ If you want to use it in a program you sell, contact me
 
 This software comes with absolutely no warranty.
 
+Changes for dune-stuff: added class RCode and struct RInstr, see mathexpr.hh.
+
 */
 
 #include "mathexpr.hh"
@@ -1255,3 +1257,41 @@ void ROperation::BuildCode()
        ppile,mmb2->ppile,pfuncpile,mmb2->pfuncpile,&FonctionError);
   }
 }
+
+RCode::RCode(const ROperation& rop,int nvar,PRVar*ppvar)
+{
+  double**pv=rop.pvals;PRFunction*prf=rop.pfuncpile;
+  for(pfoncld*pf=rop.pinstr;*pf!=NULL;pf++){
+    instr.push_back(*pf);
+    if(*pf==&NextVal){
+      int index=-1;
+      for(int i=0;i<nvar;i++)if(ppvar[i]->pval==*pv){index=i;break;}
+      varindex.push_back(index);consts.push_back(index<0?**pv:0.);
+      pv++;
+    }else if(*pf==&RFunc){
+      funcs.push_back(*prf);prf++;
+    }
+  }
+}
+
+std::vector<RInstr> RCode::Instructions() const
+{
+  static const struct{pfoncld f;ROperator op;int nargs;} table[]={
+    {&Addition,Add,2},{&Soustraction,Sub,2},{&Multiplication,Mult,2},{&Division,Div,2},{&Puissance,Pow,2},
+    {&RacineN,NthRoot,2},{&Puiss10,E10,2},{&ArcTangente2,Atan,2},{&JuxtF,Juxt,0},{&Absolu,Abs,1},{&Oppose,Opp,1},
+    {&ArcSinus,Asin,1},{&ArcCosinus,Acos,1},{&ArcTangente,Atan,1},{&Logarithme,Ln,1},{&Exponentielle,Exp,1},
+    {&Sinus,Sin,1},{&Tangente,Tg,1},{&Cosinus,Cos,1},{&Racine,Sqrt,1},{&FonctionError,ErrOp,1}};
+  std::vector<RInstr> result;
+  std::vector<int>::const_iterator vi=varindex.begin();std::vector<double>::const_iterator vc=consts.begin();
+  std::vector<PRFunction>::const_iterator fi=funcs.begin();
+  for(std::vector<pfoncld>::const_iterator pf=instr.begin();pf!=instr.end();++pf){
+    RInstr ri={ErrOp,0,-1,0.};
+    if(*pf==&NextVal){ri.op=Num;ri.var=*vi;ri.value=*vc;++vi;++vc;}
+    else if(*pf==&RFunc){ri.op=Fun;ri.nargs=(*fi)->nvars;++fi;}
+    else
+      for(size_t i=0;i<sizeof(table)/sizeof(table[0]);i++)
+        if(table[i].f==*pf){ri.op=table[i].op;ri.nargs=table[i].nargs;break;}
+    result.push_back(ri);
+  }
+  return result;
+}
@@ -17,6 +17,10 @@ If you want to use it in a program you sell, contact me
 
 This software comes with absolutely no warranty.
 
+Changes for dune-stuff: added class RCode, an immutable copy of the code of an
+ROperation, and struct RInstr, which describes the instructions of an RCode for
+other compilers.
+
 */
 
 #ifndef DUNE_STUFF_FUNCTION_NONPARAMETRIC_EXPRESSION_MATHEXPRESSION_HH
@@ -28,6 +32,8 @@ This software comes with absolutely no warranty.
 #include<math.h>
 #include<float.h>
 
+#include<vector>
+
 // Compatibility with long double-typed functions
 #define atanl atan
 #define asinl asin
@@ -81,6 +87,7 @@ class RFunction;
 typedef RFunction* PRFunction;
 
 class ROperation{
+  friend class RCode;
   pfoncld*pinstr;double**pvals;double*ppile;RFunction**pfuncpile;
   mutable signed char containfuncflag;
   void BuildCode();
@@ -150,6 +157,24 @@ public:
   ROperation operator()(const ROperation&);
 };
 
+// Copy of the code of an ROperation, the variables are referred to by their position in the ppvar given to the
+// constructor. The ROperation may be destroyed afterwards.
+// One instruction of an RCode: op==Num pushes value or, if var>=0, the value of the variable var onto the pile, op==Juxt
+// does nothing, op==Fun applies an RFunction, all other operators replace the nargs topmost values of the pile by their
+// result (op==Atan with nargs==2 is atan2, op==ErrOp sets the topmost value to ErrVal).
+struct RInstr{ROperator op;int nargs;int var;double value;};
+
+class RCode{
+public:
+  RCode(const ROperation& rop,int nvar,PRVar*ppvar);
+  std::vector<RInstr> Instructions() const;
+private:
+  std::vector<pfoncld> instr;
+  std::vector<int> varindex; // for each value pushed: index of the variable, -1 for a constant
+  std::vector<double> consts;
+  std::vector<PRFunction> funcs;
+};
+
 char* MidStr(const char*s,int i1,int i2);
 char* CopyStr(const char*s);
 char* InsStr(const char*s,int n,char c);
@@ -0,0 +1,384 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include "program.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include "mathexpr.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+namespace {
+
+
+static const size_t npos = std::numeric_limits< size_t >::max();
+
+// the semantics of the operations of mathexpr.cc, including the bounds below which a value is treated as zero and above
+// which it is treated as an error
+static const double error_value = ErrVal;
+static const double sqrt_max = std::sqrt(DBL_MAX);
+static const double sqrt_min = std::sqrt(DBL_MIN);
+static const double inv_eps = .1 / DBL_EPSILON;
+
+inline bool invalid(const double x)
+{
+  return x == error_value || std::abs(x) > sqrt_max;
+}
+
+inline double apply(const MathExpressionProgram::Operation operation, const double a, const double b)
+{
+  typedef MathExpressionProgram::Operation Op;
+  switch (operation) {
+    case Op::add:
+      return (invalid(b) || invalid(a)) ? error_value : a + b;
+    case Op::subtract:
+      return (invalid(b) || invalid(a)) ? error_value : a - b;
+    case Op::multiply:
+      // unlike ROperation::Val(), a (nearly) vanishing factor wins over an invalid one in both orders, so that the
+      // product is commutative and a * b may share the register of b * a
+      if (std::abs(b) < sqrt_min || std::abs(a) < sqrt_min)
+        return 0;
+      return (invalid(b) || invalid(a)) ? error_value : a * b;
+    case Op::divide:
+      if (std::abs(b) < sqrt_min || invalid(b))
+        return error_value;
+      if (std::abs(a) < sqrt_min)
+        return 0 / b;
+      return invalid(a) ? error_value : a / b;
+    case Op::power:
+      if (!a)
+        return 0;
+      if (b == error_value || a == error_value || std::abs(b * std::log(std::abs(a))) > DBL_MAX_EXP)
+        return error_value;
+      return (a > 0 || !std::fmod(b, 1)) ? std::pow(a, b) : error_value;
+    case Op::nth_root:
+      if (a == error_value || b == error_value || !a || b * std::log(std::abs(a)) < DBL_MIN_EXP)
+        return error_value;
+      if (b >= 0)
+        return std::pow(b, 1 / a);
+      return (std::abs(std::fmod(a, 2)) == 1) ? -std::pow(-b, 1 / a) : error_value;
+    case Op::power_of_ten:
+      if (std::abs(b) < sqrt_min)
+        return 0;
+      if (b == error_value || std::abs(b) > DBL_MAX_10_EXP)
+        return error_value;
+      if (std::abs(a) < sqrt_min)
+        return 0 * std::pow(10, b);
+      return invalid(a) ? error_value : a * std::pow(10, b);
+    case Op::atan2:
+      if (b == error_value || std::abs(b) > inv_eps || a == error_value || std::abs(a) > inv_eps)
+        return error_value;
+      return (a || b) ? std::atan2(a, b) : error_value;
+    case Op::negate:
+      return (a == error_value) ? error_value : -a;
+    case Op::abs:
+      return (a == error_value) ? error_value : std::abs(a);
+    case Op::sqrt:
+      return (a == error_value || a > sqrt_max || a < 0) ? error_value : std::sqrt(a);
+    case Op::sin:
+      return (a == error_value || std::abs(a) > inv_eps) ? error_value : std::sin(a);
+    case Op::cos:
+      return (a == error_value || std::abs(a) > inv_eps) ? error_value : std::cos(a);
+    case Op::tan:
+      return (a == error_value || std::abs(a) > inv_eps) ? error_value : std::tan(a);
+    case Op::log:
+      return (a == error_value || a <= 0) ? error_value : std::log(a);
+    case Op::exp:
+      return (a == error_value || a > DBL_MAX_EXP) ? error_value : std::exp(a);
+    case Op::asin:
+      return (a == error_value || std::abs(a) > 1) ? error_value : std::asin(a);
+    case Op::acos:
+      return (a == error_value || std::abs(a) > 1) ? error_value : std::acos(a);
+    case Op::atan:
+      return (a == error_value) ? error_value : std::atan(a);
+    case Op::error:
+      return error_value;
+  }
+  return error_value;
+} // ... apply(...)
+
+template< MathExpressionProgram::Operation operation >
+inline void apply_lanes(const double* a, const double* b, double* ret)
+{
+  for (size_t ll = 0; ll < MathExpressionProgram::lanes; ++ll)
+    ret[ll] = apply(operation, a[ll], b[ll]);
+}
+
+inline bool unary(const MathExpressionProgram::Operation operation)
+{
+  return operation >= MathExpressionProgram::Operation::negate;
+}
+
+//! \return false, if the instruction does not correspond to an Operation
+bool translate(const RInstr& instruction, MathExpressionProgram::Operation& operation)
+{
+  typedef MathExpressionProgram::Operation Op;
+  switch (instruction.op) {
+    case Add:     operation = Op::add;                                       return true;
+    case Sub:     operation = Op::subtract;                                  return true;
+    case Mult:    operation = Op::multiply;                                  return true;
+    case Div:     operation = Op::divide;                                    return true;
+    case Pow:     operation = Op::power;                                     return true;
+    case NthRoot: operation = Op::nth_root;                                  return true;
+    case E10:     operation = Op::power_of_ten;                              return true;
+    case Atan:    operation = (instruction.nargs == 2) ? Op::atan2 : Op::atan; return true;
+    case Opp:     operation = Op::negate;                                    return true;
+    case Abs:     operation = Op::abs;                                       return true;
+    case Sqrt:    operation = Op::sqrt;                                      return true;
+    case Sin:     operation = Op::sin;                                       return true;
+    case Cos:     operation = Op::cos;                                       return true;
+    case Tg:      operation = Op::tan;                                       return true;
+    case Ln:      operation = Op::log;                                       return true;
+    case Exp:     operation = Op::exp;                                       return true;
+    case Asin:    operation = Op::asin;                                      return true;
+    case Acos:    operation = Op::acos;                                      return true;
+    case ErrOp:   operation = Op::error;                                     return true;
+    default:                                                                 return false;
+  }
+} // ... translate(...)
+
+
+} // namespace
+
+
+const size_t MathExpressionProgram::lanes;
+
+MathExpressionProgram::MathExpressionProgram(const std::string& variable, const size_t dim_domain)
+  : variable_(variable)
+  , dim_domain_(dim_domain)
+  , num_registers_(dim_domain)
+  , instruction_of_register_(dim_domain, npos)
+  , constant_of_register_(dim_domain, npos)
+{}
+
+size_t MathExpressionProgram::add(const std::vector< std::string >& expressions)
+{
+  // the variables for the parser, their values are never read
+  std::vector< double > values(dim_domain_, 0.0);
+  std::vector< std::unique_ptr< RVar > > variables;
+  std::vector< PRVar > variable_pointers;
+  for (size_t ii = 0; ii < dim_domain_; ++ii) {
+    std::stringstream name;
+    name << variable_ << "[" << ii << "]";
+    variables.emplace_back(new RVar(name.str().c_str(), &values[ii]));
+    variable_pointers.push_back(variables.back().get());
+  }
+  // translate the code of each expression by running it on a pile of registers
+  std::vector< size_t > outputs;
+  for (const auto& expression : expressions) {
+    const ROperation operation(expression.c_str(), int(dim_domain_), variable_pointers.data());
+    const RCode code(operation, int(dim_domain_), variable_pointers.data());
+    std::vector< size_t > pile;
+    for (const auto& instruction : code.Instructions()) {
+      Operation op;
+      if (instruction.op == Num)
+        pile.push_back(instruction.var >= 0 ? size_t(instruction.var) : constant(instruction.value));
+      else if (instruction.op == Juxt)
+        continue;
+      else if (translate(instruction, op) && pile.size() >= size_t(instruction.nargs) && instruction.nargs > 0) {
+        const size_t second = pile.back();
+        if (unary(op))
+          pile.back() = node(op, second, second);
+        else {
+          pile.pop_back();
+          pile.back() = node(op, pile.back(), second);
+        }
+      } else
+        DUNE_THROW(Stuff::Exceptions::internal_error,
+                   "Could not compile '" << expression << "' (instruction " << int(instruction.op) << ")!");
+    }
+    outputs.push_back(pile.empty() ? constant(error_value) : pile.back());
+  }
+  // collect the instructions needed for this group, in the order they were created in
+  std::vector< bool > needed(num_registers_, false);
+  std::vector< size_t > to_visit(outputs);
+  while (!to_visit.empty()) {
+    const size_t reg = to_visit.back();
+    to_visit.pop_back();
+    if (needed[reg])
+      continue;
+    needed[reg] = true;
+    const size_t instruction = instruction_of_register_[reg];
+    if (instruction != npos) {
+      to_visit.push_back(instructions_[instruction].first);
+      to_visit.push_back(instructions_[instruction].second);
+    }
+  }
+  std::vector< size_t > group_instructions;
+  for (size_t ii = 0; ii < instructions_.size(); ++ii)
+    if (needed[instructions_[ii].target])
+      group_instructions.push_back(ii);
+  group_instructions_.emplace_back(std::move(group_instructions));
+  group_outputs_.emplace_back(std::move(outputs));
+  return group_outputs_.size() - 1;
+} // ... add(...)
+
+size_t MathExpressionProgram::dim_domain() const
+{
+  return dim_domain_;
+}
+
+size_t MathExpressionProgram::groups() const
+{
+  return group_outputs_.size();
+}
+
+size_t MathExpressionProgram::size(const size_t group) const
+{
+  assert(group < groups());
+  return group_outputs_[group].size();
+}
+
+size_t MathExpressionProgram::num_registers() const
+{
+  return num_registers_;
+}
+
+size_t MathExpressionProgram::num_instructions(const size_t group) const
+{
+  assert(group < groups());
+  return group_instructions_[group].size();
+}
+
+void MathExpressionProgram::evaluate(const size_t group, const double* arg, double* ret) const
+{
+  static const size_t max_stack_registers = 256;
+  if (num_registers_ <= max_stack_registers) {
+    double registers[max_stack_registers];
+    evaluate(group, arg, ret, registers);
+  } else {
+    std::vector< double > registers(num_registers_);
+    evaluate(group, arg, ret, registers.data());
+  }
+} // ... evaluate(...)
+
+void MathExpressionProgram::evaluate(const size_t group, const double* arg, double* ret, double* registers) const
+{
+  assert(group < groups());
+  std::copy(arg, arg + dim_domain_, registers);
+  for (const auto& constant : constants_)
+    registers[constant.first] = constant.second;
+  for (const size_t ii : group_instructions_[group]) {
+    const Instruction& instruction = instructions_[ii];
+    registers[instruction.target] = apply(instruction.operation,
+                                          registers[instruction.first],
+                                          registers[instruction.second]);
+  }
+  const auto& outputs = group_outputs_[group];
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+    ret[ii] = registers[outputs[ii]];
+} // ... evaluate(...)
+
+void MathExpressionProgram::evaluate_lanes(const size_t group, const double* arg, double* ret) const
+{
+  static const size_t max_stack_registers = 256;
+  if (num_registers_ <= max_stack_registers) {
+    double registers[max_stack_registers*lanes];
+    evaluate_lanes(group, arg, ret, registers);
+  } else {
+    std::vector< double > registers(num_registers_*lanes);
+    evaluate_lanes(group, arg, ret, registers.data());
+  }
+} // ... evaluate_lanes(...)
+
+void MathExpressionProgram::evaluate_lanes(const size_t group,
+                                           const double* arg,
+                                           double* ret,
+                                           double* registers) const
+{
+  assert(group < groups());
+  std::copy(arg, arg + dim_domain_*lanes, registers);
+  for (const auto& constant : constants_)
+    std::fill_n(registers + constant.first*lanes, lanes, constant.second);
+  for (const size_t ii : group_instructions_[group]) {
+    const Instruction& instruction = instructions_[ii];
+    const double* a = registers + instruction.first*lanes;
+    const double* b = registers + instruction.second*lanes;
+    double* target = registers + instruction.target*lanes;
+    // dispatch once, the loops over the lanes are free of branches on the operation
+    switch (instruction.operation) {
+      case Operation::add:          apply_lanes< Operation::add >(a, b, target);          break;
+      case Operation::subtract:     apply_lanes< Operation::subtract >(a, b, target);     break;
+      case Operation::multiply:     apply_lanes< Operation::multiply >(a, b, target);     break;
+      case Operation::divide:       apply_lanes< Operation::divide >(a, b, target);       break;
+      case Operation::power:        apply_lanes< Operation::power >(a, b, target);        break;
+      case Operation::nth_root:     apply_lanes< Operation::nth_root >(a, b, target);     break;
+      case Operation::power_of_ten: apply_lanes< Operation::power_of_ten >(a, b, target); break;
+      case Operation::atan2:        apply_lanes< Operation::atan2 >(a, b, target);        break;
+      case Operation::negate:       apply_lanes< Operation::negate >(a, b, target);       break;
+      case Operation::abs:          apply_lanes< Operation::abs >(a, b, target);          break;
+      case Operation::sqrt:         apply_lanes< Operation::sqrt >(a, b, target);         break;
+      case Operation::sin:          apply_lanes< Operation::sin >(a, b, target);          break;
+      case Operation::cos:          apply_lanes< Operation::cos >(a, b, target);          break;
+      case Operation::tan:          apply_lanes< Operation::tan >(a, b, target);          break;
+      case Operation::log:          apply_lanes< Operation::log >(a, b, target);          break;
+      case Operation::exp:          apply_lanes< Operation::exp >(a, b, target);          break;
+      case Operation::asin:         apply_lanes< Operation::asin >(a, b, target);         break;
+      case Operation::acos:         apply_lanes< Operation::acos >(a, b, target);         break;
+      case Operation::atan:         apply_lanes< Operation::atan >(a, b, target);         break;
+      case Operation::error:        apply_lanes< Operation::error >(a, b, target);        break;
+    }
+  }
+  const auto& outputs = group_outputs_[group];
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+    std::copy_n(registers + outputs[ii]*lanes, lanes, ret + ii*lanes);
+} // ... evaluate_lanes(...)
+
+size_t MathExpressionProgram::constant(const double value)
+{
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto search = constant_registers_.find(bits);
+  if (search != constant_registers_.end())
+    return search->second;
+  const size_t reg = num_registers_++;
+  constant_of_register_.push_back(constants_.size());
+  instruction_of_register_.push_back(npos);
+  constants_.emplace_back(reg, value);
+  constant_registers_.emplace(bits, reg);
+  return reg;
+} // ... constant(...)
+
+size_t MathExpressionProgram::node(const Operation operation, size_t first, size_t second)
+{
+  // constant folding
+  const size_t first_constant = constant_of_register_[first];
+  const size_t second_constant = constant_of_register_[second];
+  if (operation == Operation::error)
+    return constant(error_value);
+  if (first_constant != npos && second_constant != npos)
+    return constant(apply(operation, constants_[first_constant].second, constants_[second_constant].second));
+  // common subexpressions, a + b is evaluated exactly as b + a (and a * b as b * a)
+  if ((operation == Operation::add || operation == Operation::multiply) && second < first)
+    std::swap(first, second);
+  const NodeKeyType key(operation, first, second);
+  const auto search = node_registers_.find(key);
+  if (search != node_registers_.end())
+    return search->second;
+  const size_t reg = num_registers_++;
+  instruction_of_register_.push_back(instructions_.size());
+  constant_of_register_.push_back(npos);
+  instructions_.push_back(Instruction{operation, reg, first, second});
+  node_registers_.emplace(key, reg);
+  return reg;
+} // ... node(...)
+
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
@@ -0,0 +1,144 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_EXPRESSION_PROGRAM_HH
+#define DUNE_STUFF_FUNCTIONS_EXPRESSION_PROGRAM_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+
+/**
+ *  \brief Optimized, register based form of several expressions in the same variables.
+ *
+ *  The expressions are parsed by mathexpr.hh and translated into a graph of operations, in which operations on
+ *  constants are folded and each subexpression occurs only once, also across the expressions of different groups. Each
+ *  operation writes to its own register, evaluate() then runs the operations needed by one group in a single switch
+ *  based loop. The results are the same as those of ROperation::Val(), including the treatment of ErrVal, except for
+ *  the product of an invalid and a (nearly) vanishing factor: it is always 0 here, independent of the order.
+ *
+ *  evaluate() is reentrant, the registers live on the stack of the caller. evaluate_lanes() evaluates several points
+ *  at once, with each register holding one value per lane, such that each operation is dispatched once per block of
+ *  points and its loop over the lanes may be vectorized by the compiler.
+ */
+class MathExpressionProgram
+{
+public:
+  enum class Operation : unsigned char
+  {
+    add, subtract, multiply, divide, power, nth_root, power_of_ten, atan2,
+    negate, abs, sqrt, sin, cos, tan, log, exp, asin, acos, atan, error
+  };
+
+  //! number of points evaluated at once by evaluate_lanes()
+  static const size_t lanes = 8;
+
+  struct Instruction
+  {
+    Operation operation;
+    size_t target;
+    size_t first;
+    size_t second;
+  };
+
+  //! the variables are named variable[0], ..., variable[dim_domain - 1]
+  MathExpressionProgram(const std::string& variable, const size_t dim_domain);
+
+  /**
+   *  \brief Parses and compiles expressions, reusing all subexpressions of previously added groups.
+   *  \return the index of the new group, its values are returned by evaluate() in the order of expressions
+   */
+  size_t add(const std::vector< std::string >& expressions);
+
+  size_t dim_domain() const;
+
+  size_t groups() const;
+
+  //! number of values of a group
+  size_t size(const size_t group) const;
+
+  size_t num_registers() const;
+
+  //! number of operations carried out by evaluate() for a group
+  size_t num_instructions(const size_t group) const;
+
+  void evaluate(const size_t group, const double* arg, double* ret) const;
+
+  //! \attention registers has to hold num_registers() values
+  void evaluate(const size_t group, const double* arg, double* ret, double* registers) const;
+
+  /**
+   *  \brief Evaluates a group at lanes points, given as struct of arrays.
+   *
+   *  The dd-th coordinate of the ll-th point is arg[dd*lanes + ll], the ii-th value at this point is written to
+   *  ret[ii*lanes + ll].
+   */
+  void evaluate_lanes(const size_t group, const double* arg, double* ret) const;
+
+  //! \attention registers has to hold num_registers()*lanes values
+  void evaluate_lanes(const size_t group, const double* arg, double* ret, double* registers) const;
+
+  /**
+   *  \brief Evaluates a group at all points, lanes points at a time.
+   *
+   *  Calls store(pp, ii, value) for the ii-th value at the pp-th point, points[pp][dd] has to give the dd-th coordinate.
+   */
+  template< class PointType, class StoreType >
+  void evaluate_points(const size_t group, const std::vector< PointType >& points, StoreType store) const
+  {
+    const size_t num_values = size(group);
+    std::vector< double > buffer((dim_domain_ + num_values + num_registers_)*lanes);
+    double* arg = buffer.data();
+    double* ret = arg + dim_domain_*lanes;
+    double* registers = ret + num_values*lanes;
+    for (size_t first = 0; first < points.size(); first += lanes) {
+      // the last block is filled up with its last point
+      const size_t block = std::min(lanes, points.size() - first);
+      for (size_t ll = 0; ll < lanes; ++ll) {
+        const auto& point = points[first + std::min(ll, block - 1)];
+        for (size_t dd = 0; dd < dim_domain_; ++dd)
+          arg[dd*lanes + ll] = point[dd];
+      }
+      evaluate_lanes(group, arg, ret, registers);
+      for (size_t ll = 0; ll < block; ++ll)
+        for (size_t ii = 0; ii < num_values; ++ii)
+          store(first + ll, ii, ret[ii*lanes + ll]);
+    }
+  } // ... evaluate_points(...)
+
+private:
+  typedef std::tuple< Operation, size_t, size_t > NodeKeyType;
+
+  size_t constant(const double value);
+  size_t node(const Operation operation, const size_t first, const size_t second);
+
+  const std::string variable_;
+  const size_t dim_domain_;
+  // the first dim_domain_ registers hold the arguments
+  size_t num_registers_;
+  std::vector< std::pair< size_t, double > > constants_;
+  std::vector< Instruction > instructions_;
+  std::vector< size_t > instruction_of_register_;
+  std::vector< size_t > constant_of_register_;
+  std::map< std::uint64_t, size_t > constant_registers_;
+  std::map< NodeKeyType, size_t > node_registers_;
+  std::vector< std::vector< size_t > > group_instructions_;
+  std::vector< std::vector< size_t > > group_outputs_;
+}; // class MathExpressionProgram
+
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_EXPRESSION_PROGRAM_HH
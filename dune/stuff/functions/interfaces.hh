@@ -165,14 +165,14 @@ public:
       < dimDomain, RangeFieldType, dimRange, dimRangeCols >::type                    JacobianRangeType;
 
   LocalfunctionSetInterface(const EntityType& ent)
-    : entity_(ent)
+    : entity_(&ent)
   {}
 
   virtual ~LocalfunctionSetInterface() {}
 
   virtual const EntityType& entity() const
   {
-    return entity_;
+    return *entity_;
   }
 
   /**
@@ -224,7 +224,13 @@ protected:
 #endif
   }
 
-  const EntityType& entity_;
+  //! for implementations which support LocalizableFunctionInterface::rebind()
+  void bind_entity(const EntityType& ent)
+  {
+    entity_ = &ent;
+  }
+
+  const EntityType* entity_;
 }; // class LocalfunctionSetInterface
 
 
@@ -283,6 +289,23 @@ public:
   }
   /* @} */
 
+  /**
+   * \defgroup overridable ´´These methods are provided by the interface and may be overridden for efficiency.''
+   * @{
+   **/
+  /**
+   * \brief Evaluates at all points in one call, e.g. all quadrature points of the entity.
+   * \note  ret is resized if it holds less than xx.size() values.
+   */
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const
+  {
+    if (ret.size() < xx.size())
+      ret.resize(xx.size());
+    for (size_t ii = 0; ii < xx.size(); ++ii)
+      evaluate(xx[ii], ret[ii]);
+  }
+  /* @} */
+
   /**
    * \defgroup provided ´´These methods are provided by the interface.''
    * @{
@@ -301,13 +324,19 @@ public:
     return ret;
   }
 
-  //! evaluate at N quadrature points into vector of size >= N
-  void evaluate(const Dune::QuadratureRule< DomainFieldType, dimDomain >& quadrature, std::vector< RangeType >& ret)
+  /**
+   * \brief evaluate at N quadrature points into vector of size >= N
+   * \note  The points are gathered and evaluated at once, see evaluate(const std::vector< DomainType >&, ...).
+   */
+  void evaluate(const Dune::QuadratureRule< DomainFieldType, dimDomain >& quadrature,
+                std::vector< RangeType >& ret) const
   {
     assert(ret.size() >= quadrature.size());
-    std::size_t i = 0;
+    std::vector< DomainType > points(quadrature.size());
+    size_t ii = 0;
     for (const auto& point : quadrature)
-      evaluate(point.position(), ret[i++]);
+      points[ii++] = point.position();
+    evaluate(points, ret);
   }
 
   //! jacobian at N quadrature points into vector of size >= N
@@ -373,6 +402,35 @@ public:
   virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& /*entity*/) const = 0;
   /* @} */
 
+  /**
+   * \brief Binds local_func, which was obtained from any function of this type, to entity.
+   * \return false, if local_func cannot be reused (the default)
+   * \note   Implementations have to leave local_func in the same state as local_function(entity) would.
+   */
+  virtual bool rebind(LocalfunctionType& /*local_func*/, const EntityType& /*entity*/) const
+  {
+    return false;
+  }
+
+  /**
+   * \brief Provides a local function for entity in local_func, reusing the object it holds if possible.
+   *
+   *        Visiting all entities like this only allocates once, if the function supports rebind():
+\code
+std::unique_ptr< LocalfunctionType > local_func;
+for (const auto& entity : DSC::entityRange(grid_view)) {
+  function.reuse_local_function(entity, local_func);
+  ...
+}
+\endcode
+   *        In threaded walks, keep one local_func per thread, e.g. in a DS::PerThreadValue.
+   */
+  void reuse_local_function(const EntityType& entity, std::unique_ptr< LocalfunctionType >& local_func) const
+  {
+    if (!local_func || !rebind(*local_func, entity))
+      local_func = local_function(entity);
+  }
+
   /** \defgroup info ´´These methods should be implemented in order to identify the function.'' */
   /* @{ */
   virtual std::string type() const
@@ -494,6 +552,18 @@ public:
     return ret;
   }
 
+  /**
+   * \brief Evaluates at all points in one call, used by the local functions to evaluate all their points at once.
+   * \note  ret is resized if it holds less than xx.size() values.
+   */
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const
+  {
+    if (ret.size() < xx.size())
+      ret.resize(xx.size());
+    for (size_t ii = 0; ii < xx.size(); ++ii)
+      evaluate(xx[ii], ret[ii]);
+  }
+
   virtual JacobianRangeType jacobian(const DomainType& xx) const
   {
     JacobianRangeType ret;
@@ -506,6 +576,15 @@ public:
     return Common::make_unique< Localfunction >(entity, *this);
   }
 
+  virtual bool rebind(LocalfunctionType& local_func, const EntityImp& entity) const override final
+  {
+    const auto local_function_ptr = dynamic_cast< Localfunction* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(entity, *this);
+    return true;
+  }
+
   virtual std::string type() const override
   {
     return "stuff.globalfunction";
@@ -524,31 +603,47 @@ private:
     Localfunction(const EntityImp& entity_in, const ThisType& global_function)
       : LocalfunctionType(entity_in)
       , geometry_(entity_in.geometry())
-      , global_function_(global_function)
+      , global_function_(&global_function)
     {}
 
+    void rebind(const EntityImp& entity_in, const ThisType& global_function)
+    {
+      this->bind_entity(entity_in);
+      geometry_ = entity_in.geometry();
+      global_function_ = &global_function;
+    }
+
     virtual ~Localfunction() {}
 
     virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
-      global_function_.evaluate(xx_global, ret);
+      global_function_->evaluate(xx_global, ret);
+    }
+
+    //! maps all points at once and evaluates the global function at all of them in one call
+    virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override final
+    {
+      std::vector< DomainType > xx_global(xx.size());
+      for (size_t ii = 0; ii < xx.size(); ++ii)
+        xx_global[ii] = geometry_.global(xx[ii]);
+      global_function_->evaluate(xx_global, ret);
     }
 
     virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
-      global_function_.jacobian(xx_global, ret);
+      global_function_->jacobian(xx_global, ret);
     }
 
     virtual size_t order() const override final
     {
-      return global_function_.order();
+      return global_function_->order();
     }
 
   private:
-      const typename EntityImp::Geometry geometry_;
-      const ThisType& global_function_;
+      typename EntityImp::Geometry geometry_;
+      const ThisType* global_function_;
   }; //class Localfunction
 
 public:
@@ -620,6 +715,18 @@ public:
     return ret;
   }
 
+  /**
+   * \brief Evaluates at all points in one call, used by the local functions to evaluate all their points at once.
+   * \note  ret is resized if it holds less than xx.size() values.
+   */
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const
+  {
+    if (ret.size() < xx.size())
+      ret.resize(xx.size());
+    for (size_t ii = 0; ii < xx.size(); ++ii)
+      evaluate(xx[ii], ret[ii]);
+  }
+
   virtual JacobianRangeType jacobian(const DomainType& xx) const
   {
     JacobianRangeType ret;
@@ -632,6 +739,15 @@ public:
     return Common::make_unique< Localfunction >(entity, *this);
   }
 
+  virtual bool rebind(LocalfunctionType& local_func, const EntityImp& entity) const override final
+  {
+    const auto local_function_ptr = dynamic_cast< Localfunction* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(entity, *this);
+    return true;
+  }
+
   virtual std::string type() const override
   {
     return "stuff.globalfunction";
@@ -650,29 +766,45 @@ private:
     Localfunction(const EntityImp& entity_in, const ThisType& global_function)
       : LocalfunctionType(entity_in)
       , geometry_(entity_in.geometry())
-      , global_function_(global_function)
+      , global_function_(&global_function)
     {}
 
+    void rebind(const EntityImp& entity_in, const ThisType& global_function)
+    {
+      this->bind_entity(entity_in);
+      geometry_ = entity_in.geometry();
+      global_function_ = &global_function;
+    }
+
     virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
-      global_function_.evaluate(xx_global, ret);
+      global_function_->evaluate(xx_global, ret);
+    }
+
+    //! maps all points at once and evaluates the global function at all of them in one call
+    virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override final
+    {
+      std::vector< DomainType > xx_global(xx.size());
+      for (size_t ii = 0; ii < xx.size(); ++ii)
+        xx_global[ii] = geometry_.global(xx[ii]);
+      global_function_->evaluate(xx_global, ret);
     }
 
     virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
-      global_function_.jacobian(xx_global, ret);
+      global_function_->jacobian(xx_global, ret);
     }
 
     virtual size_t order() const override final
     {
-      return global_function_.order();
+      return global_function_->order();
     }
 
   private:
-      const typename EntityImp::Geometry geometry_;
-      const ThisType& global_function_;
+      typename EntityImp::Geometry geometry_;
+      const ThisType* global_function_;
   }; //class Localfunction
 
 public:
@@ -712,6 +844,12 @@ public:
     function_.evaluate(x, ret);
   }
 
+  virtual void evaluate(const std::vector< typename BaseType::DomainType >& x,
+                        std::vector< typename BaseType::RangeType >& ret) const
+  {
+    function_.evaluate(x, ret);
+  }
+
 private:
   const GlobalFunctionImp& function_;
 }; // class TransferredGlobalFunction
@@ -6,6 +6,8 @@
 #ifndef DUNE_STUFF_FUNCTION_RandomEllipsoidsFunction_HH
 #define DUNE_STUFF_FUNCTION_RandomEllipsoidsFunction_HH
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <cmath>
 #include <memory>
@@ -42,6 +44,13 @@ struct Ellipsoid {
   bool intersects_cube(DomainType ll, DomainType ur) const {
     DUNE_THROW(NotImplemented, "");
   }
+  //! the axis aligned box [center - radii, center + radii]
+  DomainType lower_left() const {
+    return center - radii;
+  }
+  DomainType upper_right() const {
+    return center + radii;
+  }
 };
 
 template< class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim, size_t rangeDimCols = 1 >
@@ -74,15 +83,25 @@ public:
     typedef typename BaseType::RangeType         RangeType;
     typedef typename BaseType::JacobianRangeType JacobianRangeType;
 
-    Localfunction(const EntityType& ent, const RangeType value, std::vector<EllipsoidType>&& local_ellipsoids)
+    //! holds only those ellipsoids of function which may contain points of ent
+    Localfunction(const EntityType& ent, const RangeType value, const RandomEllipsoidsFunction& function)
       : BaseType(ent)
       , geometry_(ent.geometry())
       , value_(value)
-      , local_ellipsoids_(local_ellipsoids)
     {
+      function.find_ellipsoids(ent, local_ellipsoids_);
 //      DSC_LOG_DEBUG_0 << "create local LF Ellips with " << local_ellipsoids_.size() << " instances\n";
     }
 
+    //! reuses the memory of the local ellipsoids
+    void rebind(const EntityType& ent, const RangeType value, const RandomEllipsoidsFunction& function)
+    {
+      this->bind_entity(ent);
+      geometry_ = ent.geometry();
+      value_ = value;
+      function.find_ellipsoids(ent, local_ellipsoids_);
+    }
+
     Localfunction(const Localfunction& /*other*/) = delete;
 
     Localfunction& operator=(const Localfunction& /*other*/) = delete;
@@ -113,9 +132,9 @@ public:
     }
 
   private:
-    const typename EntityImp::Geometry geometry_;
-    const RangeType value_;
-    const std::vector<EllipsoidType> local_ellipsoids_;
+    typename EntityImp::Geometry geometry_;
+    RangeType value_;
+    std::vector<EllipsoidType> local_ellipsoids_;
   }; // class Localfunction
 
 public:
@@ -158,6 +177,7 @@ public:
     , upperRight_(upperRight)
     , name_(nm)
     , ellipsoid_cfg_(ellipsoid_cfg)
+    , local_value_(ellipsoid_cfg_.get("ellipsoids.local_value", 1.))
   {
     typedef unsigned long UL;
     const UL level_0_count = ellipsoid_cfg.get("ellipsoids.count", 10);
@@ -206,6 +226,7 @@ public:
       recurse_add(0, ellipsoids_[ii]);
     }
     DSC_LOG_DEBUG_0 << "generated " << ellipsoids_.size() << " of " << total_count << "\n";
+    build_index();
     to_file(*DSC::make_ofstream("ellipsoids.txt"));
   }
 
@@ -225,6 +246,11 @@ public:
     return name_;
   }
 
+  const std::vector< EllipsoidType >& ellipsoids() const
+  {
+    return ellipsoids_;
+  }
+
   void to_file(std::ostream& out) const {
     boost::format line("%d|%g;%g|%g;%g\n");
     size_t id = 0;
@@ -237,8 +263,11 @@ public:
   }
 
 private:
-  std::tuple<typename EllipsoidType::DomainType, typename EllipsoidType::DomainType> bounding_box(const EntityType& entity) const{
-    typename EllipsoidType::DomainType ll,ur;
+  typedef typename EllipsoidType::DomainType    CoordinateType;
+  typedef std::array< size_t, dimDomain >       BucketIndexType;
+
+  std::tuple<CoordinateType, CoordinateType> bounding_box(const EntityType& entity) const{
+    CoordinateType ll,ur;
     typedef Dune::Stuff::Common::MinMaxAvg< DomainFieldType >
       MinMaxAvgType;
     std::array< MinMaxAvgType, dimDomain > coord_limits;
@@ -251,41 +280,159 @@ private:
     for(auto ii : DSC::valueRange(dimDomain)) {
       ll[ii] = coord_limits[ii].min();
       ur[ii] = coord_limits[ii].max();
-
-      return std::make_pair(std::move(ll), std::move(ur));
     }
+    return std::make_pair(std::move(ll), std::move(ur));
   }
-public:
-  virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& entity) const override
+
+  /**
+   * \brief Sorts the ellipsoids into a uniform grid of buckets covering all of them.
+   *
+   *        Each ellipsoid is stored in every bucket its bounding box overlaps, the indices of the ellipsoids in bucket
+   *        bb are bucket_entries_[bucket_offsets_[bb]], ..., bucket_entries_[bucket_offsets_[bb + 1] - 1]. The number
+   *        of buckets is about the number of ellipsoids.
+   */
+  void build_index()
   {
-    const auto local_value = DomainFieldType(ellipsoid_cfg_.get("ellipsoids.local_value", 1.));
-    // decide on the subdomain the center of the entity belongs to
-    const auto max_radius = ellipsoid_cfg_.get("ellipsoids.max_radius", 0.04);
-    typename EllipsoidType::DomainType ll,ur;
-    std::tie(ll,ur) = bounding_box(entity);
-    std::for_each(ll.begin(), ll.end(), [&max_radius](DomainFieldType& lc){lc -= 1.1*max_radius;});
-    std::for_each(ur.begin(), ur.end(), [&max_radius](DomainFieldType& uc){uc += 1.1*max_radius;});
-    std::vector<EllipsoidType> local_ellipsoids;
-    for(const auto& ellipsoid : ellipsoids_) {
-      bool inside = true;
-      for (auto ii : DSC::valueRange(dimDomain)) {
-        inside = inside && DSC::FloatCmp::ge(ellipsoid.center[ii], ll[ii]);
-        inside = inside && DSC::FloatCmp::le(ellipsoid.center[ii], ur[ii]);
+    index_lower_left_ = CoordinateType(0);
+    CoordinateType index_upper_right(1);
+    if (!ellipsoids_.empty()) {
+      index_lower_left_ = ellipsoids_[0].lower_left();
+      index_upper_right = ellipsoids_[0].upper_right();
+    }
+    for (const auto& ellipsoid : ellipsoids_) {
+      const auto ll = ellipsoid.lower_left();
+      const auto ur = ellipsoid.upper_right();
+      for (size_t dd = 0; dd < dimDomain; ++dd) {
+        index_lower_left_[dd] = std::min(index_lower_left_[dd], ll[dd]);
+        index_upper_right[dd] = std::max(index_upper_right[dd], ur[dd]);
       }
-      if(inside) {
-        local_ellipsoids.push_back(ellipsoid);
+    }
+    const size_t buckets_per_dim
+        = std::max(size_t(1), size_t(std::pow(DomainFieldType(ellipsoids_.size()), 1.0/DomainFieldType(dimDomain))));
+    size_t num_buckets = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      num_buckets_[dd] = buckets_per_dim;
+      num_buckets *= buckets_per_dim;
+      const auto extent = index_upper_right[dd] - index_lower_left_[dd];
+      bucket_width_[dd] = (extent > 0) ? extent/DomainFieldType(buckets_per_dim) : DomainFieldType(1);
+    }
+    // count, then fill
+    bucket_offsets_.assign(num_buckets + 1, 0);
+    for (const auto& ellipsoid : ellipsoids_)
+      for_each_bucket(ellipsoid.lower_left(), ellipsoid.upper_right(),
+                      [&](const size_t bucket, const BucketIndexType&) { ++bucket_offsets_[bucket + 1]; });
+    for (size_t bb = 0; bb < num_buckets; ++bb)
+      bucket_offsets_[bb + 1] += bucket_offsets_[bb];
+    bucket_entries_.resize(bucket_offsets_[num_buckets]);
+    std::vector< size_t > fill(bucket_offsets_.begin(), bucket_offsets_.end() - 1);
+    for (size_t ii = 0; ii < ellipsoids_.size(); ++ii)
+      for_each_bucket(ellipsoids_[ii].lower_left(), ellipsoids_[ii].upper_right(),
+                      [&](const size_t bucket, const BucketIndexType&) { bucket_entries_[fill[bucket]++] = ii; });
+  } // ... build_index(...)
+
+  size_t bucket_coordinate(const DomainFieldType& xx, const size_t dd) const
+  {
+    const auto pos = std::floor((xx - index_lower_left_[dd])/bucket_width_[dd]);
+    // clamp before the conversion, which is undefined for negative or too large values (and nan)
+    if (!(pos > 0))
+      return 0;
+    if (pos >= DomainFieldType(num_buckets_[dd] - 1))
+      return num_buckets_[dd] - 1;
+    return size_t(pos);
+  }
+
+  BucketIndexType bucket_coordinates(const CoordinateType& xx) const
+  {
+    BucketIndexType ret;
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      ret[dd] = bucket_coordinate(xx[dd], dd);
+    return ret;
+  }
+
+  //! calls functor(bucket, bucket_coordinates) for all buckets overlapping the box [ll, ur]
+  template< class FunctorType >
+  void for_each_bucket(const CoordinateType& ll, const CoordinateType& ur, FunctorType functor) const
+  {
+    const auto lower = bucket_coordinates(ll);
+    const auto upper = bucket_coordinates(ur);
+    auto current = lower;
+    while (true) {
+      size_t bucket = 0;
+      for (size_t dd = dimDomain; dd > 0; --dd)
+        bucket = bucket*num_buckets_[dd - 1] + current[dd - 1];
+      functor(bucket, current);
+      size_t dd = 0;
+      for (; dd < dimDomain; ++dd) {
+        if (current[dd] < upper[dd]) {
+          ++current[dd];
+          break;
+        }
+        current[dd] = lower[dd];
       }
+      if (dd == dimDomain)
+        return;
     }
-    std::vector<EllipsoidType> tmp = ellipsoids_;
-    return std::unique_ptr< Localfunction >(new Localfunction(entity, local_value, std::move(tmp)));
+  } // ... for_each_bucket(...)
+
+  /**
+   * \brief Collects all ellipsoids whose bounding box overlaps the one of entity.
+   *
+   *        An ellipsoid in several of the visited buckets is only taken from the first of them, i.e. the one at the
+   *        lower left corner of the overlap of its buckets and the visited ones.
+   */
+  void find_ellipsoids(const EntityType& entity, std::vector< EllipsoidType >& local_ellipsoids) const
+  {
+    local_ellipsoids.clear();
+    CoordinateType ll,ur;
+    std::tie(ll,ur) = bounding_box(entity);
+    const auto lower = bucket_coordinates(ll);
+    for_each_bucket(ll, ur, [&](const size_t bucket, const BucketIndexType& current) {
+      for (size_t kk = bucket_offsets_[bucket]; kk < bucket_offsets_[bucket + 1]; ++kk) {
+        const auto& ellipsoid = ellipsoids_[bucket_entries_[kk]];
+        const auto ellipsoid_ll = ellipsoid.lower_left();
+        const auto ellipsoid_ur = ellipsoid.upper_right();
+        const auto ellipsoid_lower = bucket_coordinates(ellipsoid_ll);
+        bool first = true;
+        bool overlaps = true;
+        for (size_t dd = 0; dd < dimDomain; ++dd) {
+          first = first && (current[dd] == std::max(lower[dd], ellipsoid_lower[dd]));
+          overlaps = overlaps && DSC::FloatCmp::le(ellipsoid_ll[dd], ur[dd])
+                              && DSC::FloatCmp::ge(ellipsoid_ur[dd], ll[dd]);
+        }
+        if (first && overlaps)
+          local_ellipsoids.push_back(ellipsoid);
+      }
+    });
+  } // ... find_ellipsoids(...)
+
+public:
+  virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& entity) const override
+  {
+    return std::unique_ptr< Localfunction >(new Localfunction(entity, local_value_, *this));
   } // ... local_function(...)
 
+  //! collects the local ellipsoids into the existing memory of local_func
+  virtual bool rebind(LocalfunctionType& local_func, const EntityType& entity) const override
+  {
+    const auto local_function_ptr = dynamic_cast< Localfunction* >(&local_func);
+    if (!local_function_ptr)
+      return false;
+    local_function_ptr->rebind(entity, local_value_, *this);
+    return true;
+  } // ... rebind(...)
+
 private:
   const Common::FieldVector< DomainFieldType, dimDomain > lowerLeft_;
   const Common::FieldVector< DomainFieldType, dimDomain > upperRight_;
   const std::string name_;
   const Stuff::Common::Configuration ellipsoid_cfg_;
+  const DomainFieldType local_value_;
   std::vector<EllipsoidType> ellipsoids_;
+  CoordinateType index_lower_left_;
+  CoordinateType bucket_width_;
+  BucketIndexType num_buckets_;
+  std::vector< size_t > bucket_offsets_;
+  std::vector< size_t > bucket_entries_;
 }; // class RandomEllipsoidsFunction
 
 
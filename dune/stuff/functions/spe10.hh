@@ -14,6 +14,7 @@
 #include <dune/stuff/common/color.hh>
 #include <dune/stuff/common/string.hh>
 #include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/mapped_data.hh>
 #include <dune/stuff/common/type_utils.hh>
 
 #include "checkerboard.hh"
@@ -77,24 +78,23 @@ private:
                  "max (is " << max << ") has to be larger than min (is " << min << ")!");
     const RangeFieldType scale = (max - min) / (internal::model1_max_value - internal::model1_min_value);
     const RangeFieldType shift = min - scale*internal::model1_min_value;
-    // read all the data from the file
-    std::ifstream datafile(filename);
-    if (datafile.is_open()) {
-      static const size_t entriesPerDim = model1_x_elements*model1_y_elements*model1_z_elements;
-      // create storage (there should be exactly 6000 values in the file, but we onyl read the first 2000)
-      std::vector< RangeType > data(entriesPerDim, unit_range);
-      double tmp = 0;
-      size_t counter = 0;
-      while (datafile >> tmp && counter < entriesPerDim)
-        data[counter++] *= (tmp*scale) + shift;
-      datafile.close();
-      if (counter != entriesPerDim)
-        DUNE_THROW(Dune::IOError,
-                   "wrong number of entries in '" << filename << "' (are " << counter << ", should be "
-                   << entriesPerDim << ")!");
-      return data;
-    } else
+    // read all the data from the file (or its binary cache)
+    std::unique_ptr< const Common::MappedDataFile > datafile;
+    try {
+      datafile = Common::make_unique< Common::MappedDataFile >(filename);
+    } catch (Dune::IOError&) {
       DUNE_THROW(Exceptions::spe10_data_file_missing, "could not open '" << filename << "'!");
+    }
+    static const size_t entriesPerDim = model1_x_elements*model1_y_elements*model1_z_elements;
+    // there should be exactly 6000 values in the file, but we only use the first 2000
+    if (datafile->size() < entriesPerDim)
+      DUNE_THROW(Dune::IOError,
+                 "wrong number of entries in '" << filename << "' (are " << datafile->size() << ", should be "
+                 << entriesPerDim << ")!");
+    std::vector< RangeType > data(entriesPerDim, unit_range);
+    for (size_t ii = 0; ii < entriesPerDim; ++ii)
+      data[ii] *= ((*datafile)[ii]*scale) + shift;
+    return data;
   } // ... read_values_from_file(...)
 
 public:
@@ -8,12 +8,15 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 #include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/color.hh>
 #include <dune/stuff/common/string.hh>
 #include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/mapped_data.hh>
 #include <dune/stuff/common/type_utils.hh>
 #include <dune/stuff/functions/global.hh>
 
@@ -25,6 +28,15 @@ namespace Spe10 {
 /**
  * Grid originally had LL (0,0,0) to UR (365.76, 670.56, 51.816) corners
  *
+ * Only the cells in the region of interest [roi_lower_left, roi_upper_right) (given as cell indices, e.g. a range of
+ * layers) are used, points outside of it get the value of the nearest cell inside. The values are read from the
+ * memory mapped binary cache of the data file (see DSC::MappedDataFile):
+ * - lazy: the region is used in place, only those pages of the cache actually accessed are ever read (and shared
+ *   with other processes on the same node),
+ * - otherwise: the values of the region are copied once and the cache is unmapped, the memory used is proportional
+ *   to the size of the region.
+ * The data file holds the values of num_cells cells in each direction (num_elements for the SPE10 data), the cells
+ * divide [0, upper_right].
  */
 template <class EntityImp, class DomainFieldImp, size_t dim_domain, class RangeFieldImp, size_t r, size_t rC>
 class Model2 : public Stuff::GlobalFunctionInterface<EntityImp, DomainFieldImp, dim_domain, RangeFieldImp, r, rC> {
@@ -32,31 +44,38 @@ class Model2 : public Stuff::GlobalFunctionInterface<EntityImp, DomainFieldImp,
   static_assert(dim_domain==rC,"");
   static_assert(dim_domain==3,"");
   typedef Stuff::GlobalFunctionInterface<EntityImp, DomainFieldImp, dim_domain, RangeFieldImp, r, rC> BaseType;
+  typedef DSC::FieldVector<unsigned int,dim_domain> CellIndexType;
 
 public:
   Model2(std::string data_filename = "perm_case2a.dat",
-         DSC::FieldVector<double,dim_domain> upper_right = default_upper_right)
-    : deltas_{{upper_right[0]/num_elements[0], upper_right[1]/num_elements[1], upper_right[2]/num_elements[2]}}
+         DSC::FieldVector<double,dim_domain> upper_right = default_upper_right,
+         CellIndexType roi_lower_left = CellIndexType(0u),
+         CellIndexType roi_upper_right = num_elements,
+         const bool lazy = true,
+         CellIndexType num_cells = num_elements)
+    : deltas_{{upper_right[0]/num_cells[0], upper_right[1]/num_cells[1], upper_right[2]/num_cells[2]}}
+    , roi_lower_left_(roi_lower_left)
+    , roi_upper_right_(roi_upper_right)
+    , num_cells_(num_cells)
     , permeability_(nullptr)
     , permMatrix_(0.0)
     , filename_(data_filename)
   {
-    readPermeability();
+    for (size_t dim = 0; dim < dim_domain; ++dim)
+      if (!(roi_lower_left_[dim] < roi_upper_right_[dim] && roi_upper_right_[dim] <= num_cells_[dim]))
+        DUNE_THROW(Dune::RangeError, "invalid region of interest: " << roi_lower_left_ << " to " << roi_upper_right_);
+    readPermeability(lazy);
   }
 
   static const DSC::FieldVector<double ,dim_domain> default_upper_right;
   // unsigned int mandated by CubeGrid provider
   static const DSC::FieldVector<unsigned int,dim_domain> num_elements;
 
-  virtual ~Model2() {
-    delete permeability_;
-    permeability_ = nullptr;
-  }
-
   //! currently used in gdt assembler
   virtual void evaluate(const typename BaseType::DomainType& x, typename BaseType::RangeType& diffusion) const final override {
 
-    if (!permeability_) {
+    const double* values = data();
+    if (!values) {
       DSC_LOG_ERROR_0 << "The SPE10-permeability data file could not be opened. This file does\n"
                       << "not come with the dune-multiscale repository due to file size. To download it\n"
                       << "execute\n"
@@ -67,14 +86,18 @@ public:
     }
 
     // 3 is the maximum space dimension
-    for (size_t dim = 0; dim < dim_domain; ++dim)
-      permIntervalls_[dim] = std::min(unsigned(std::floor(x[dim] / deltas_[dim])), num_elements[dim] -1);
-
-    const int offset = permIntervalls_[0] + permIntervalls_[1] * num_elements[0]
-                       + permIntervalls_[2] * num_elements[1] * num_elements[0];
+    size_t offset = 0;
     for (size_t dim = 0; dim < dim_domain; ++dim) {
-      const auto idx = offset + dim * 1122000;
-      diffusion[dim][dim] = permeability_[idx];
+      const double cell = std::floor(x[dim] / deltas_[dim]);
+      // clamp before the conversion, which is undefined for values out of range (and nan)
+      const unsigned int index = (cell >= roi_lower_left_[dim])
+                                 ? unsigned(std::min(cell, double(roi_upper_right_[dim] - 1)))
+                                 : roi_lower_left_[dim];
+      offset += (index - storage_lower_left_[dim]) * strides_[dim];
+    }
+    for (size_t dim = 0; dim < dim_domain; ++dim) {
+      const auto idx = offset + dim * strides_[dim_domain];
+      diffusion[dim][dim] = values[idx];
     }
   }
 
@@ -82,26 +105,55 @@ public:
     return 0u;
   }
 private:
-  void readPermeability() {
-    std::ifstream file(filename_);
-    double val;
-    if (!file) { // file couldn't be opened
+  //! the values are memory mapped from a binary cache of the data file, see DSC::MappedDataFile
+  void readPermeability(const bool lazy) {
+    try {
+      permeability_ = std::make_shared<const DSC::MappedDataFile>(filename_);
+    } catch (Dune::IOError&) { // file couldn't be opened
       return;
     }
-    file >> val;
-    int counter = 0;
-    permeability_ = new double[3366000];
-    while (!file.eof()) {
-      // keep reading until end-of-file
-      permeability_[counter++] = val;
-      file >> val; // sets EOF flag if no value found
+    const size_t entriesPerDim = size_t(num_cells_[0])*num_cells_[1]*num_cells_[2];
+    if (permeability_->size() < dim_domain*entriesPerDim)
+      DUNE_THROW(IOError, "wrong number of entries in '" << filename_ << "' (are " << permeability_->size()
+                          << ", should be " << dim_domain*entriesPerDim << ")!");
+    if (lazy) {
+      storage_lower_left_ = CellIndexType(0u);
+      strides_ = {{1, num_cells_[0], num_cells_[0]*num_cells_[1], entriesPerDim}};
+      return;
     }
-    file.close();
+    // copy the region of interest, layer by layer and row by row
+    const size_t sx = roi_upper_right_[0] - roi_lower_left_[0];
+    const size_t sy = roi_upper_right_[1] - roi_lower_left_[1];
+    const size_t sz = roi_upper_right_[2] - roi_lower_left_[2];
+    roi_values_.resize(dim_domain*sx*sy*sz);
+    auto out = roi_values_.begin();
+    for (size_t dim = 0; dim < dim_domain; ++dim)
+      for (size_t zz = roi_lower_left_[2]; zz < roi_upper_right_[2]; ++zz)
+        for (size_t yy = roi_lower_left_[1]; yy < roi_upper_right_[1]; ++yy) {
+          const double* row = permeability_->data() + dim*entriesPerDim + zz*num_cells_[1]*num_cells_[0]
+                              + yy*num_cells_[0];
+          out = std::copy(row + roi_lower_left_[0], row + roi_upper_right_[0], out);
+        }
+    storage_lower_left_ = roi_lower_left_;
+    strides_ = {{1, sx, sx*sy, sx*sy*sz}};
+    permeability_.reset();
+  } // ... readPermeability(...)
+
+  const double* data() const {
+    if (!roi_values_.empty())
+      return roi_values_.data();
+    return permeability_ ? permeability_->data() : nullptr;
   }
 
   std::array<double, dim_domain> deltas_;
-  double* permeability_; //! TODO automatic memory
-  mutable typename BaseType::DomainType permIntervalls_;
+  const CellIndexType roi_lower_left_;
+  const CellIndexType roi_upper_right_;
+  const CellIndexType num_cells_;
+  std::shared_ptr<const DSC::MappedDataFile> permeability_;
+  std::vector<double> roi_values_;
+  // data()[(x - storage_lower_left_[0])*strides_[0] + ... + dim*strides_[3]] is the value in cell (x, y, z)
+  CellIndexType storage_lower_left_;
+  std::array<size_t, dim_domain + 1> strides_;
   mutable Dune::FieldMatrix<double, BaseType::DomainType::dimension, BaseType::DomainType::dimension> permMatrix_;
   const std::string filename_;
 };
@@ -30,6 +30,56 @@ namespace Dune {
 namespace Stuff {
 namespace Grid {
 
+#if HAVE_DUNE_GRID
+
+//! gridwalk functor that does the actual work for \ref Statistics
+template< class GridViewType >
+class StatisticsFunctor
+  : public Functor::Codim1Reducer< GridViewType >
+{
+  typedef Functor::Codim1Reducer< GridViewType > BaseType;
+  typedef StatisticsFunctor< GridViewType >      ThisType;
+public:
+  typedef typename BaseType::EntityType       EntityType;
+  typedef typename BaseType::IntersectionType IntersectionType;
+  typedef typename BaseType::ReducerType      ReducerType;
+
+  StatisticsFunctor()
+    : numberOfIntersections(0), numberOfInnerIntersections(0), numberOfBoundaryIntersections(0), maxGridWidth(0)
+  {}
+
+  virtual void apply_local(const IntersectionType& intersection,
+                           const EntityType& /*inside_entity*/,
+                           const EntityType& /*outside_entity*/) override
+  {
+    ++numberOfIntersections;
+    maxGridWidth = std::max(intersection.geometry().volume(), maxGridWidth);
+    // if we are inside the grid
+    numberOfInnerIntersections += ( intersection.neighbor() && !intersection.boundary() );
+    // if we are on the boundary of the grid
+    numberOfBoundaryIntersections += ( !intersection.neighbor() && intersection.boundary() );
+  }
+
+  virtual std::unique_ptr< ReducerType > split() const override
+  {
+    return std::unique_ptr< ReducerType >(new ThisType());
+  }
+
+  virtual void join(const ReducerType& other_reducer) override
+  {
+    const auto& other = static_cast< const ThisType& >(other_reducer);
+    numberOfIntersections += other.numberOfIntersections;
+    numberOfInnerIntersections += other.numberOfInnerIntersections;
+    numberOfBoundaryIntersections += other.numberOfBoundaryIntersections;
+    maxGridWidth = std::max(other.maxGridWidth, maxGridWidth);
+  }
+
+  size_t numberOfIntersections;
+  size_t numberOfInnerIntersections;
+  size_t numberOfBoundaryIntersections;
+  double maxGridWidth;
+}; // class StatisticsFunctor
+
 struct Statistics {
   size_t numberOfEntities;
   size_t numberOfIntersections;
@@ -37,20 +87,17 @@ struct Statistics {
   size_t numberOfBoundaryIntersections;
   double maxGridWidth;
   template <class GridViewType>
-  Statistics(const GridViewType& gridView)
-    : numberOfEntities(gridView.size(0)), numberOfIntersections(0), numberOfInnerIntersections(0)
-    , numberOfBoundaryIntersections(0), maxGridWidth(0)
+  Statistics(const GridViewType& gridView, const bool use_threads = false)
+    : numberOfEntities(gridView.size(0))
   {
-    for (const auto& entity : DSC::entityRange(gridView)) {
-      for (const auto& intIt : DSC::intersectionRange(gridView, entity)) {
-        ++numberOfIntersections;
-        maxGridWidth = std::max(intIt.geometry().volume(), maxGridWidth);
-        // if we are inside the grid
-        numberOfInnerIntersections += ( intIt.neighbor() && !intIt.boundary() );
-        // if we are on the boundary of the grid
-        numberOfBoundaryIntersections += ( !intIt.neighbor() && intIt.boundary() );
-      }
-    }
+    StatisticsFunctor< GridViewType > functor;
+    Walker< GridViewType > walker(gridView);
+    walker.add(functor);
+    walker.walk(use_threads);
+    numberOfIntersections = functor.numberOfIntersections;
+    numberOfInnerIntersections = functor.numberOfInnerIntersections;
+    numberOfBoundaryIntersections = functor.numberOfBoundaryIntersections;
+    maxGridWidth = functor.maxGridWidth;
   }
 };
 
@@ -66,6 +113,8 @@ void printInfo(const GridViewType& gridView, std::ostream& out) {
   out << "      maxGridWidth is " << st.maxGridWidth << std::endl;
 } // printGridInformation
 
+#endif // HAVE_DUNE_GRID
+
   /**
   * \attention Not optimal, does a whole grid walk!
   **/
@@ -103,18 +152,41 @@ struct Dimensions
   MinMaxAvgType entity_width;
 
   //! gridwalk functor that does the actual work for \ref GridDimensions
-  class GridDimensionsFunctor : public Functor::Codim0<GridViewType>
+  class GridDimensionsFunctor : public Functor::Codim0Reducer<GridViewType>
   {
+    typedef typename Functor::Codim0Reducer<GridViewType>::ReducerType ReducerType;
+
+    // storage for the partial results created by split()
+    CoordLimitsType own_coord_limits_;
+    MinMaxAvgType own_entity_volume_;
+    MinMaxAvgType own_entity_width_;
     CoordLimitsType& coord_limits_;
     MinMaxAvgType& entity_volume_;
     MinMaxAvgType& entity_width_;
 
+    GridDimensionsFunctor()
+      : coord_limits_(own_coord_limits_)
+      , entity_volume_(own_entity_volume_)
+      , entity_width_(own_entity_width_) {}
+
     public:
       GridDimensionsFunctor(CoordLimitsType& c, MinMaxAvgType& e, MinMaxAvgType& w)
         : coord_limits_(c)
         , entity_volume_(e)
         , entity_width_(w) {}
 
+      virtual std::unique_ptr< ReducerType > split() const {
+        return std::unique_ptr< ReducerType >(new GridDimensionsFunctor());
+      }
+
+      virtual void join(const ReducerType& other_reducer) {
+        const auto& other = static_cast< const GridDimensionsFunctor& >(other_reducer);
+        entity_volume_.join(other.entity_volume_);
+        entity_width_.join(other.entity_width_);
+        for (size_t k = 0; k < GridType::dimensionworld; ++k)
+          coord_limits_[k].join(other.coord_limits_[k]);
+      }
+
       virtual void apply_local(const EntityType& ent) {
         const auto& geo = ent.geometry();
         entity_volume_( geo.volume() );
@@ -131,11 +203,11 @@ struct Dimensions
   double volumeRelation() const
   { return entity_volume.min() != 0.0 ? entity_volume.max() / entity_volume.min() : -1; }
 
-  Dimensions(const GridViewType& gridView) {
+  Dimensions(const GridViewType& gridView, const bool use_threads = false) {
     GridDimensionsFunctor f(coord_limits, entity_volume, entity_width);
     Walker< GridViewType > gw(gridView);
     gw.add(f);
-    gw.walk();
+    gw.walk(use_threads);
   }
 
   Dimensions(const EntityType& entity) {
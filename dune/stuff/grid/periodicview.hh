@@ -8,8 +8,15 @@
 #ifndef DUNE_STUFF_GRID_PERIODICVIEW_HH
 #define DUNE_STUFF_GRID_PERIODICVIEW_HH
 
+#include <algorithm>
+#include <array>
 #include <bitset>
-#include <map>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -22,7 +29,6 @@
 #include <dune/stuff/common/memory.hh>
 #include <dune/stuff/common/float_cmp.hh>
 #include <dune/stuff/common/ranges.hh>
-#include <dune/stuff/grid/search.hh>
 
 namespace Dune {
 namespace Stuff {
@@ -35,13 +41,27 @@ namespace Grid {
 namespace internal {
 
 
+//! The outside entity of a periodic intersection and the index of the intersection in it.
+template< class EntitySeedImp >
+struct PeriodicNeighbor
+{
+  PeriodicNeighbor(const EntitySeedImp& seed, const int index)
+    : outside_seed(seed)
+    , index_in_outside(index)
+  {}
+
+  EntitySeedImp outside_seed;
+  int index_in_outside;
+}; // struct PeriodicNeighbor
+
+
 /** \brief Intersection for PeriodicGridView
  *
  * PeriodicIntersection is derived from the Intersection of the underlying GridView. On the inside of the grid or if
- * periodic_ is false, the PeriodicIntersection will behave exactly like its BaseType. If periodic_ is true, the
+ * periodic_neighbor_ is nullptr, the PeriodicIntersection will behave exactly like its BaseType. Otherwise, the
  * PeriodicIntersection will return neighbor == true even if it actually is on the boundary. In this case, outside(),
  * geometryInOutside() and indexInOutside() are well-defined and give the information from the periodically adjacent
- * entity.
+ * entity (the index of the intersection in the outside entity is known from the construction of the PeriodicGridView).
  *
  * \see PeriodicGridView
  */
@@ -54,25 +74,26 @@ class PeriodicIntersection
   typedef typename RealGridViewType::Intersection  BaseType;
 
 public:
-  typedef typename BaseType::LocalGeometry                LocalGeometry;
-  typedef typename BaseType::EntityPointer                EntityPointer;
-  typedef typename RealGridViewType::IntersectionIterator RealIntersectionIteratorType;
+  typedef typename BaseType::LocalGeometry                                    LocalGeometry;
+  typedef typename BaseType::EntityPointer                                    EntityPointer;
+  typedef typename RealGridViewType::IntersectionIterator                     RealIntersectionIteratorType;
+  typedef typename RealGridViewType::template Codim< 0 >::Entity::EntitySeed  EntitySeedType;
+  typedef PeriodicNeighbor< EntitySeedType >                                  PeriodicNeighborType;
   static const size_t dimDomain = RealGridViewType::dimension;
 
-  //! \brief Constructor from real intersection
+  //! \brief Constructor from real intersection, periodic_neighbor is nullptr if the intersection is not periodic
   PeriodicIntersection(const BaseType& real_intersection,
                        const RealGridViewType& real_grid_view,
-                       const std::pair< bool, EntityPointer >& periodic_pair)
+                       const PeriodicNeighborType* periodic_neighbor)
     : BaseType(real_intersection)
-    , periodic_(periodic_pair.first)
-    , outside_(periodic_pair.second)
-    , real_grid_view_(new DSC::ConstStorageProvider< RealGridViewType >(real_grid_view))
+    , periodic_neighbor_(periodic_neighbor)
+    , real_grid_view_(&real_grid_view)
   {}
 
   // methods that differ from BaseType
   bool neighbor() const
   {
-    if (periodic_)
+    if (periodic_neighbor_)
       return true;
     else
       return BaseType::neighbor();
@@ -80,15 +101,15 @@ public:
 
   EntityPointer outside() const
   {
-    if (periodic_)
-      return outside_;
+    if (periodic_neighbor_)
+      return real_grid_view_->grid().entityPointer(periodic_neighbor_->outside_seed);
     else
       return BaseType::outside();
   } // ... outside() const
 
   LocalGeometry geometryInOutside() const
   {
-    if (periodic_) {
+    if (periodic_neighbor_) {
       const RealIntersectionIteratorType outside_intersection_it = find_intersection_in_outside();
       return outside_intersection_it->geometryInInside();
     } else {
@@ -98,52 +119,36 @@ public:
 
   int indexInOutside() const
   {
-    if (periodic_) {
-      const RealIntersectionIteratorType outside_intersection_it = find_intersection_in_outside();
-      return outside_intersection_it->indexInInside();
-    } else {
+    if (periodic_neighbor_)
+      return periodic_neighbor_->index_in_outside;
+    else
       return BaseType::indexInOutside();
-    }
   } // int indexInOutside() const
 
 private:
-  // tries to find intersection in outside (works only if periodic_ == true)
+  // finds the intersection with index indexInOutside() in outside (works only if periodic_neighbor_ is set)
   RealIntersectionIteratorType find_intersection_in_outside() const
   {
-    const auto coords = this->geometry().center();
-    RealIntersectionIteratorType outside_i_it = real_grid_view_->access().ibegin(*outside());
-    const RealIntersectionIteratorType outside_i_it_end = real_grid_view_->access().iend(*outside());
-    // walk over outside intersections and find an intersection on the boundary that differs only in one coordinate
-    for ( ; outside_i_it != outside_i_it_end; ++outside_i_it) {
-      const BaseType& curr_outside_intersection = *outside_i_it;
-      if (curr_outside_intersection.boundary()) {
-        const auto curr_outside_intersection_coords = curr_outside_intersection.geometry().center();
-        size_t coord_difference_count = 0;
-        for (size_t ii = 0; ii < dimDomain; ++ii) {
-          if (Dune::Stuff::Common::FloatCmp::ne(curr_outside_intersection_coords[ii], coords[ii])) {
-            ++coord_difference_count;
-          }
-        }
-        if (coord_difference_count == size_t(1)) {
-          return outside_i_it;
-        }
-      }
-    }
+    const EntityPointer outside_ptr = outside();
+    RealIntersectionIteratorType outside_i_it = real_grid_view_->ibegin(*outside_ptr);
+    const RealIntersectionIteratorType outside_i_it_end = real_grid_view_->iend(*outside_ptr);
+    for ( ; outside_i_it != outside_i_it_end; ++outside_i_it)
+      if (outside_i_it->indexInInside() == periodic_neighbor_->index_in_outside)
+        return outside_i_it;
     DUNE_THROW(Dune::InvalidStateException, "Could not find outside intersection!");
-    return real_grid_view_->access().ibegin(*outside());
+    return real_grid_view_->ibegin(*outside_ptr);
   } // ... find_intersection_in_outside() const
 
 protected:
-  bool periodic_;
-  EntityPointer outside_;
-  std::unique_ptr< DSC::ConstStorageProvider< RealGridViewType > > real_grid_view_;
+  const PeriodicNeighborType* periodic_neighbor_;
+  const RealGridViewType* real_grid_view_;
 }; // ... class PeriodicIntersection ...
 
 /** \brief IntersectionIterator for PeriodicGridView
  *
  * PeriodicIntersectionIterator is derived from the IntersectionIterator of the underlying GridView and behaves exactly
  * like the underlying IntersectionIterator except that it returns a PeriodicIntersection in its operator* and
- * operator-> methods.
+ * operator-> methods. The PeriodicIntersection is constructed in place on each dereference, nothing is allocated.
  *
  * \see PeriodicGridView
  */
@@ -160,62 +165,82 @@ public:
   typedef typename RealIntersectionType::EntityPointer            EntityPointerType;
   typedef PeriodicIntersection< RealGridViewType >                Intersection;
   typedef typename RealGridViewType::template Codim< 0 >::Entity  EntityType;
-  typedef std::pair< bool, EntityPointerType >                    PeriodicPairType;
+  typedef typename Intersection::PeriodicNeighborType             PeriodicNeighborType;
   static const size_t dimDomain = RealGridViewType::dimension;
 
+  /**
+   * \param entity_faces       the entries of the entity in the intersection table of the PeriodicGridView, i.e. the
+   *                           index in periodic_neighbors for each local intersection index (-1 if not periodic), or
+   *                           nullptr if the entity has no periodic intersections
+   * \param periodic_neighbors the periodic neighbors of the PeriodicGridView
+   */
   PeriodicIntersectionIterator(BaseType real_intersection_iterator,
                                const RealGridViewType& real_grid_view,
-                               const EntityType& entity,
-                               const std::map< IntersectionIndexType, PeriodicPairType >& intersection_map)
+                               const int* entity_faces,
+                               const PeriodicNeighborType* periodic_neighbors)
     : BaseType(real_intersection_iterator)
     , real_grid_view_(real_grid_view)
-    , entity_(entity)
-    , has_boundary_intersections_(entity_.hasBoundaryIntersections())
-    , intersection_map_(intersection_map)
-    , nonperiodic_pair_(std::make_pair(bool(false), EntityPointerType(entity_)))
-    , current_intersection_(create_current_intersection_safely())
+    , entity_faces_(entity_faces)
+    , periodic_neighbors_(periodic_neighbors)
+    , has_current_intersection_(false)
+  {}
+
+  PeriodicIntersectionIterator(const PeriodicIntersectionIterator& other)
+    : BaseType(other)
+    , real_grid_view_(other.real_grid_view_)
+    , entity_faces_(other.entity_faces_)
+    , periodic_neighbors_(other.periodic_neighbors_)
+    , has_current_intersection_(false)
   {}
 
+  ~PeriodicIntersectionIterator()
+  {
+    destroy_current_intersection();
+  }
+
   // methods that differ from BaseType
   const Intersection& operator*() const
   {
-    current_intersection_ = create_current_intersection();
-    return *current_intersection_;
+    return create_current_intersection();
   }
 
   const Intersection* operator->() const
   {
-    current_intersection_ = create_current_intersection();
-    return &(*current_intersection_);
+    return &create_current_intersection();
   }
 
 private:
-  std::unique_ptr< Intersection > create_current_intersection() const
+  const Intersection& create_current_intersection() const
   {
-    return DSC::make_unique< Intersection >(BaseType::operator*(),
-                                            real_grid_view_,
-                                            has_boundary_intersections_
-                                            ? intersection_map_.at((BaseType::operator*()).indexInInside())
-                                            : (const PeriodicPairType&)nonperiodic_pair_);
+    const RealIntersectionType& real_intersection = BaseType::operator*();
+    const PeriodicNeighborType* periodic_neighbor = nullptr;
+    if (entity_faces_) {
+      const int neighbor = entity_faces_[real_intersection.indexInInside()];
+      if (neighbor >= 0)
+        periodic_neighbor = periodic_neighbors_ + neighbor;
+    }
+    destroy_current_intersection();
+    Intersection* current_intersection = new (&current_intersection_) Intersection(real_intersection,
+                                                                                    real_grid_view_,
+                                                                                    periodic_neighbor);
+    has_current_intersection_ = true;
+    return *current_intersection;
   } // ... create_current_intersection() const
 
-  std::unique_ptr< Intersection > create_current_intersection_safely() const
+  void destroy_current_intersection() const
   {
-    const bool is_iend = (*this == real_grid_view_.iend(entity_));
-    const RealIntersectionType& real_intersection = is_iend ? *real_grid_view_.ibegin(entity_) : BaseType::operator*();
-    return DSC::make_unique< Intersection >(real_intersection,
-                                            real_grid_view_,
-                                            has_boundary_intersections_
-                                            ? intersection_map_.at(real_intersection.indexInInside())
-                                            : (const PeriodicPairType&)nonperiodic_pair_);
-  } // ... create_current_intersection_safely() const
+    if (has_current_intersection_) {
+      reinterpret_cast< Intersection* >(&current_intersection_)->~Intersection();
+      has_current_intersection_ = false;
+    }
+  }
 
   const RealGridViewType& real_grid_view_;
-  const EntityType& entity_;
-  const bool has_boundary_intersections_;
-  const std::map< IntersectionIndexType, PeriodicPairType >& intersection_map_;
-  PeriodicPairType nonperiodic_pair_;
-  mutable std::unique_ptr< Intersection > current_intersection_;
+  const int* entity_faces_;
+  const PeriodicNeighborType* periodic_neighbors_;
+  mutable typename std::aligned_storage< sizeof(Intersection), std::alignment_of< Intersection >::value >::type
+      current_intersection_;
+  mutable bool has_current_intersection_;
 }; // ... class PeriodicIntersectionIterator ...
 
 
@@ -284,7 +309,8 @@ public:
   typedef typename RealIntersectionType::GlobalCoordinate                           DomainType;
   typedef PeriodicIntersection< BaseType >                                          Intersection;
   typedef typename Grid::template Codim< 0 >::EntityPointer                         EntityPointerType;
-  typedef std::map< IntersectionIndexType, std::pair< bool, EntityPointerType > >   IntersectionMapType;
+  typedef typename Intersection::EntitySeedType                                     EntitySeedType;
+  typedef typename Intersection::PeriodicNeighborType                               PeriodicNeighborType;
   static const size_t dimDomain = BaseType::dimension;
 
   template< int cd >
@@ -293,100 +319,172 @@ public:
   PeriodicGridViewImp(const BaseType& real_grid_view,
                       const std::bitset< dimDomain > periodic_directions)
     : BaseType(real_grid_view)
-    , empty_intersection_map_(IntersectionMapType())
+    , face_offsets_(this->indexSet().size(0) + 1, 0)
     , periodic_directions_(periodic_directions)
   {
-    auto entity_it = BaseType::template begin< 0 >();
-    DomainType lower_left = entity_it->geometry().center();
-    DomainType upper_right = lower_left;
+    // collect the boundary intersections and their bounding box and reserve an entry in the intersection table for
+    // each intersection of an entity with boundary intersections
+    std::vector< BoundaryFace > boundary_faces;
+    DomainType lower_left(std::numeric_limits< CoordinateType >::max());
+    DomainType upper_right(std::numeric_limits< CoordinateType >::lowest());
     for (const auto& entity : DSC::entityRange(*this)) {
+      if (!entity.hasBoundaryIntersections())
+        continue;
+      const EntityIndexType entity_index = this->indexSet().index(entity);
       const auto i_it_end = BaseType::iend(entity);
       for (auto i_it = BaseType::ibegin(entity); i_it != i_it_end; ++i_it) {
         const RealIntersectionType& intersection = *i_it;
-        const auto intersection_coords = intersection.geometry().center();
-        for (std::size_t ii = 0; ii < dimDomain; ++ii) {
-          if (intersection_coords[ii] > upper_right[ii])
-            upper_right[ii] = intersection_coords[ii];
-          if (intersection_coords[ii] < lower_left[ii])
-            lower_left[ii] = intersection_coords[ii];
+        const IntersectionIndexType index_in_inside = intersection.indexInInside();
+        face_offsets_[entity_index + 1] = std::max(face_offsets_[entity_index + 1], size_t(index_in_inside + 1));
+        if (intersection.boundary()) {
+          const DomainType center = intersection.geometry().center();
+          for (size_t ii = 0; ii < dimDomain; ++ii) {
+            lower_left[ii] = std::min(lower_left[ii], center[ii]);
+            upper_right[ii] = std::max(upper_right[ii], center[ii]);
+          }
+          boundary_faces.emplace_back(entity_index, entity.seed(), index_in_inside, center);
+        }
+      }
+    }
+    for (size_t ee = 1; ee < face_offsets_.size(); ++ee)
+      face_offsets_[ee] += face_offsets_[ee - 1];
+    face_neighbors_.assign(face_offsets_.back(), -1);
+
+    // hash the intersections on the lower boundaries by their (quantized) center projected onto the boundary
+    DomainType quantization;
+    for (size_t ii = 0; ii < dimDomain; ++ii) {
+      quantization[ii] = 1e-6*(upper_right[ii] - lower_left[ii]);
+      if (!(quantization[ii] > 0))
+        quantization[ii] = 1;
+    }
+    const auto face_key = [&](const DomainType& center, const size_t dd) -> FaceKeyType {
+      FaceKeyType key;
+      for (size_t ii = 0; ii < dimDomain; ++ii)
+        key[ii] = (ii == dd) ? 0 : (long long)(std::floor((center[ii] - lower_left[ii])/quantization[ii]));
+      return key;
+    };
+    std::array< std::unordered_multimap< FaceKeyType, size_t, FaceKeyHash >, dimDomain > lower_faces;
+    std::vector< std::pair< size_t, size_t > > upper_faces;
+    size_t num_lower_faces = 0;
+    for (size_t ff = 0; ff < boundary_faces.size(); ++ff) {
+      const DomainType& center = boundary_faces[ff].center;
+      for (size_t ii = 0; ii < dimDomain; ++ii) {
+        if (!periodic_directions_[ii])
+          continue;
+        if (Dune::Stuff::Common::FloatCmp::eq(center[ii], lower_left[ii])) {
+          lower_faces[ii].insert(std::make_pair(face_key(center, ii), ff));
+          ++num_lower_faces;
+          break;
+        } else if (Dune::Stuff::Common::FloatCmp::eq(center[ii], upper_right[ii])) {
+          upper_faces.emplace_back(ff, ii);
+          break;
         }
       }
     }
 
-    EntityInlevelSearch< BaseType > entity_search(*this);
-    DomainType periodic_neighbor_coords;
-    std::map< IntersectionIndexType, std::pair< bool, EntityPointerType > > intersection_neighbor_map;
-    for (const auto& entity : DSC::entityRange(*this)) {
-      if (entity.hasBoundaryIntersections()) {
-        intersection_neighbor_map.clear();
-        const auto i_it_end = BaseType::iend(entity);
-        for (auto i_it = BaseType::ibegin(entity); i_it != i_it_end; ++i_it) {
-          const RealIntersectionType& intersection = *i_it;
-          const IntersectionIndexType index_in_inside = intersection.indexInInside();
-          bool is_periodic = false;
-          if (intersection.boundary()) {
-            periodic_neighbor_coords = intersection.geometry().center();
-            size_t num_boundary_coords = 0;
-            for (std::size_t ii = 0; ii < dimDomain; ++ii) {
-              if (periodic_directions_[ii]) {
-                if (Dune::Stuff::Common::FloatCmp::eq(periodic_neighbor_coords[ii], lower_left[ii])) {
-                  is_periodic = true;
-                  periodic_neighbor_coords[ii] = upper_right[ii] - 1.0/100.0*(entity.geometry().center()[ii] - lower_left[ii]);
-                  ++num_boundary_coords;
-                } else if (Dune::Stuff::Common::FloatCmp::eq(periodic_neighbor_coords[ii], upper_right[ii])) {
-                  is_periodic = true;
-                  periodic_neighbor_coords[ii] = lower_left[ii] + 1.0/100.0*(upper_right[ii] - entity.geometry().center()[ii]);
-                  ++num_boundary_coords;
-                }
-              }
-            }
-            assert(num_boundary_coords = 1);
-            if (is_periodic) {
-              const auto outside_ptr_ptrs = entity_search(std::vector< DomainType >(1, periodic_neighbor_coords));
-              const auto& outside_ptr_ptr = outside_ptr_ptrs.at(0);
-              if (outside_ptr_ptr == nullptr)
-                DUNE_THROW(Dune::InvalidStateException, "Could not find periodic neighbor entity");
-              const EntityPointerType& outside_ptr = *outside_ptr_ptr;
-              intersection_neighbor_map.insert(std::make_pair(index_in_inside,
-                                                              std::make_pair(is_periodic, outside_ptr)));
-            } else {
-              intersection_neighbor_map.insert(std::make_pair(index_in_inside,
-                                                              std::make_pair(is_periodic, EntityPointerType(entity))));
-            }
-          } else {
-            intersection_neighbor_map.insert(std::make_pair(index_in_inside,
-                                                            std::make_pair(bool(false), EntityPointerType(entity))));
-          }
+    // match each intersection on an upper boundary with the one on the lower boundary with the same projected center
+    const auto find_lower_face = [&](const DomainType& center, const size_t dd) -> size_t {
+      const FaceKeyType key = face_key(center, dd);
+      // if center is close to the boundary of its quantization cell, the other center may lie in the neighboring cell
+      FaceKeyType offset;
+      for (size_t ii = 0; ii < dimDomain; ++ii) {
+        const auto pos = (center[ii] - lower_left[ii])/quantization[ii];
+        offset[ii] = (ii == dd) ? 0 : ((pos - std::floor(pos) < 0.5) ? -1 : 1);
+      }
+      for (size_t mask = 0; mask < (size_t(1) << dimDomain); ++mask) {
+        if ((mask >> dd) & 1)
+          continue;
+        FaceKeyType probe = key;
+        for (size_t ii = 0; ii < dimDomain; ++ii)
+          if ((mask >> ii) & 1)
+            probe[ii] += offset[ii];
+        const auto range = lower_faces[dd].equal_range(probe);
+        for (auto it = range.first; it != range.second; ++it) {
+          const DomainType& other = boundary_faces[it->second].center;
+          bool same = true;
+          for (size_t ii = 0; ii < dimDomain; ++ii)
+            if (ii != dd && Dune::Stuff::Common::FloatCmp::ne(other[ii], center[ii]))
+              same = false;
+          if (same)
+            return it->second;
         }
-        entity_to_intersection_map_map_.insert(std::make_pair(this->indexSet().index(entity), intersection_neighbor_map));
       }
+      return boundary_faces.size();
+    };
+    for (const auto& upper_face : upper_faces) {
+      const BoundaryFace& face = boundary_faces[upper_face.first];
+      const size_t partner = find_lower_face(face.center, upper_face.second);
+      if (partner == boundary_faces.size())
+        DUNE_THROW(Dune::InvalidStateException, "Could not find periodic neighbor entity");
+      const BoundaryFace& other = boundary_faces[partner];
+      face_neighbors_[face_offsets_[face.entity_index] + face.index_in_inside] = int(periodic_neighbors_.size());
+      periodic_neighbors_.emplace_back(other.entity_seed, other.index_in_inside);
+      face_neighbors_[face_offsets_[other.entity_index] + other.index_in_inside] = int(periodic_neighbors_.size());
+      periodic_neighbors_.emplace_back(face.entity_seed, face.index_in_inside);
     }
+    if (upper_faces.size() != num_lower_faces)
+      DUNE_THROW(Dune::InvalidStateException,
+                 "The periodic boundaries do not match (" << num_lower_faces << " lower and " << upper_faces.size()
+                 << " upper intersections)!");
   } // constructor PeriodicGridViewImp(...)
 
   IntersectionIterator ibegin(const typename Codim< 0 >::Entity& entity) const
   {
-    return IntersectionIterator(BaseType::ibegin(entity),
-                                *this,
-                                entity,
-                                entity.hasBoundaryIntersections()
-                                ? entity_to_intersection_map_map_.at(this->indexSet().index(entity))
-                                : (const IntersectionMapType&)empty_intersection_map_);
-
+    return IntersectionIterator(BaseType::ibegin(entity), *this, entity_faces(entity), periodic_neighbors_.data());
   } // ... ibegin(...)
 
   IntersectionIterator iend(const typename Codim< 0 >::Entity& entity) const
   {
-    return IntersectionIterator(BaseType::iend(entity),
-                                *this,
-                                entity,
-                                entity.hasBoundaryIntersections()
-                                ? entity_to_intersection_map_map_.at(this->indexSet().index(entity))
-                                : (const IntersectionMapType&)empty_intersection_map_);
+    return IntersectionIterator(BaseType::iend(entity), *this, entity_faces(entity), periodic_neighbors_.data());
   } // ... iend(...)
 
 private:
-  std::map< EntityIndexType, IntersectionMapType > entity_to_intersection_map_map_;
-  const IntersectionMapType empty_intersection_map_;
+  //! the entries of entity in the intersection table, nullptr if entity has no boundary intersections
+  const int* entity_faces(const typename Codim< 0 >::Entity& entity) const
+  {
+    if (!entity.hasBoundaryIntersections())
+      return nullptr;
+    return face_neighbors_.data() + face_offsets_[this->indexSet().index(entity)];
+  }
+
+  typedef typename Grid::ctype                        CoordinateType;
+  typedef std::array< long long, dimDomain >          FaceKeyType;
+
+  struct BoundaryFace
+  {
+    BoundaryFace(const EntityIndexType ei,
+                 const EntitySeedType& es,
+                 const IntersectionIndexType index,
+                 const DomainType& c)
+      : entity_index(ei)
+      , entity_seed(es)
+      , index_in_inside(index)
+      , center(c)
+    {}
+
+    EntityIndexType entity_index;
+    EntitySeedType entity_seed;
+    IntersectionIndexType index_in_inside;
+    DomainType center;
+  }; // struct BoundaryFace
+
+  struct FaceKeyHash
+  {
+    size_t operator()(const FaceKeyType& key) const
+    {
+      size_t seed = 0;
+      for (const auto& kk : key)
+        seed ^= std::hash< long long >()(kk) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  }; // struct FaceKeyHash
+
+  // face_neighbors_[face_offsets_[entity index] + local intersection index] is the index of the periodic neighbor in
+  // periodic_neighbors_, or -1 if the intersection is not periodic (only entities with boundary intersections have
+  // entries)
+  std::vector< size_t > face_offsets_;
+  std::vector< int > face_neighbors_;
+  std::vector< PeriodicNeighborType > periodic_neighbors_;
   const std::bitset< dimDomain > periodic_directions_;
 }; // ... class PeriodicGridViewImp ...
 
@@ -402,23 +500,21 @@ private:
  * operator*. The PeriodicIntersection again behaves like an Intersection of the underlying GridView, but may return
  * neighbor() == true and an outside() entity even if it is on the boundary. The outside() entity is the entity
  * adjacent to the intersection if it is identified with the intersection on the other side of the grid.
- * In the constructor, PeriodicGridViewImp will build a map mapping boundary entity indices to a map mapping local
- * intersection indices to a std::pair containing the information whether this intersection shall be periodic and the
- * outside entity. This may take quite long as finding the outside entity requires a grid walk for each periodic
- * intersection.
+ * In the constructor, PeriodicGridViewImp will build a flat table indexed by the entity index and the local
+ * intersection index (only for entities with boundary intersections), holding whether this intersection shall be
+ * periodic and if so the seed of the outside entity and the index of the intersection in the outside entity. To find
+ * the periodic partners, the boundary intersections are hashed by their center projected onto the boundary, so this
+ * takes linear time in the number of boundary intersections.
  * By default, all coordinate directions will be made periodic. By supplying a std::bitset< dimension > you can decide
  * for each direction whether it should be periodic (1 means periodic, 0 means 'behave like underlying GridView in that
  * direction').
 
    \note
-      -  Currently, PeriodicGridView will only work with GridViews on the unit hypercube
-      -  Only cube and regular simplex grids have been tested so far. Other grids may not work properly. This is due to
-      the heuristics for finding the periodic neighbor entity: Given an intersection on the boundary that shall be
-      periodic, the coordinates intersection.geometry().center() are moved to the other side of the grid and then
-      supplied to Dune::Stuff::Grid::EntityInLevelSearch. As the coordinates are on the boundary of the wanted entity,
-      this search will fail for some grids. Thus, the coordinates are moved a little to the inside of the grid before
-      searching for the entity. The moved coordinates will be inside the wanted entity for cube and usual simplex grids
-      but this is not guaranteed for arbitrary grids.
+      -  Currently, PeriodicGridView will only work with GridViews on hyperrectangles
+      -  Two intersections on opposite sides of the grid are identified if their centers only differ in the periodic
+      direction, i.e. the grid has to be periodic itself (which is the case for cube and usual simplex grids).
+      -  The constructor throws a Dune::InvalidStateException if a boundary intersection in a periodic direction has
+      no partner on the opposite side, e.g. if the grid was refined non-conformingly at only one of the two sides.
  */
 template< class RealGridViewImp >
 class PeriodicGridView
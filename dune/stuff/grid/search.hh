@@ -8,6 +8,11 @@
 
 #if HAVE_DUNE_GRID
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include <boost/range/iterator_range.hpp>
@@ -22,6 +27,8 @@
 #include <dune/stuff/aliases.hh>
 #include <dune/stuff/common/ranges.hh>
 #include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/parallel/threadmanager.hh>
 #include <dune/stuff/grid/entity.hh>
 
 namespace Dune {
@@ -176,6 +183,260 @@ private:
 }; // class EntityHierarchicSearch
 
 
+/**
+ * \brief Locates points in the codim 0 entities of a grid view, using a uniform grid of buckets.
+ *
+ *        The index is built once: each entity is stored in all buckets its bounding box overlaps, the number of
+ *        buckets is about the number of entities. Locating a point then only checks the entities of the bucket the
+ *        point lies in (first against their bounding box), instead of scanning the grid view. Unlike
+ *        EntityInlevelSearch, ret[ii] always corresponds to points[ii] and is nullptr if no entity contains it.
+ *
+ *        Batches of points (see find_all()) are sorted along a Morton curve over the buckets first and may be located
+ *        in parallel.
+ *
+ *        Only the seeds of the entities are stored, the entities are recreated from them when needed.
+ *
+ * \note  operator(), find() and find_all() do not modify the search. They (and find_all() with use_threads) may
+ *        only be called concurrently if the grid supports concurrent calls of entityPointer() and geometry(), which is
+ *        the case for YaspGrid but not for grids which pool their entities or cache geometries lazily (e.g. ALUGrid).
+ */
+template< class GridViewType >
+class EntityIndexedSearch
+  : public EntitySearchBase< GridViewType >
+{
+  typedef EntitySearchBase< GridViewType > BaseType;
+  typedef typename BaseType::EntityType             EntityType;
+  typedef typename BaseType::GlobalCoordinateType   GlobalCoordinateType;
+  typedef typename EntityType::EntityPointer        EntityPointerType;
+  typedef typename EntityType::EntitySeed           EntitySeedType;
+  typedef typename GridViewType::ctype              FieldType;
+  static const size_t dimWorld = GridViewType::dimensionworld;
+  typedef std::array< size_t, dimWorld > BucketIndexType;
+
+public:
+  typedef typename BaseType::EntityPointerVectorType EntityPointerVectorType;
+
+  EntityIndexedSearch(const GridViewType& gridview)
+    : gridview_(gridview)
+  {
+    // collect all entities and their bounding boxes
+    GlobalCoordinateType global_lower_left(0);
+    GlobalCoordinateType global_upper_right(0);
+    for (const auto& entity : DSC::entityRange(gridview_)) {
+      const auto& geometry = entity.geometry();
+      GlobalCoordinateType lower_left = geometry.corner(0);
+      GlobalCoordinateType upper_right = lower_left;
+      for (int cc = 1; cc < geometry.corners(); ++cc) {
+        const auto corner = geometry.corner(cc);
+        for (size_t dd = 0; dd < dimWorld; ++dd) {
+          lower_left[dd] = std::min(lower_left[dd], corner[dd]);
+          upper_right[dd] = std::max(upper_right[dd], corner[dd]);
+        }
+      }
+      if (seeds_.empty()) {
+        global_lower_left = lower_left;
+        global_upper_right = upper_right;
+      }
+      for (size_t dd = 0; dd < dimWorld; ++dd) {
+        global_lower_left[dd] = std::min(global_lower_left[dd], lower_left[dd]);
+        global_upper_right[dd] = std::max(global_upper_right[dd], upper_right[dd]);
+      }
+      seeds_.emplace_back(entity.seed());
+      lower_lefts_.push_back(lower_left);
+      upper_rights_.push_back(upper_right);
+    }
+    // enlarge the bounding boxes slightly, checkInside() is not exact either
+    const auto tolerance = 1e-10*(global_upper_right - global_lower_left).infinity_norm();
+    for (size_t ii = 0; ii < seeds_.size(); ++ii)
+      for (size_t dd = 0; dd < dimWorld; ++dd) {
+        lower_lefts_[ii][dd] -= tolerance;
+        upper_rights_[ii][dd] += tolerance;
+      }
+    // the buckets
+    lower_left_ = global_lower_left;
+    const size_t buckets_per_dim
+        = std::max(size_t(1), size_t(std::ceil(std::pow(FieldType(seeds_.size()), 1.0/FieldType(dimWorld)))));
+    size_t num_buckets = 1;
+    for (size_t dd = 0; dd < dimWorld; ++dd) {
+      num_buckets_[dd] = buckets_per_dim;
+      num_buckets *= buckets_per_dim;
+      const auto extent = global_upper_right[dd] - global_lower_left[dd];
+      bucket_width_[dd] = (extent > 0) ? extent/FieldType(buckets_per_dim) : FieldType(1);
+    }
+    // count, then fill
+    bucket_offsets_.assign(num_buckets + 1, 0);
+    for (size_t ii = 0; ii < seeds_.size(); ++ii)
+      for_each_bucket(lower_lefts_[ii], upper_rights_[ii], [&](const size_t bucket) { ++bucket_offsets_[bucket + 1]; });
+    for (size_t bb = 0; bb < num_buckets; ++bb)
+      bucket_offsets_[bb + 1] += bucket_offsets_[bb];
+    bucket_entries_.resize(bucket_offsets_[num_buckets]);
+    std::vector< size_t > fill(bucket_offsets_.begin(), bucket_offsets_.end() - 1);
+    for (size_t ii = 0; ii < seeds_.size(); ++ii)
+      for_each_bucket(lower_lefts_[ii], upper_rights_[ii], [&](const size_t bucket) {
+        bucket_entries_[fill[bucket]++] = ii;
+      });
+  } // EntityIndexedSearch(...)
+
+  //! \see find_all()
+  template< class PointContainerType >
+  EntityPointerVectorType operator()(const PointContainerType& points, const bool use_threads = false) const
+  {
+    std::vector< size_t > indices;
+    find_all(points, indices, use_threads);
+    EntityPointerVectorType ret(indices.size());
+    for (size_t ii = 0; ii < indices.size(); ++ii)
+      if (indices[ii] < size())
+        ret[ii] = DSC::make_unique< EntityPointerType >(entity(indices[ii]));
+    return ret;
+  } // ... operator()(...)
+
+  /**
+   * \brief Locates all points, indices[ii] is the index of the entity containing points[ii] or size() if there is none.
+   *
+   *        The points are located in the order of a Morton (Z-order) curve over the buckets, such that consecutive
+   *        lookups hit the same or neighboring buckets. If use_threads is true, this order is split into
+   *        threadManager().current_threads() times "threading.chunks_per_thread" chunks which are processed by
+   *        threadManager().pool().
+   */
+  template< class PointContainerType >
+  void find_all(const PointContainerType& points, std::vector< size_t >& indices, const bool use_threads = false) const
+  {
+    const size_t num_points = points.size();
+    indices.assign(num_points, size());
+    std::vector< const GlobalCoordinateType* > point_ptrs;
+    point_ptrs.reserve(num_points);
+    std::vector< std::pair< std::uint64_t, size_t > > order;
+    order.reserve(num_points);
+    for (const auto& point : points) {
+      order.emplace_back(morton_key(point), point_ptrs.size());
+      point_ptrs.push_back(&point);
+    }
+    std::sort(order.begin(), order.end());
+    const auto locate = [&](const size_t first, const size_t last) {
+      for (size_t kk = first; kk < last; ++kk) {
+        const size_t pp = order[kk].second;
+        size_t index = 0;
+        if (find(*point_ptrs[pp], index))
+          indices[pp] = index;
+      }
+    };
+    if (use_threads && threadManager().current_threads() > 1) {
+      const auto pool = threadManager().pool();
+      const size_t num_chunks = std::max(size_t(1),
+                                         std::min(num_points,
+                                                  DSC_CONFIG_GET("threading.chunks_per_thread", 8u) * pool->size()));
+      pool->parallel_for(0, num_points, num_chunks, locate);
+    } else
+      locate(0, num_points);
+  } // ... find_all(...)
+
+  /**
+   * \brief Looks for the entity containing point.
+   * \return false if there is none, otherwise the entity is entity(index)
+   */
+  bool find(const GlobalCoordinateType& point, size_t& index) const
+  {
+    BucketIndexType coordinates;
+    for (size_t dd = 0; dd < dimWorld; ++dd)
+      coordinates[dd] = bucket_coordinate(point[dd], dd);
+    const size_t bucket = bucket_index(coordinates);
+    for (size_t kk = bucket_offsets_[bucket]; kk < bucket_offsets_[bucket + 1]; ++kk) {
+      const size_t ii = bucket_entries_[kk];
+      bool inside_box = true;
+      for (size_t dd = 0; dd < dimWorld; ++dd)
+        inside_box = inside_box && !(point[dd] < lower_lefts_[ii][dd]) && !(point[dd] > upper_rights_[ii][dd]);
+      if (!inside_box)
+        continue;
+      const auto entity_ptr = gridview_.grid().entityPointer(seeds_[ii]);
+      const auto& geometry = entity_ptr->geometry();
+      if (DSG::reference_element(geometry).checkInside(geometry.local(point))) {
+        index = ii;
+        return true;
+      }
+    }
+    return false;
+  } // ... find(...)
+
+  //! number of entities in the order of the grid view
+  size_t size() const
+  {
+    return seeds_.size();
+  }
+
+  EntityPointerType entity(const size_t index) const
+  {
+    return gridview_.grid().entityPointer(seeds_[index]);
+  }
+
+private:
+  size_t bucket_coordinate(const FieldType& xx, const size_t dd) const
+  {
+    const auto pos = std::floor((xx - lower_left_[dd])/bucket_width_[dd]);
+    if (!(pos > 0))
+      return 0;
+    if (!(pos < FieldType(num_buckets_[dd] - 1)))
+      return num_buckets_[dd] - 1;
+    return size_t(pos);
+  }
+
+  //! interleaves the bits of the bucket coordinates of point
+  std::uint64_t morton_key(const GlobalCoordinateType& point) const
+  {
+    static const size_t bits = 64/dimWorld;
+    std::uint64_t key = 0;
+    for (size_t dd = 0; dd < dimWorld; ++dd) {
+      const std::uint64_t coordinate = bucket_coordinate(point[dd], dd);
+      for (size_t bb = 0; bb < bits; ++bb)
+        key |= ((coordinate >> bb) & 1u) << (bb*dimWorld + dd);
+    }
+    return key;
+  } // ... morton_key(...)
+
+  size_t bucket_index(const BucketIndexType& coordinates) const
+  {
+    size_t bucket = 0;
+    for (size_t dd = dimWorld; dd > 0; --dd)
+      bucket = bucket*num_buckets_[dd - 1] + coordinates[dd - 1];
+    return bucket;
+  }
+
+  //! calls functor(bucket) for all buckets overlapping the box [ll, ur]
+  template< class FunctorType >
+  void for_each_bucket(const GlobalCoordinateType& ll, const GlobalCoordinateType& ur, FunctorType functor) const
+  {
+    BucketIndexType lower, upper;
+    for (size_t dd = 0; dd < dimWorld; ++dd) {
+      lower[dd] = bucket_coordinate(ll[dd], dd);
+      upper[dd] = bucket_coordinate(ur[dd], dd);
+    }
+    auto current = lower;
+    while (true) {
+      functor(bucket_index(current));
+      size_t dd = 0;
+      for (; dd < dimWorld; ++dd) {
+        if (current[dd] < upper[dd]) {
+          ++current[dd];
+          break;
+        }
+        current[dd] = lower[dd];
+      }
+      if (dd == dimWorld)
+        return;
+    }
+  } // ... for_each_bucket(...)
+
+  const GridViewType gridview_;
+  std::vector< EntitySeedType > seeds_;
+  std::vector< GlobalCoordinateType > lower_lefts_;
+  std::vector< GlobalCoordinateType > upper_rights_;
+  GlobalCoordinateType lower_left_;
+  GlobalCoordinateType bucket_width_;
+  BucketIndexType num_buckets_;
+  std::vector< size_t > bucket_offsets_;
+  std::vector< size_t > bucket_entries_;
+}; // class EntityIndexedSearch
+
+
 template< class GV >
 EntityInlevelSearch< GV > make_entity_in_level_search(const GV& grid_view)
 {
@@ -190,6 +451,13 @@ EntityHierarchicSearch< GV > make_entity_hierarchic_search(const GV& grid_view)
 }
 
 
+template< class GV >
+EntityIndexedSearch< GV > make_entity_indexed_search(const GV& grid_view)
+{
+  return EntityIndexedSearch< GV >(grid_view);
+}
+
+
 } // namespace Grid
 } // namespace Stuff
 } // namespace Dune
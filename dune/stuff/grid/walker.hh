@@ -13,6 +13,8 @@
 #include <memory>
 #include <type_traits>
 #include <functional>
+#include <algorithm>
+#include <cassert>
 
 #include <dune/common/version.hh>
 
@@ -30,12 +32,15 @@
 #include <dune/stuff/grid/entity.hh>
 #include <dune/stuff/grid/intersection.hh>
 #include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/memory.hh>
 #include <dune/stuff/common/parallel/threadmanager.hh>
-#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/common/parallel/partitioner.hh>
 
 #include "walker/functors.hh"
 #include "walker/apply-on.hh"
 #include "walker/wrapper.hh"
+#include "walker/plan.hh"
 
 namespace Dune {
 namespace Stuff {
@@ -52,6 +57,9 @@ public:
   typedef typename Stuff::Grid::Entity< GridViewType >::Type       EntityType;
   typedef typename Stuff::Grid::Intersection< GridViewType >::Type IntersectionType;
 
+  typedef internal::FilterArgument< ApplyOn::WhichEntity< GridViewType > >       WhichEntitiesType;
+  typedef internal::FilterArgument< ApplyOn::WhichIntersection< GridViewType > > WhichIntersectionsType;
+
   explicit Walker(GridViewType grd_vw)
     : grid_view_(grd_vw)
   {}
@@ -61,82 +69,96 @@ public:
     return grid_view_;
   }
 
+  /**
+   *  \brief Creates a (stateful) filter, which lives until the next clear() (and thus walk()) of this walker.
+   *
+   *  The memory is reused after clear(), so that a walker which is refilled after each walk does not allocate. For the
+   *  stateless filters, use their instance().
+   */
+  template< class FilterType, class... Args >
+  const FilterType& make_filter(Args&&... args)
+  {
+    return *arena_.template create< FilterType >(std::forward< Args >(args)...);
+  }
+
   void add(std::function< void(const EntityType&) > lambda,
-           const ApplyOn::WhichEntity< GridViewType >* where = new ApplyOn::AllEntities< GridViewType >())
+           WhichEntitiesType where = ApplyOn::AllEntities< GridViewType >::instance())
   {
-    codim0_functors_.emplace_back(new internal::Codim0LambdaWrapper< GridViewType >(lambda, where));
+    add_codim0< internal::Codim0LambdaWrapper< GridViewType > >(std::move(lambda), keep(std::move(where)));
   }
 
   void add(std::function< void(const IntersectionType&, const EntityType&, const EntityType&) > lambda,
-           const ApplyOn::WhichIntersection< GridViewType >* where = new ApplyOn::AllIntersections< GridViewType >())
+           WhichIntersectionsType where = ApplyOn::AllIntersections< GridViewType >::instance())
   {
-    codim1_functors_.emplace_back(new internal::Codim1LambdaWrapper< GridViewType >(lambda, where));
+    add_codim1< internal::Codim1LambdaWrapper< GridViewType > >(std::move(lambda), keep(std::move(where)));
   }
 
   void add(Functor::Codim0< GridViewType >& functor,
-           const ApplyOn::WhichEntity< GridViewType >* where = new ApplyOn::AllEntities< GridViewType >())
+           WhichEntitiesType where = ApplyOn::AllEntities< GridViewType >::instance())
   {
-    codim0_functors_.emplace_back(
-          new internal::Codim0FunctorWrapper<GridViewType, Functor::Codim0< GridViewType > >(functor, where));
+    add_codim0< internal::Codim0FunctorWrapper< GridViewType, Functor::Codim0< GridViewType > > >(
+          functor, keep(std::move(where)));
   }
 
   void add(Functor::Codim1< GridViewType >& functor,
-           const ApplyOn::WhichIntersection< GridViewType >* where = new ApplyOn::AllIntersections< GridViewType >())
+           WhichIntersectionsType where = ApplyOn::AllIntersections< GridViewType >::instance())
+  {
+    add_codim1< internal::Codim1FunctorWrapper< GridViewType, Functor::Codim1< GridViewType > > >(
+          functor, keep(std::move(where)));
+  }
+
+  void add(Functor::Codim0Reducer< GridViewType >& reducer,
+           WhichEntitiesType where = ApplyOn::AllEntities< GridViewType >::instance())
+  {
+    add_codim0< internal::Codim0ReducerWrapper< GridViewType > >(reducer, keep(std::move(where)));
+  }
+
+  void add(Functor::Codim1Reducer< GridViewType >& reducer,
+           WhichIntersectionsType where = ApplyOn::AllIntersections< GridViewType >::instance())
   {
-    codim1_functors_.emplace_back(
-          new internal::Codim1FunctorWrapper<GridViewType, Functor::Codim1< GridViewType > >(functor, where));
+    add_codim1< internal::Codim1ReducerWrapper< GridViewType > >(reducer, keep(std::move(where)));
   }
 
   void add(Functor::Codim0And1< GridViewType >& functor,
-           const ApplyOn::WhichEntity< GridViewType >* which_entities = new ApplyOn::AllEntities< GridViewType >(),
-           const ApplyOn::WhichIntersection< GridViewType >* which_intersections
-              = new ApplyOn::AllIntersections< GridViewType >())
-  {
-    codim0_functors_.emplace_back(
-          new internal::Codim0FunctorWrapper<GridViewType, Functor::Codim0And1< GridViewType > >(functor,
-                                                                                                 which_entities));
-    codim1_functors_.emplace_back(
-          new internal::Codim1FunctorWrapper<GridViewType, Functor::Codim0And1< GridViewType > >(functor,
-                                                                                                 which_intersections));
+           WhichEntitiesType which_entities = ApplyOn::AllEntities< GridViewType >::instance(),
+           WhichIntersectionsType which_intersections = ApplyOn::AllIntersections< GridViewType >::instance())
+  {
+    add_codim0< internal::Codim0FunctorWrapper< GridViewType, Functor::Codim0And1< GridViewType > > >(
+          functor, keep(std::move(which_entities)));
+    add_codim1< internal::Codim1FunctorWrapper< GridViewType, Functor::Codim0And1< GridViewType > > >(
+          functor, keep(std::move(which_intersections)));
   }
 
   void add(Functor::Codim0And1< GridViewType >& functor,
-           const ApplyOn::WhichIntersection< GridViewType >* which_intersections,
-           const ApplyOn::WhichEntity< GridViewType >* which_entities = new ApplyOn::AllEntities< GridViewType >())
-  {
-    codim0_functors_.emplace_back(
-          new internal::Codim0FunctorWrapper<GridViewType, Functor::Codim0And1< GridViewType > >(functor,
-                                                                                                 which_entities));
-    codim1_functors_.emplace_back(
-          new internal::Codim1FunctorWrapper<GridViewType, Functor::Codim0And1< GridViewType > >(functor,
-                                                                                                 which_intersections));
+           WhichIntersectionsType which_intersections,
+           WhichEntitiesType which_entities = ApplyOn::AllEntities< GridViewType >::instance())
+  {
+    add(functor, std::move(which_entities), std::move(which_intersections));
   }
 
   void add(ThisType& other,
-           const ApplyOn::WhichEntity< GridViewType >* which_entities = new ApplyOn::AllEntities< GridViewType >(),
-           const ApplyOn::WhichIntersection< GridViewType >* which_intersections
-              = new ApplyOn::AllIntersections< GridViewType >())
+           WhichEntitiesType which_entities = ApplyOn::AllEntities< GridViewType >::instance(),
+           WhichIntersectionsType which_intersections = ApplyOn::AllIntersections< GridViewType >::instance())
   {
     if (&other == this)
       DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong, "Do not add a Walker to itself!");
-    codim0_functors_.emplace_back(new internal::WalkerWrapper< GridViewType, ThisType >(other, which_entities));
-    codim1_functors_.emplace_back(new internal::WalkerWrapper< GridViewType, ThisType >(other, which_intersections));
+    add_codim0< internal::WalkerWrapper< GridViewType, ThisType > >(other, keep(std::move(which_entities)));
+    add_codim1< internal::WalkerWrapper< GridViewType, ThisType > >(other, keep(std::move(which_intersections)));
   } // ... add(...)
 
   void add(ThisType& other,
-           const ApplyOn::WhichIntersection< GridViewType >* which_intersections,
-           const ApplyOn::WhichEntity< GridViewType >* which_entities = new ApplyOn::AllEntities< GridViewType >())
+           WhichIntersectionsType which_intersections,
+           WhichEntitiesType which_entities = ApplyOn::AllEntities< GridViewType >::instance())
   {
-    if (&other == this)
-      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong, "Do not add a Walker to itself!");
-    codim0_functors_.emplace_back(new internal::WalkerWrapper< GridViewType, ThisType >(other, which_entities));
-    codim1_functors_.emplace_back(new internal::WalkerWrapper< GridViewType, ThisType >(other, which_intersections));
+    add(other, std::move(which_entities), std::move(which_intersections));
   } // ... add(...)
 
+  //! removes all functors and destroys all filters which were adopted or created by make_filter()
   void clear()
   {
     codim0_functors_.clear();
     codim1_functors_.clear();
+    arena_.reset();
   } // ... clear()
 
   virtual void prepare()
@@ -163,22 +185,68 @@ public:
     return false;
   } // ... apply_on(...)
 
+  /**
+   *  Called for each entity by all walks (including replay()), derived walkers may override this and call it.
+   *  Within a walk the functors are applied with the partial results of the current chunk, see apply_local_chunk().
+   */
   virtual void apply_local(const EntityType& entity)
   {
-    for (auto& functor : codim0_functors_)
-      if (functor->apply_on(grid_view_, entity))
-        functor->apply_local(entity);
+    const LocalContext& context = local_context();
+    for (size_t ff = 0; ff < codim0_functors_.size(); ++ff) {
+      auto& functor = codim0_functors_[ff];
+      const unsigned char flag = context.replay ? context.replay->codim0[ff] : 0;
+      if (flag ? (context.plan_flags & flag) : functor->apply_on(grid_view_, entity))
+        functor->apply_local_chunk(entity, context.chunk);
+    }
   } // ... apply_local(...)
 
+  //! \sa apply_local(const EntityType&)
   virtual void apply_local(const IntersectionType& intersection,
                            const EntityType& inside_entity,
                            const EntityType& outside_entity)
   {
-    for (auto& functor : codim1_functors_)
-      if (functor->apply_on(grid_view_, intersection))
-        functor->apply_local(intersection, inside_entity, outside_entity);
+    const LocalContext& context = local_context();
+    for (size_t ff = 0; ff < codim1_functors_.size(); ++ff) {
+      auto& functor = codim1_functors_[ff];
+      const unsigned char flag = context.replay ? context.replay->codim1[ff] : 0;
+      if (flag ? (context.plan_flags & flag) : functor->apply_on(grid_view_, intersection))
+        functor->apply_local_chunk(intersection, inside_entity, outside_entity, context.chunk);
+    }
   } // ... apply_local(...)
 
+  void prepare_chunks(const size_t num_chunks)
+  {
+    for (auto& functor : codim0_functors_)
+      functor->prepare_chunks(num_chunks);
+    for (auto& functor : codim1_functors_)
+      functor->prepare_chunks(num_chunks);
+  } // ... prepare_chunks(...)
+
+  //! calls the (virtual) apply_local() with the partial results of the given chunk
+  void apply_local_chunk(const EntityType& entity, const size_t chunk)
+  {
+    const LocalContextScope scope(chunk);
+    apply_local(entity);
+  } // ... apply_local_chunk(...)
+
+  //! \sa apply_local_chunk(const EntityType&, const size_t)
+  void apply_local_chunk(const IntersectionType& intersection,
+                         const EntityType& inside_entity,
+                         const EntityType& outside_entity,
+                         const size_t chunk)
+  {
+    const LocalContextScope scope(chunk);
+    apply_local(intersection, inside_entity, outside_entity);
+  } // ... apply_local_chunk(...)
+
+  void join_chunks()
+  {
+    for (auto& functor : codim0_functors_)
+      functor->join_chunks();
+    for (auto& functor : codim1_functors_)
+      functor->join_chunks();
+  } // ... join_chunks()
+
   virtual void finalize()
   {
     for (auto& functor : codim0_functors_)
@@ -187,25 +255,35 @@ public:
       functor->finalize();
   } // ... finalize()
 
-  void walk(const bool use_tbb = false)
+  /**
+   *  \brief Applies all registered functors to all entities and intersections of the grid view.
+   *
+   *  If use_threads is true, the walk is carried out in parallel: with EXADUNE by means of a RangedPartitioning and
+   *  TBB, otherwise by splitting the entities into threadManager().current_threads() times
+   *  "threading.chunks_per_thread" chunks which are processed by threadManager().pool(). Each intersection is visited
+   *  from its inside entity, exactly as in the serial walk. Functor::Codim0Reducer and Functor::Codim1Reducer get a
+   *  private partial result per chunk, all other functors have to be thread safe.
+   */
+  void walk(const bool use_threads = false)
   {
 #if DUNE_VERSION_NEWER(DUNE_COMMON,3,9) //EXADUNE
-    if (use_tbb) {
+    if (use_threads) {
       const auto num_partitions = DSC_CONFIG_GET("threading.partition_factor", 1u)
                                   * threadManager().current_threads();
       RangedPartitioning< GridViewType, 0 > partitioning(grid_view_, num_partitions);
       this->walk(partitioning);
       return;
     }
-#else
-    const auto DUNE_UNUSED(no_warning_for_use_tbb) = use_tbb;
 #endif
     // prepare functors
     prepare();
 
     // only do something, if we have to
     if ((codim0_functors_.size() + codim1_functors_.size()) > 0) {
-      walk_range(DSC::entityRange(grid_view_));
+      if (use_threads && threadManager().current_threads() > 1)
+        walk_chunked(*threadManager().pool());
+      else
+        walk_range(DSC::entityRange(grid_view_));
     } // only do something, if we have to
 
     // finalize functors
@@ -213,6 +291,101 @@ public:
     clear();
   } // ... walk(...)
 
+  /**
+   *  \brief Walks the partitions of one color after the other, all partitions of one color in parallel.
+   *
+   *  Since partitions of the same color do not touch a common entity, codim 1 functors may write to the data of both
+   *  the inside and the outside entity without any locking. Reducers get a partial result per partition.
+   */
+  void walk_colored(const ColoredPartitioner< GridViewType >& partitioner)
+  {
+    // prepare functors
+    prepare();
+
+    // only do something, if we have to
+    if ((codim0_functors_.size() + codim1_functors_.size()) > 0) {
+      const auto pool = threadManager().pool();
+      const auto& grid = grid_view_.grid();
+      prepare_chunks(partitioner.partitions());
+      for (size_t color = 0; color < partitioner.colors(); ++color) {
+        const auto& partitions = partitioner.partitions_of_color(color);
+        pool->parallel_for(0, partitions.size(), partitions.size(), [&](const size_t first, const size_t last) {
+          for (size_t pp = first; pp < last; ++pp) {
+            const size_t partition = partitions[pp];
+            for (const auto& seed : partitioner.seeds(partition)) {
+              const auto entity_ptr = grid.entityPointer(seed);
+              const EntityType& entity = *entity_ptr;
+              walk_entity(entity, partition);
+            }
+          }
+        });
+      }
+      join_chunks();
+    }
+
+    // finalize functors
+    finalize();
+    clear();
+  } // ... walk_colored(...)
+
+  /**
+   *  \brief Same as walk(), but iterates the given TraversalPlan instead of the grid view.
+   *
+   *  Functors using one of the stateless ApplyOn filters are selected by the flags stored in the plan, all other
+   *  filters are evaluated as usual. The plan has to be created for the grid view of this walker and stays valid as
+   *  long as the grid is not changed.
+   *
+   *  \note Dune intersections cannot be stored or recreated from seeds, so the intersections of each visited entity
+   *        are still iterated via ibegin()/iend(), and the outside entity is still created via grid.entityPointer()
+   *        from its seed in the plan (instead of intersection.outside()). Only entities without any selected
+   *        intersection skip the intersection iteration altogether.
+   */
+  void replay(const TraversalPlan< GridViewType >& plan, const bool use_threads = false)
+  {
+    if (plan.size() != size_t(grid_view_.size(0)))
+      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong,
+                 "The given plan does not fit the grid view of this walker (plan.size(): " << plan.size()
+                 << ", grid_view.size(0): " << grid_view_.size(0) << ")!");
+    // prepare functors
+    prepare();
+
+    // only do something, if we have to
+    if ((codim0_functors_.size() + codim1_functors_.size()) > 0) {
+      ReplayFlags flags;
+      for (const auto& functor : codim0_functors_)
+        flags.codim0.push_back(functor->entity_plan_flag());
+      for (const auto& functor : codim1_functors_) {
+        const unsigned char flag = functor->intersection_plan_flag();
+        flags.codim1.push_back(flag);
+        flags.codim1_union |= flag;
+        flags.codim1_all_planned = flags.codim1_all_planned && (flag != 0);
+      }
+      const auto& grid = grid_view_.grid();
+      if (use_threads && threadManager().current_threads() > 1) {
+        const auto pool = threadManager().pool();
+        const size_t num_chunks = std::max(size_t(1),
+                                           std::min(plan.size(),
+                                                    DSC_CONFIG_GET("threading.chunks_per_thread", 8u) * pool->size()));
+        prepare_chunks(num_chunks);
+        pool->parallel_for(0, num_chunks, num_chunks, [&](const size_t first_chunk, const size_t last_chunk) {
+          for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+            const size_t last = ((chunk + 1) * plan.size()) / num_chunks;
+            for (size_t ee = (chunk * plan.size()) / num_chunks; ee < last; ++ee)
+              replay_entity(grid, plan, flags, ee, chunk);
+          }
+        });
+        join_chunks();
+      } else {
+        for (size_t ee = 0; ee < plan.size(); ++ee)
+          replay_entity(grid, plan, flags, ee, 0);
+      }
+    } // only do something, if we have to
+
+    // finalize functors
+    finalize();
+    clear();
+  } // ... replay(...)
+
 #if HAVE_TBB
 
 protected:
@@ -234,10 +407,11 @@ protected:
       // for all partitions in tbb-range
       for(std::size_t p = range.begin(); p != range.end(); ++p) {
         auto partition = partitioning_.partition(p);
-        walker_.walk_range(partition);
+        walker_.walk_range(partition, p);
       }
     }
 
+    //! the partial results of the reducers are kept per partition and joined in walk(), independent of scheduling
     void join(Body& /*other*/)
     {}
 
@@ -254,9 +428,11 @@ public:
 
     // only do something, if we have to
     if ((codim0_functors_.size() + codim1_functors_.size()) > 0) {
+      prepare_chunks(partitioning.partitions());
       tbb::blocked_range< std::size_t > range(0, partitioning.partitions());
       Body< PartioningType, ThisType > body(*this, partitioning);
       tbb::parallel_reduce(range, body);
+      join_chunks();
     }
 
     // finalize functors
@@ -267,8 +443,9 @@ public:
 #endif // HAVE_TBB
 
 protected:
+  //! if chunk is not given, all reducers are applied directly
   template< class EntityRange >
-  void walk_range(const EntityRange& entity_range)
+  void walk_range(const EntityRange& entity_range, const size_t chunk = 0)
   {
 #ifdef __INTEL_COMPILER
     const auto it_end = entity_range.end();
@@ -277,34 +454,178 @@ protected:
 #else
     for (const EntityType& entity : entity_range) {
 #endif
-      // apply codim0 functors
-      apply_local(entity);
-
-      // only walk the intersections, if there are codim1 functors present
-      if (codim1_functors_.size() > 0) {
-        // walk the intersections
-        const auto intersection_it_end = grid_view_.iend(entity);
-        for (auto intersection_it = grid_view_.ibegin(entity);
-             intersection_it != intersection_it_end;
-             ++intersection_it) {
-          const auto& intersection = *intersection_it;
-
-          // apply codim1 functors
-          if (intersection.neighbor()) {
-            const auto neighbor_ptr = intersection.outside();
-            const auto& neighbor = *neighbor_ptr;
-            apply_local(intersection, entity, neighbor);
-          } else
-            apply_local(intersection, entity, entity);
-
-        } // walk the intersections
-      } // only walk the intersections, if there are codim1 functors present
+      walk_entity(entity, chunk);
     }
   } // ... walk_range(...)
 
+  //! splits the entities into contiguous chunks of seeds and lets the (work stealing) pool process those
+  void walk_chunked(WorkStealingPool& pool)
+  {
+    typedef typename EntityType::EntitySeed EntitySeedType;
+    std::vector< EntitySeedType > seeds;
+    seeds.reserve(grid_view_.size(0));
+    for (const EntityType& entity : DSC::entityRange(grid_view_))
+      seeds.emplace_back(entity.seed());
+    const size_t num_chunks = std::max(size_t(1),
+                                       std::min(seeds.size(),
+                                                DSC_CONFIG_GET("threading.chunks_per_thread", 8u) * pool.size()));
+    const auto& grid = grid_view_.grid();
+    prepare_chunks(num_chunks);
+    pool.parallel_for(0, num_chunks, num_chunks, [&](const size_t first_chunk, const size_t last_chunk) {
+      for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+        const size_t last = ((chunk + 1) * seeds.size()) / num_chunks;
+        for (size_t ii = (chunk * seeds.size()) / num_chunks; ii < last; ++ii) {
+          const auto entity_ptr = grid.entityPointer(seeds[ii]);
+          const EntityType& entity = *entity_ptr;
+          walk_entity(entity, chunk);
+        }
+      }
+    });
+    join_chunks();
+  } // ... walk_chunked(...)
+
+  void walk_entity(const EntityType& entity, const size_t chunk)
+  {
+    // apply codim0 functors
+    apply_local_chunk(entity, chunk);
+
+    // only walk the intersections, if there are codim1 functors present
+    if (codim1_functors_.size() > 0) {
+      // walk the intersections
+      const auto intersection_it_end = grid_view_.iend(entity);
+      for (auto intersection_it = grid_view_.ibegin(entity);
+           intersection_it != intersection_it_end;
+           ++intersection_it) {
+        const auto& intersection = *intersection_it;
+
+        // apply codim1 functors
+        if (intersection.neighbor()) {
+          const auto neighbor_ptr = intersection.outside();
+          const auto& neighbor = *neighbor_ptr;
+          apply_local_chunk(intersection, entity, neighbor, chunk);
+        } else
+          apply_local_chunk(intersection, entity, entity, chunk);
+
+      } // walk the intersections
+    } // only walk the intersections, if there are codim1 functors present
+  } // ... walk_entity(...)
+
+  //! plan flags of the registered functors, 0 if the filter has to be evaluated
+  struct ReplayFlags
+  {
+    ReplayFlags()
+      : codim1_union(0)
+      , codim1_all_planned(true)
+    {}
+
+    std::vector< unsigned char > codim0;
+    std::vector< unsigned char > codim1;
+    unsigned char codim1_union;
+    bool codim1_all_planned;
+  }; // struct ReplayFlags
+
+  //! what the walk running on this thread hands to apply_local(), see apply_local_chunk() and replay_entity()
+  struct LocalContext
+  {
+    size_t chunk;
+    //! the plan flags of the functors during a replay(), nullptr otherwise
+    const ReplayFlags* replay;
+    unsigned char plan_flags;
+  }; // struct LocalContext
+
+  static LocalContext& local_context()
+  {
+    static thread_local LocalContext context = {0, nullptr, 0};
+    return context;
+  }
+
+  //! sets the context of this thread, restores the one of an enclosing (nested) walk on destruction
+  class LocalContextScope
+  {
+  public:
+    explicit LocalContextScope(const size_t chunk,
+                               const ReplayFlags* replay = nullptr,
+                               const unsigned char plan_flags = 0)
+      : previous_(local_context())
+    {
+      LocalContext& context = local_context();
+      context.chunk = chunk;
+      context.replay = replay;
+      context.plan_flags = plan_flags;
+    }
+
+    ~LocalContextScope()
+    {
+      local_context() = previous_;
+    }
+
+  private:
+    const LocalContext previous_;
+  }; // class LocalContextScope
+
+  template< class GridType >
+  void replay_entity(const GridType& grid,
+                     const TraversalPlan< GridViewType >& plan,
+                     const ReplayFlags& flags,
+                     const size_t ee,
+                     const size_t chunk)
+  {
+    const auto entity_ptr = grid.entityPointer(plan.entity_seed(ee));
+    const EntityType& entity = *entity_ptr;
+
+    // apply codim0 functors, the planned ones are selected by their flags in apply_local()
+    const LocalContextScope scope(chunk, &flags, plan.entity_flags(ee));
+    apply_local(entity);
+
+    // only walk the intersections, if one of them may be selected
+    if (codim1_functors_.size() == 0
+        || (flags.codim1_all_planned && !(plan.intersection_flags_of_entity(ee) & flags.codim1_union)))
+      return;
+    size_t ii = plan.intersections_begin(ee);
+    const auto intersection_it_end = grid_view_.iend(entity);
+    for (auto intersection_it = grid_view_.ibegin(entity);
+         intersection_it != intersection_it_end;
+         ++intersection_it, ++ii) {
+      const auto& intersection = *intersection_it;
+      assert(ii < plan.intersections_end(ee));
+      assert(plan.index_in_inside(ii) == intersection.indexInInside());
+      const unsigned char intersection_flags = plan.intersection_flags(ii);
+      if (flags.codim1_all_planned && !(intersection_flags & flags.codim1_union))
+        continue;
+      local_context().plan_flags = intersection_flags;
+      const size_t neighbor = plan.neighbor(ii);
+      if (neighbor != TraversalPlan< GridViewType >::no_neighbor) {
+        const auto neighbor_ptr = grid.entityPointer(plan.entity_seed(neighbor));
+        const EntityType& outside = *neighbor_ptr;
+        apply_local(intersection, entity, outside);
+      } else
+        apply_local(intersection, entity, entity);
+    }
+  } // ... replay_entity(...)
+
+  template< class WhichType >
+  const WhichType& keep(internal::FilterArgument< WhichType >&& where)
+  {
+    return where.adopt() ? *arena_.adopt(where.release()) : where.filter();
+  }
+
+  template< class WrapperType, class WrappedType, class WhichType >
+  void add_codim0(WrappedType&& wrapped, const WhichType& where)
+  {
+    codim0_functors_.push_back(arena_.template create< WrapperType >(std::forward< WrappedType >(wrapped), where));
+  }
+
+  template< class WrapperType, class WrappedType, class WhichType >
+  void add_codim1(WrappedType&& wrapped, const WhichType& where)
+  {
+    codim1_functors_.push_back(arena_.template create< WrapperType >(std::forward< WrappedType >(wrapped), where));
+  }
+
   const GridViewType grid_view_;
-  std::vector< std::unique_ptr< internal::Codim0Object<GridViewType> > > codim0_functors_;
-  std::vector< std::unique_ptr< internal::Codim1Object<GridViewType> > > codim1_functors_;
+  //! owns the wrappers and the filters, see clear()
+  Common::ObjectArena arena_;
+  std::vector< internal::Codim0Object< GridViewType >* > codim0_functors_;
+  std::vector< internal::Codim1Object< GridViewType >* > codim1_functors_;
 }; // class Walker
 
 } // namespace Grid
@@ -19,6 +19,31 @@ namespace Grid {
 namespace ApplyOn {
 
 
+/**
+ *  \brief Bits identifying the stateless filters below.
+ *
+ *  A TraversalPlan precomputes these for each entity and intersection, so that a replayed walk only needs to test a bit
+ *  instead of evaluating the filter.
+ */
+enum EntityPlanFlags : unsigned char
+{
+  all_entities_flag      = 1,
+  boundary_entities_flag = 2
+}; // enum EntityPlanFlags
+
+
+//! \sa EntityPlanFlags
+enum IntersectionPlanFlags : unsigned char
+{
+  all_intersections_flag                   = 1,
+  inner_intersections_flag                 = 2,
+  inner_intersections_primally_flag        = 4,
+  boundary_intersections_flag              = 8,
+  non_periodic_boundary_intersections_flag = 16,
+  periodic_intersections_flag              = 32
+}; // enum IntersectionPlanFlags
+
+
 /**
  *  \brief Interface for functors to tell on which entity to apply.
  *
@@ -40,6 +65,12 @@ public:
   virtual ~WhichEntity() {}
 
   virtual bool apply_on(const GridViewType& /*grid_view*/, const EntityType& /*entity*/) const = 0;
+
+  //! \return the EntityPlanFlags bit equivalent to apply_on(), 0 if there is none
+  virtual unsigned char plan_flag() const
+  {
+    return 0;
+  }
 }; // class WhichEntity
 
 
@@ -55,10 +86,22 @@ public:
   typedef typename BaseType::GridViewType GridViewType;
   typedef typename BaseType::EntityType   EntityType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const AllEntities< GridViewImp >& instance()
+  {
+    static const AllEntities< GridViewImp > filter = AllEntities< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/, const EntityType& /*entity*/) const override final
   {
     return true;
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return all_entities_flag;
+  }
 }; // class AllEntities
 
 
@@ -74,10 +117,22 @@ public:
   typedef typename BaseType::GridViewType GridViewType;
   typedef typename BaseType::EntityType   EntityType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const BoundaryEntities< GridViewImp >& instance()
+  {
+    static const BoundaryEntities< GridViewImp > filter = BoundaryEntities< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/, const EntityType& entity) const override final
   {
     return entity.hasBoundaryIntersections();
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return boundary_entities_flag;
+  }
 }; // class BoundaryEntities
 
 
@@ -102,6 +157,12 @@ public:
   virtual ~WhichIntersection< GridViewImp >() {}
 
   virtual bool apply_on(const GridViewType& /*grid_view*/, const IntersectionType& /*intersection*/) const = 0;
+
+  //! \return the IntersectionPlanFlags bit equivalent to apply_on(), 0 if there is none
+  virtual unsigned char plan_flag() const
+  {
+    return 0;
+  }
 }; // class WhichIntersection< GridViewImp >
 
 
@@ -118,11 +179,23 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const AllIntersections< GridViewImp >& instance()
+  {
+    static const AllIntersections< GridViewImp > filter = AllIntersections< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/,
                         const IntersectionType& /*intersection*/) const override final
   {
     return true;
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return all_intersections_flag;
+  }
 }; // class AllIntersections
 
 
@@ -144,11 +217,23 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const InnerIntersections< GridViewImp >& instance()
+  {
+    static const InnerIntersections< GridViewImp > filter = InnerIntersections< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/,
                         const IntersectionType& intersection) const override final
   {
     return intersection.neighbor() && !intersection.boundary();
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return inner_intersections_flag;
+  }
 }; // class InnerIntersections
 
 
@@ -171,6 +256,13 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const InnerIntersectionsPrimally< GridViewImp >& instance()
+  {
+    static const InnerIntersectionsPrimally< GridViewImp > filter = InnerIntersectionsPrimally< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& grid_view, const IntersectionType& intersection) const override final
   {
     if (intersection.neighbor() && !intersection.boundary()) {
@@ -182,6 +274,11 @@ public:
     } else
       return false;
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return inner_intersections_primally_flag;
+  }
 }; // class InnerIntersections
 
 
@@ -194,11 +291,23 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const BoundaryIntersections< GridViewImp >& instance()
+  {
+    static const BoundaryIntersections< GridViewImp > filter = BoundaryIntersections< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/,
                         const IntersectionType& intersection) const override final
   {
     return intersection.boundary();
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return boundary_intersections_flag;
+  }
 }; // class BoundaryIntersections
 
 
@@ -211,11 +320,24 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const NonPeriodicBoundaryIntersections< GridViewImp >& instance()
+  {
+    static const NonPeriodicBoundaryIntersections< GridViewImp > filter
+        = NonPeriodicBoundaryIntersections< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/,
                         const IntersectionType& intersection) const override final
   {
     return intersection.boundary() && !intersection.neighbor();
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return non_periodic_boundary_intersections_flag;
+  }
 }; // class BoundaryIntersections
 
 
@@ -237,11 +359,23 @@ public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
+  //! the filter is stateless, so all walkers may share this one
+  static const PeriodicIntersections< GridViewImp >& instance()
+  {
+    static const PeriodicIntersections< GridViewImp > filter = PeriodicIntersections< GridViewImp >();
+    return filter;
+  }
+
   virtual bool apply_on(const GridViewType& /*grid_view*/,
                         const IntersectionType& intersection) const override final
   {
     return intersection.neighbor() && intersection.boundary();
   }
+
+  virtual unsigned char plan_flag() const override final
+  {
+    return periodic_intersections_flag;
+  }
 }; // class PeriodicIntersections
 
 
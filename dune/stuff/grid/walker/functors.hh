@@ -9,6 +9,8 @@
 //nothing here will compile w/o grid present
 #if HAVE_DUNE_GRID
 
+#include <memory>
+
 #include <dune/stuff/grid/entity.hh>
 #include <dune/stuff/grid/intersection.hh>
 #include <dune/stuff/grid/boundaryinfo.hh>
@@ -78,15 +80,61 @@ public:
 }; // class Codim0And1
 
 
+/**
+ *  \brief Interface for codim 0 functors which accumulate a result, e.g. a sum or some statistics.
+ *
+ *  A parallel walk splits the entities into chunks, obtains an empty partial result for each chunk via split() and
+ *  applies the entities of a chunk only to its partial result. Afterwards, all partial results are merged pairwise in a
+ *  fixed binary tree via join() and finally joined into this functor, before finalize() is called on this functor.
+ *  Thus apply_local() does not need any locking and the result does not depend on the scheduling of the chunks.
+ *  prepare() and finalize() are never called on the partial results.
+ */
 template< class GridViewImp >
-class DirichletDetector
+class Codim0Reducer
+  : public Codim0< GridViewImp >
+{
+public:
+  typedef Codim0Reducer< GridViewImp > ReducerType;
+
+  virtual ~Codim0Reducer() {}
+
+  //! \return a functor with an empty partial result
+  virtual std::unique_ptr< ReducerType > split() const = 0;
+
+  //! merges the partial result of other, which has been obtained via split(), into this functor
+  virtual void join(const ReducerType& other) = 0;
+}; // class Codim0Reducer
+
+
+//! \sa Codim0Reducer
+template< class GridViewImp >
+class Codim1Reducer
   : public Codim1< GridViewImp >
 {
-  typedef Codim1< GridViewImp > BaseType;
+public:
+  typedef Codim1Reducer< GridViewImp > ReducerType;
+
+  virtual ~Codim1Reducer() {}
+
+  //! \return a functor with an empty partial result
+  virtual std::unique_ptr< ReducerType > split() const = 0;
+
+  //! merges the partial result of other, which has been obtained via split(), into this functor
+  virtual void join(const ReducerType& other) = 0;
+}; // class Codim1Reducer
+
+
+template< class GridViewImp >
+class DirichletDetector
+  : public Codim1Reducer< GridViewImp >
+{
+  typedef Codim1Reducer< GridViewImp > BaseType;
+  typedef DirichletDetector< GridViewImp > ThisType;
 public:
   typedef typename BaseType::GridViewType     GridViewType;
   typedef typename BaseType::EntityType       EntityType;
   typedef typename BaseType::IntersectionType IntersectionType;
+  typedef typename BaseType::ReducerType      ReducerType;
 
   explicit DirichletDetector(const BoundaryInfoInterface< IntersectionType >& boundary_info)
     : boundary_info_(boundary_info)
@@ -103,6 +151,16 @@ public:
       ++found_;
   }
 
+  virtual std::unique_ptr< ReducerType > split() const override
+  {
+    return std::unique_ptr< ReducerType >(new ThisType(boundary_info_));
+  }
+
+  virtual void join(const ReducerType& other) override
+  {
+    found_ += static_cast< const ThisType& >(other).found_;
+  }
+
   bool found() const
   {
     return found_ > 0;
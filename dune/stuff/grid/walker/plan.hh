@@ -0,0 +1,172 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_GRID_WALKER_PLAN_HH
+#define DUNE_STUFF_GRID_WALKER_PLAN_HH
+
+//nothing here will compile w/o grid present
+#if HAVE_DUNE_GRID
+
+#include <limits>
+#include <vector>
+
+#include <dune/stuff/grid/entity.hh>
+#include <dune/stuff/grid/intersection.hh>
+#include <dune/stuff/common/ranges.hh>
+
+#include "apply-on.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Grid {
+
+
+/**
+ *  \brief Flat record of a grid walk, to be replayed by Walker::replay() as long as the grid does not change.
+ *
+ *  Stores, in struct-of-arrays layout, the seeds of all entities in iteration order, their ApplyOn::EntityPlanFlags,
+ *  and for each entity the range of its intersections (CSR like) with their indexInInside(), their
+ *  ApplyOn::IntersectionPlanFlags and the position of the outside entity in the plan. A replayed walk thus neither
+ *  needs to evaluate the stateless ApplyOn filters nor to call intersection.outside(), and may skip the intersections
+ *  of an entity altogether if none of them is selected.
+ *
+ *  \note The intersections themselves are not part of the plan (they cannot be stored), so a replay still iterates
+ *        the intersections of each entity with a selected intersection and creates each outside entity from its seed.
+ */
+template< class GridViewImp >
+class TraversalPlan
+{
+public:
+  typedef GridViewImp GridViewType;
+  typedef typename Stuff::Grid::Entity< GridViewType >::Type       EntityType;
+  typedef typename Stuff::Grid::Intersection< GridViewType >::Type IntersectionType;
+  typedef typename EntityType::EntitySeed                          EntitySeedType;
+
+  static const size_t no_neighbor = std::numeric_limits< size_t >::max();
+
+  explicit TraversalPlan(const GridViewType& grid_view)
+    : intersection_offsets_(1, 0)
+  {
+    const auto& index_set = grid_view.indexSet();
+    const size_t num_entities = index_set.size(0);
+    entity_seeds_.reserve(num_entities);
+    entity_flags_.reserve(num_entities);
+    std::vector< size_t > position_of_index(num_entities, no_neighbor);
+    const auto& boundary_entities = ApplyOn::BoundaryEntities< GridViewType >::instance();
+    for (const EntityType& entity : DSC::entityRange(grid_view)) {
+      position_of_index[index_set.index(entity)] = entity_seeds_.size();
+      entity_seeds_.emplace_back(entity.seed());
+      entity_flags_.push_back(ApplyOn::all_entities_flag
+                              | (boundary_entities.apply_on(grid_view, entity) ? ApplyOn::boundary_entities_flag : 0));
+    }
+    intersection_offsets_.reserve(num_entities + 1);
+    intersection_flags_of_entity_.reserve(num_entities);
+    for (const EntityType& entity : DSC::entityRange(grid_view)) {
+      unsigned char flags_of_entity = 0;
+      const auto intersection_it_end = grid_view.iend(entity);
+      for (auto intersection_it = grid_view.ibegin(entity);
+           intersection_it != intersection_it_end;
+           ++intersection_it) {
+        const auto& intersection = *intersection_it;
+        const unsigned char flags = compute_flags(grid_view, intersection);
+        flags_of_entity |= flags;
+        intersection_flags_.push_back(flags);
+        index_in_inside_.push_back(intersection.indexInInside());
+        if (intersection.neighbor()) {
+          const auto neighbor_ptr = intersection.outside();
+          neighbors_.push_back(position_of_index[index_set.index(*neighbor_ptr)]);
+        } else
+          neighbors_.push_back(no_neighbor);
+      }
+      intersection_offsets_.push_back(intersection_flags_.size());
+      intersection_flags_of_entity_.push_back(flags_of_entity);
+    }
+  } // TraversalPlan(...)
+
+  //! number of entities
+  size_t size() const
+  {
+    return entity_seeds_.size();
+  }
+
+  const EntitySeedType& entity_seed(const size_t ee) const
+  {
+    return entity_seeds_[ee];
+  }
+
+  unsigned char entity_flags(const size_t ee) const
+  {
+    return entity_flags_[ee];
+  }
+
+  //! union of the flags of all intersections of the entity
+  unsigned char intersection_flags_of_entity(const size_t ee) const
+  {
+    return intersection_flags_of_entity_[ee];
+  }
+
+  size_t intersections_begin(const size_t ee) const
+  {
+    return intersection_offsets_[ee];
+  }
+
+  size_t intersections_end(const size_t ee) const
+  {
+    return intersection_offsets_[ee + 1];
+  }
+
+  unsigned char intersection_flags(const size_t ii) const
+  {
+    return intersection_flags_[ii];
+  }
+
+  int index_in_inside(const size_t ii) const
+  {
+    return index_in_inside_[ii];
+  }
+
+  //! position of the outside entity, no_neighbor if there is none
+  size_t neighbor(const size_t ii) const
+  {
+    return neighbors_[ii];
+  }
+
+private:
+  static unsigned char compute_flags(const GridViewType& grid_view, const IntersectionType& intersection)
+  {
+    unsigned char flags = ApplyOn::all_intersections_flag;
+    if (ApplyOn::InnerIntersections< GridViewType >::instance().apply_on(grid_view, intersection))
+      flags |= ApplyOn::inner_intersections_flag;
+    if (ApplyOn::InnerIntersectionsPrimally< GridViewType >::instance().apply_on(grid_view, intersection))
+      flags |= ApplyOn::inner_intersections_primally_flag;
+    if (ApplyOn::BoundaryIntersections< GridViewType >::instance().apply_on(grid_view, intersection))
+      flags |= ApplyOn::boundary_intersections_flag;
+    if (ApplyOn::NonPeriodicBoundaryIntersections< GridViewType >::instance().apply_on(grid_view, intersection))
+      flags |= ApplyOn::non_periodic_boundary_intersections_flag;
+    if (ApplyOn::PeriodicIntersections< GridViewType >::instance().apply_on(grid_view, intersection))
+      flags |= ApplyOn::periodic_intersections_flag;
+    return flags;
+  } // ... compute_flags(...)
+
+  std::vector< EntitySeedType > entity_seeds_;
+  std::vector< unsigned char > entity_flags_;
+  std::vector< unsigned char > intersection_flags_of_entity_;
+  std::vector< size_t > intersection_offsets_;
+  std::vector< unsigned char > intersection_flags_;
+  std::vector< int > index_in_inside_;
+  std::vector< size_t > neighbors_;
+}; // class TraversalPlan
+
+template< class GridViewImp >
+const size_t TraversalPlan< GridViewImp >::no_neighbor;
+
+
+} // namespace Grid
+} // namespace Stuff
+} // namespace Dune
+
+#endif // HAVE_DUNE_GRID
+
+#endif // DUNE_STUFF_GRID_WALKER_PLAN_HH
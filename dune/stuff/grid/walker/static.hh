@@ -0,0 +1,456 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_GRID_WALKER_STATIC_HH
+#define DUNE_STUFF_GRID_WALKER_STATIC_HH
+
+//nothing here will compile w/o grid present
+#if HAVE_DUNE_GRID
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <dune/stuff/grid/entity.hh>
+#include <dune/stuff/grid/intersection.hh>
+#include <dune/stuff/common/ranges.hh>
+
+#include "apply-on.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Grid {
+namespace internal {
+
+
+/**
+ *  \brief Detects at compile time, whether FunctorType is a codim 0 and/or codim 1 functor.
+ *
+ *  A codim 0 functor either provides apply_local(entity) (like Functor::Codim0) or can be called with an entity (like
+ *  a lambda), a codim 1 functor either provides apply_local(intersection, inside_entity, outside_entity) or can be
+ *  called with those arguments.
+ */
+template< class FunctorType, class GridViewType >
+class StaticFunctorTraits
+{
+  typedef typename Stuff::Grid::Entity< GridViewType >::Type       E;
+  typedef typename Stuff::Grid::Intersection< GridViewType >::Type I;
+
+  template< class F >
+  static auto member_codim0(F* f) -> decltype(f->apply_local(std::declval< const E& >()), std::true_type());
+  template< class F >
+  static std::false_type member_codim0(...);
+
+  template< class F >
+  static auto call_codim0(F* f) -> decltype((*f)(std::declval< const E& >()), std::true_type());
+  template< class F >
+  static std::false_type call_codim0(...);
+
+  template< class F >
+  static auto member_codim1(F* f) -> decltype(f->apply_local(std::declval< const I& >(),
+                                                             std::declval< const E& >(),
+                                                             std::declval< const E& >()),
+                                              std::true_type());
+  template< class F >
+  static std::false_type member_codim1(...);
+
+  template< class F >
+  static auto call_codim1(F* f) -> decltype((*f)(std::declval< const I& >(),
+                                                 std::declval< const E& >(),
+                                                 std::declval< const E& >()),
+                                            std::true_type());
+  template< class F >
+  static std::false_type call_codim1(...);
+
+  template< class F >
+  static auto member_prepare(F* f) -> decltype(f->prepare(), std::true_type());
+  template< class F >
+  static std::false_type member_prepare(...);
+
+  template< class F >
+  static auto member_finalize(F* f) -> decltype(f->finalize(), std::true_type());
+  template< class F >
+  static std::false_type member_finalize(...);
+
+public:
+  static const bool has_apply_local_codim0 = decltype(member_codim0< FunctorType >(nullptr))::value;
+  static const bool codim0 = has_apply_local_codim0 || decltype(call_codim0< FunctorType >(nullptr))::value;
+  static const bool has_apply_local_codim1 = decltype(member_codim1< FunctorType >(nullptr))::value;
+  static const bool codim1 = has_apply_local_codim1 || decltype(call_codim1< FunctorType >(nullptr))::value;
+  static const bool has_prepare = decltype(member_prepare< FunctorType >(nullptr))::value;
+  static const bool has_finalize = decltype(member_finalize< FunctorType >(nullptr))::value;
+}; // class StaticFunctorTraits
+
+
+//! \see filter()
+template< class FunctorImp, class FilterImp >
+class StaticFilteredFunctor
+{
+public:
+  typedef typename std::remove_reference< FunctorImp >::type FunctorType;
+  typedef FilterImp                                          FilterType;
+
+  StaticFilteredFunctor(FunctorImp&& functor, const FilterType& filter)
+    : functor_(std::forward< FunctorImp >(functor))
+    , filter_(filter)
+  {}
+
+  FunctorType& functor()
+  {
+    return functor_;
+  }
+
+  const FilterType& filter() const
+  {
+    return filter_;
+  }
+
+private:
+  FunctorImp functor_;
+  const FilterType filter_;
+}; // class StaticFilteredFunctor
+
+
+/**
+ *  \brief Calls the right methods of a functor, everything is resolved at compile time.
+ *
+ *  Functors which do not support a codim are skipped for this codim, the filters of a StaticFilteredFunctor are
+ *  called on their actual type, so their (final) apply_on() can be inlined.
+ */
+template< class FunctorType, class GridViewType >
+struct StaticDispatch
+{
+  typedef StaticFunctorTraits< FunctorType, GridViewType >         Traits;
+  typedef typename Stuff::Grid::Entity< GridViewType >::Type       EntityType;
+  typedef typename Stuff::Grid::Intersection< GridViewType >::Type IntersectionType;
+
+  static const bool codim0 = Traits::codim0;
+  static const bool codim1 = Traits::codim1;
+
+  static void prepare(FunctorType& functor)
+  {
+    prepare(functor, std::integral_constant< bool, Traits::has_prepare >());
+  }
+
+  static void finalize(FunctorType& functor)
+  {
+    finalize(functor, std::integral_constant< bool, Traits::has_finalize >());
+  }
+
+  static void apply(FunctorType& functor, const GridViewType& /*grid_view*/, const EntityType& entity)
+  {
+    apply(functor, entity, std::integral_constant< int, Traits::has_apply_local_codim0 ? 2 : (codim0 ? 1 : 0) >());
+  }
+
+  static void apply(FunctorType& functor,
+                    const GridViewType& /*grid_view*/,
+                    const IntersectionType& intersection,
+                    const EntityType& inside_entity,
+                    const EntityType& outside_entity)
+  {
+    apply(functor,
+          intersection,
+          inside_entity,
+          outside_entity,
+          std::integral_constant< int, Traits::has_apply_local_codim1 ? 2 : (codim1 ? 1 : 0) >());
+  }
+
+private:
+  static void prepare(FunctorType& functor, std::true_type)
+  {
+    functor.prepare();
+  }
+
+  static void prepare(FunctorType& /*functor*/, std::false_type) {}
+
+  static void finalize(FunctorType& functor, std::true_type)
+  {
+    functor.finalize();
+  }
+
+  static void finalize(FunctorType& /*functor*/, std::false_type) {}
+
+  static void apply(FunctorType& functor, const EntityType& entity, std::integral_constant< int, 2 >)
+  {
+    functor.apply_local(entity);
+  }
+
+  static void apply(FunctorType& functor, const EntityType& entity, std::integral_constant< int, 1 >)
+  {
+    functor(entity);
+  }
+
+  static void apply(FunctorType& /*functor*/, const EntityType& /*entity*/, std::integral_constant< int, 0 >) {}
+
+  static void apply(FunctorType& functor,
+                    const IntersectionType& intersection,
+                    const EntityType& inside_entity,
+                    const EntityType& outside_entity,
+                    std::integral_constant< int, 2 >)
+  {
+    functor.apply_local(intersection, inside_entity, outside_entity);
+  }
+
+  static void apply(FunctorType& functor,
+                    const IntersectionType& intersection,
+                    const EntityType& inside_entity,
+                    const EntityType& outside_entity,
+                    std::integral_constant< int, 1 >)
+  {
+    functor(intersection, inside_entity, outside_entity);
+  }
+
+  static void apply(FunctorType& /*functor*/,
+                    const IntersectionType& /*intersection*/,
+                    const EntityType& /*inside_entity*/,
+                    const EntityType& /*outside_entity*/,
+                    std::integral_constant< int, 0 >)
+  {}
+}; // struct StaticDispatch
+
+
+template< class FunctorImp, class FilterType, class GridViewType >
+struct StaticDispatch< StaticFilteredFunctor< FunctorImp, FilterType >, GridViewType >
+{
+  typedef StaticFilteredFunctor< FunctorImp, FilterType >                               FunctorType;
+  typedef StaticDispatch< typename FunctorType::FunctorType, GridViewType >             WrappedType;
+  typedef typename WrappedType::EntityType                                              EntityType;
+  typedef typename WrappedType::IntersectionType                                        IntersectionType;
+  typedef std::is_base_of< ApplyOn::WhichEntity< GridViewType >, FilterType >          IsEntityFilter;
+  typedef std::is_base_of< ApplyOn::WhichIntersection< GridViewType >, FilterType >    IsIntersectionFilter;
+  static_assert(IsEntityFilter::value || IsIntersectionFilter::value,
+                "FilterType has to be derived from ApplyOn::WhichEntity or ApplyOn::WhichIntersection!");
+
+  static const bool codim0 = WrappedType::codim0;
+  static const bool codim1 = WrappedType::codim1;
+
+  static void prepare(FunctorType& functor)
+  {
+    WrappedType::prepare(functor.functor());
+  }
+
+  static void finalize(FunctorType& functor)
+  {
+    WrappedType::finalize(functor.functor());
+  }
+
+  static void apply(FunctorType& functor, const GridViewType& grid_view, const EntityType& entity)
+  {
+    if (apply_on(functor.filter(), grid_view, entity, IsEntityFilter()))
+      WrappedType::apply(functor.functor(), grid_view, entity);
+  }
+
+  static void apply(FunctorType& functor,
+                    const GridViewType& grid_view,
+                    const IntersectionType& intersection,
+                    const EntityType& inside_entity,
+                    const EntityType& outside_entity)
+  {
+    if (apply_on(functor.filter(), grid_view, intersection, IsIntersectionFilter()))
+      WrappedType::apply(functor.functor(), grid_view, intersection, inside_entity, outside_entity);
+  }
+
+private:
+  template< class EntityOrIntersectionType >
+  static bool apply_on(const FilterType& filter,
+                       const GridViewType& grid_view,
+                       const EntityOrIntersectionType& entity_or_intersection,
+                       std::true_type)
+  {
+    return filter.apply_on(grid_view, entity_or_intersection);
+  }
+
+  template< class EntityOrIntersectionType >
+  static bool apply_on(const FilterType& /*filter*/,
+                       const GridViewType& /*grid_view*/,
+                       const EntityOrIntersectionType& /*entity_or_intersection*/,
+                       std::false_type)
+  {
+    return true;
+  }
+}; // struct StaticDispatch< StaticFilteredFunctor< ... >, ... >
+
+
+template< class GridViewType, class... FunctorTypes >
+struct StaticAnyCodim1
+  : public std::false_type
+{};
+
+template< class GridViewType, class FunctorType, class... FunctorTypes >
+struct StaticAnyCodim1< GridViewType, FunctorType, FunctorTypes... >
+  : public std::integral_constant< bool,
+                                   StaticDispatch< typename std::remove_reference< FunctorType >::type,
+                                                   GridViewType >::codim1
+                                   || StaticAnyCodim1< GridViewType, FunctorTypes... >::value >
+{};
+
+
+} // namespace internal
+
+
+/**
+ *  \brief Restricts a functor of a StaticWalker to the entities or intersections selected by which.
+ *
+ *  The functor is stored by reference if given as an lvalue and moved into the returned object otherwise, the filter
+ *  is copied. Filters may be nested.
+\code
+auto walker = make_static_walker(grid_view,
+                                 volume_functor,
+                                 filter(face_functor, ApplyOn::BoundaryIntersections< GridViewType >()));
+walker.walk();
+\endcode
+ */
+template< class FunctorType, class FilterType >
+internal::StaticFilteredFunctor< FunctorType, FilterType > filter(FunctorType&& functor, const FilterType& which)
+{
+  return internal::StaticFilteredFunctor< FunctorType, FilterType >(std::forward< FunctorType >(functor), which);
+}
+
+
+/**
+ *  \brief Grid walker which fuses all functors into one loop body at compile time.
+ *
+ *  In contrast to Walker, there are neither virtual calls nor std::function calls per entity or intersection: each
+ *  functor (a Functor::Codim0, Functor::Codim1, Functor::Codim0And1 or anything providing an apply_local() or
+ *  operator() with the same signatures, e.g. a lambda) is called directly, the ApplyOn filters given via filter() are
+ *  evaluated on their actual type and the intersections are only visited if at least one functor needs them. Use
+ *  make_static_walker() to create one.
+ */
+template< class GridViewImp, class... FunctorTypes >
+class StaticWalker
+{
+  typedef std::tuple< FunctorTypes... > FunctorTupleType;
+public:
+  typedef GridViewImp GridViewType;
+  typedef typename Stuff::Grid::Entity< GridViewType >::Type       EntityType;
+  typedef typename Stuff::Grid::Intersection< GridViewType >::Type IntersectionType;
+
+  static const bool has_codim1_functors = internal::StaticAnyCodim1< GridViewType, FunctorTypes... >::value;
+
+  template< class... Args >
+  explicit StaticWalker(GridViewType grd_vw, Args&&... functors)
+    : grid_view_(grd_vw)
+    , functors_(std::forward< Args >(functors)...)
+  {}
+
+  const GridViewType& grid_view() const
+  {
+    return grid_view_;
+  }
+
+  template< size_t ii >
+  typename std::remove_reference< typename std::tuple_element< ii, FunctorTupleType >::type >::type& functor()
+  {
+    return std::get< ii >(functors_);
+  }
+
+  void walk()
+  {
+    prepare< 0 >();
+    for (const EntityType& entity : DSC::entityRange(grid_view_)) {
+      apply_local< 0 >(entity);
+      walk_intersections(entity, std::integral_constant< bool, has_codim1_functors >());
+    }
+    finalize< 0 >();
+  } // ... walk()
+
+private:
+  template< size_t ii >
+  struct Dispatch
+    : public internal::StaticDispatch< typename std::remove_reference<
+                                           typename std::tuple_element< ii, FunctorTupleType >::type >::type,
+                                       GridViewType >
+  {
+    static_assert(Dispatch::codim0 || Dispatch::codim1,
+                  "Functor is neither a codim 0 nor a codim 1 functor for this grid view!");
+  };
+
+  void walk_intersections(const EntityType& /*entity*/, std::false_type) {}
+
+  void walk_intersections(const EntityType& entity, std::true_type)
+  {
+    const auto intersection_it_end = grid_view_.iend(entity);
+    for (auto intersection_it = grid_view_.ibegin(entity);
+         intersection_it != intersection_it_end;
+         ++intersection_it) {
+      const auto& intersection = *intersection_it;
+      if (intersection.neighbor()) {
+        const auto neighbor_ptr = intersection.outside();
+        const auto& neighbor = *neighbor_ptr;
+        apply_local< 0 >(intersection, entity, neighbor);
+      } else
+        apply_local< 0 >(intersection, entity, entity);
+    }
+  } // ... walk_intersections(...)
+
+  template< size_t ii >
+  typename std::enable_if< (ii < sizeof...(FunctorTypes)) >::type prepare()
+  {
+    Dispatch< ii >::prepare(std::get< ii >(functors_));
+    prepare< ii + 1 >();
+  }
+
+  template< size_t ii >
+  typename std::enable_if< (ii == sizeof...(FunctorTypes)) >::type prepare() {}
+
+  template< size_t ii >
+  typename std::enable_if< (ii < sizeof...(FunctorTypes)) >::type apply_local(const EntityType& entity)
+  {
+    Dispatch< ii >::apply(std::get< ii >(functors_), grid_view_, entity);
+    apply_local< ii + 1 >(entity);
+  }
+
+  template< size_t ii >
+  typename std::enable_if< (ii == sizeof...(FunctorTypes)) >::type apply_local(const EntityType& /*entity*/) {}
+
+  template< size_t ii >
+  typename std::enable_if< (ii < sizeof...(FunctorTypes)) >::type apply_local(const IntersectionType& intersection,
+                                                                               const EntityType& inside_entity,
+                                                                               const EntityType& outside_entity)
+  {
+    Dispatch< ii >::apply(std::get< ii >(functors_), grid_view_, intersection, inside_entity, outside_entity);
+    apply_local< ii + 1 >(intersection, inside_entity, outside_entity);
+  }
+
+  template< size_t ii >
+  typename std::enable_if< (ii == sizeof...(FunctorTypes)) >::type apply_local(const IntersectionType& /*intersection*/,
+                                                                                const EntityType& /*inside_entity*/,
+                                                                                const EntityType& /*outside_entity*/)
+  {}
+
+  template< size_t ii >
+  typename std::enable_if< (ii < sizeof...(FunctorTypes)) >::type finalize()
+  {
+    Dispatch< ii >::finalize(std::get< ii >(functors_));
+    finalize< ii + 1 >();
+  }
+
+  template< size_t ii >
+  typename std::enable_if< (ii == sizeof...(FunctorTypes)) >::type finalize() {}
+
+  const GridViewType grid_view_;
+  FunctorTupleType functors_;
+}; // class StaticWalker
+
+
+/**
+ *  \brief Creates a StaticWalker, functors given as lvalues are stored by reference, all others are moved.
+ *  \sa StaticWalker
+ */
+template< class GridViewType, class... FunctorTypes >
+StaticWalker< GridViewType, FunctorTypes... > make_static_walker(const GridViewType& grid_view,
+                                                                 FunctorTypes&&... functors)
+{
+  return StaticWalker< GridViewType, FunctorTypes... >(grid_view, std::forward< FunctorTypes >(functors)...);
+}
+
+
+} // namespace Grid
+} // namespace Stuff
+} // namespace Dune
+
+#endif // HAVE_DUNE_GRID
+
+#endif // DUNE_STUFF_GRID_WALKER_STATIC_HH
@@ -9,6 +9,9 @@
 //nothing here will compile w/o grid present
 #if HAVE_DUNE_GRID
 
+#include <memory>
+#include <vector>
+
 #include "functors.hh"
 #include "apply-on.hh"
 
@@ -18,6 +21,53 @@ namespace Grid {
 namespace internal {
 
 
+/**
+ *  \brief Filter argument of Walker::add(), following the convention of Common::ConstStorageProvider.
+ *
+ *  A pointer (as in walker.add(functor, new ApplyOn::BoundaryIntersections< GV >())) is adopted by the walker, a
+ *  reference (as in ApplyOn::BoundaryIntersections< GV >::instance() or a filter created by Walker::make_filter()) is
+ *  only referred to and has to outlive the walk.
+ */
+template< class WhichType >
+class FilterArgument
+{
+public:
+  FilterArgument(const WhichType* adopt)
+    : filter_(adopt)
+    , adopted_(adopt)
+  {}
+
+  FilterArgument(const WhichType& refer)
+    : filter_(&refer)
+  {}
+
+  //! would dangle
+  FilterArgument(WhichType&& temporary) = delete;
+
+  FilterArgument(FilterArgument&& source) = default;
+
+  //! whether the walker has to take ownership of the filter
+  bool adopt() const
+  {
+    return adopted_ != nullptr;
+  }
+
+  const WhichType& filter() const
+  {
+    return *filter_;
+  }
+
+  const WhichType* release()
+  {
+    return adopted_.release();
+  }
+
+private:
+  const WhichType* filter_;
+  std::unique_ptr< const WhichType > adopted_;
+}; // class FilterArgument
+
+
 template< class GridViewType >
 class Codim0Object
   : public Functor::Codim0< GridViewType >
@@ -29,6 +79,24 @@ public:
   virtual ~Codim0Object() {}
 
   virtual bool apply_on(const GridViewType& grid_view, const EntityType& entity) const = 0;
+
+  //! \return ApplyOn::WhichEntity::plan_flag() of the filter, 0 if apply_on() has to be evaluated
+  virtual unsigned char entity_plan_flag() const
+  {
+    return 0;
+  }
+
+  //! called before a parallel walk over num_chunks chunks of entities
+  virtual void prepare_chunks(const size_t /*num_chunks*/) {}
+
+  //! called instead of apply_local() during a parallel walk
+  virtual void apply_local_chunk(const EntityType& entity, const size_t /*chunk*/)
+  {
+    this->apply_local(entity);
+  }
+
+  //! called after a parallel walk, before finalize()
+  virtual void join_chunks() {}
 };
 
 
@@ -40,7 +108,7 @@ class Codim0FunctorWrapper
 public:
   typedef typename BaseType::EntityType EntityType;
 
-  Codim0FunctorWrapper(Codim0FunctorType& wrapped_functor, const ApplyOn::WhichEntity< GridViewType >* where)
+  Codim0FunctorWrapper(Codim0FunctorType& wrapped_functor, const ApplyOn::WhichEntity< GridViewType >& where)
     : wrapped_functor_(wrapped_functor)
     , where_(where)
   {}
@@ -54,7 +122,12 @@ public:
 
   virtual bool apply_on(const GridViewType& grid_view, const EntityType& entity) const override final
   {
-    return where_->apply_on(grid_view, entity);
+    return where_.apply_on(grid_view, entity);
+  }
+
+  virtual unsigned char entity_plan_flag() const override final
+  {
+    return where_.plan_flag();
   }
 
   virtual void apply_local(const EntityType& entity) override final
@@ -69,7 +142,7 @@ public:
 
 private:
   Codim0FunctorType& wrapped_functor_;
-  std::unique_ptr< const ApplyOn::WhichEntity< GridViewType > > where_;
+  const ApplyOn::WhichEntity< GridViewType >& where_;
 }; // class Codim0FunctorWrapper
 
 
@@ -79,11 +152,33 @@ class Codim1Object
 {
   typedef Functor::Codim1< GridViewType > BaseType;
 public:
+  typedef typename BaseType::EntityType       EntityType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
   virtual ~Codim1Object() {}
 
   virtual bool apply_on(const GridViewType& grid_view, const IntersectionType& intersection) const = 0;
+
+  //! \return ApplyOn::WhichIntersection::plan_flag() of the filter, 0 if apply_on() has to be evaluated
+  virtual unsigned char intersection_plan_flag() const
+  {
+    return 0;
+  }
+
+  //! \sa Codim0Object::prepare_chunks
+  virtual void prepare_chunks(const size_t /*num_chunks*/) {}
+
+  //! \sa Codim0Object::apply_local_chunk
+  virtual void apply_local_chunk(const IntersectionType& intersection,
+                                 const EntityType& inside_entity,
+                                 const EntityType& outside_entity,
+                                 const size_t /*chunk*/)
+  {
+    this->apply_local(intersection, inside_entity, outside_entity);
+  }
+
+  //! \sa Codim0Object::join_chunks
+  virtual void join_chunks() {}
 };
 
 
@@ -96,7 +191,7 @@ public:
   typedef typename BaseType::EntityType       EntityType;
   typedef typename BaseType::IntersectionType IntersectionType;
 
-  Codim1FunctorWrapper(Codim1FunctorType& wrapped_functor, const ApplyOn::WhichIntersection< GridViewType >* where)
+  Codim1FunctorWrapper(Codim1FunctorType& wrapped_functor, const ApplyOn::WhichIntersection< GridViewType >& where)
     : wrapped_functor_(wrapped_functor)
     , where_(where)
   {}
@@ -108,7 +203,12 @@ public:
 
   virtual bool apply_on(const GridViewType& grid_view, const IntersectionType& intersection) const override final
   {
-    return where_->apply_on(grid_view, intersection);
+    return where_.apply_on(grid_view, intersection);
+  }
+
+  virtual unsigned char intersection_plan_flag() const override final
+  {
+    return where_.plan_flag();
   }
 
   virtual void apply_local(const IntersectionType& intersection,
@@ -125,10 +225,128 @@ public:
 
 private:
   Codim1FunctorType& wrapped_functor_;
-  std::unique_ptr< const ApplyOn::WhichIntersection< GridViewType > > where_;
+  const ApplyOn::WhichIntersection< GridViewType >& where_;
 }; // class Codim1FunctorWrapper
 
 
+/**
+ *  \brief Keeps one partial result per chunk of a parallel walk and merges them in a fixed binary tree.
+ *
+ *  If prepare_chunks() has not been called, everything is applied to the wrapped reducer directly.
+ */
+template< class ReducerType >
+class ReducerPartials
+{
+public:
+  explicit ReducerPartials(ReducerType& reducer)
+    : reducer_(reducer)
+  {}
+
+  //! may be called several times (e.g. for nested walkers)
+  void prepare(const size_t num_chunks)
+  {
+    if (partials_.size() == num_chunks)
+      return;
+    partials_.clear();
+    partials_.reserve(num_chunks);
+    for (size_t ii = 0; ii < num_chunks; ++ii)
+      partials_.emplace_back(reducer_.split());
+  } // ... prepare(...)
+
+  ReducerType& get(const size_t chunk)
+  {
+    return partials_.empty() ? reducer_ : *partials_[chunk];
+  }
+
+  void join()
+  {
+    const size_t num_chunks = partials_.size();
+    for (size_t stride = 1; stride < num_chunks; stride *= 2)
+      for (size_t ii = 0; ii + stride < num_chunks; ii += 2 * stride)
+        partials_[ii]->join(*partials_[ii + stride]);
+    if (num_chunks > 0)
+      reducer_.join(*partials_[0]);
+    partials_.clear();
+  } // ... join()
+
+private:
+  ReducerType& reducer_;
+  std::vector< std::unique_ptr< ReducerType > > partials_;
+}; // class ReducerPartials
+
+
+template< class GridViewType >
+class Codim0ReducerWrapper
+  : public Codim0FunctorWrapper< GridViewType, Functor::Codim0Reducer< GridViewType > >
+{
+  typedef Codim0FunctorWrapper< GridViewType, Functor::Codim0Reducer< GridViewType > > BaseType;
+public:
+  typedef typename BaseType::EntityType EntityType;
+
+  Codim0ReducerWrapper(Functor::Codim0Reducer< GridViewType >& reducer,
+                       const ApplyOn::WhichEntity< GridViewType >& where)
+    : BaseType(reducer, where)
+    , partials_(reducer)
+  {}
+
+  virtual void prepare_chunks(const size_t num_chunks) override final
+  {
+    partials_.prepare(num_chunks);
+  }
+
+  virtual void apply_local_chunk(const EntityType& entity, const size_t chunk) override final
+  {
+    partials_.get(chunk).apply_local(entity);
+  }
+
+  virtual void join_chunks() override final
+  {
+    partials_.join();
+  }
+
+private:
+  ReducerPartials< Functor::Codim0Reducer< GridViewType > > partials_;
+}; // class Codim0ReducerWrapper
+
+
+template< class GridViewType >
+class Codim1ReducerWrapper
+  : public Codim1FunctorWrapper< GridViewType, Functor::Codim1Reducer< GridViewType > >
+{
+  typedef Codim1FunctorWrapper< GridViewType, Functor::Codim1Reducer< GridViewType > > BaseType;
+public:
+  typedef typename BaseType::EntityType       EntityType;
+  typedef typename BaseType::IntersectionType IntersectionType;
+
+  Codim1ReducerWrapper(Functor::Codim1Reducer< GridViewType >& reducer,
+                       const ApplyOn::WhichIntersection< GridViewType >& where)
+    : BaseType(reducer, where)
+    , partials_(reducer)
+  {}
+
+  virtual void prepare_chunks(const size_t num_chunks) override final
+  {
+    partials_.prepare(num_chunks);
+  }
+
+  virtual void apply_local_chunk(const IntersectionType& intersection,
+                                 const EntityType& inside_entity,
+                                 const EntityType& outside_entity,
+                                 const size_t chunk) override final
+  {
+    partials_.get(chunk).apply_local(intersection, inside_entity, outside_entity);
+  }
+
+  virtual void join_chunks() override final
+  {
+    partials_.join();
+  }
+
+private:
+  ReducerPartials< Functor::Codim1Reducer< GridViewType > > partials_;
+}; // class Codim1ReducerWrapper
+
+
 template<class GridViewType, class WalkerType>
 class WalkerWrapper
   : public Codim0Object< GridViewType >
@@ -138,15 +356,15 @@ public:
   typedef typename Codim1Object< GridViewType >::EntityType       EntityType;
   typedef typename Codim1Object< GridViewType >::IntersectionType IntersectionType;
 
-  WalkerWrapper(WalkerType& grid_walker, const ApplyOn::WhichEntity< GridViewType >* which_entities)
+  WalkerWrapper(WalkerType& grid_walker, const ApplyOn::WhichEntity< GridViewType >& which_entities)
     : grid_walker_(grid_walker)
     , which_entities_(which_entities)
-    , which_intersections_(new ApplyOn::AllIntersections< GridViewType >())
+    , which_intersections_(ApplyOn::AllIntersections< GridViewType >::instance())
   {}
 
-  WalkerWrapper(WalkerType& grid_walker, const ApplyOn::WhichIntersection< GridViewType >* which_intersections)
+  WalkerWrapper(WalkerType& grid_walker, const ApplyOn::WhichIntersection< GridViewType >& which_intersections)
     : grid_walker_(grid_walker)
-    , which_entities_(new ApplyOn::AllEntities< GridViewType >())
+    , which_entities_(ApplyOn::AllEntities< GridViewType >::instance())
     , which_intersections_(which_intersections)
   {}
 
@@ -159,12 +377,12 @@ public:
 
   virtual bool apply_on(const GridViewType& grid_view, const EntityType& entity) const override final
   {
-    return which_entities_->apply_on(grid_view, entity) && grid_walker_.apply_on(entity);
+    return which_entities_.apply_on(grid_view, entity) && grid_walker_.apply_on(entity);
   }
 
   virtual bool apply_on(const GridViewType& grid_view, const IntersectionType& intersection) const override final
   {
-    return which_intersections_->apply_on(grid_view, intersection) && grid_walker_.apply_on(intersection);
+    return which_intersections_.apply_on(grid_view, intersection) && grid_walker_.apply_on(intersection);
   }
 
   virtual void apply_local(const EntityType& entity) override final
@@ -179,6 +397,29 @@ public:
     grid_walker_.apply_local(intersection, inside_entity, outside_entity);
   }
 
+  virtual void prepare_chunks(const size_t num_chunks) override final
+  {
+    grid_walker_.prepare_chunks(num_chunks);
+  }
+
+  virtual void apply_local_chunk(const EntityType& entity, const size_t chunk) override final
+  {
+    grid_walker_.apply_local_chunk(entity, chunk);
+  }
+
+  virtual void apply_local_chunk(const IntersectionType& intersection,
+                                 const EntityType& inside_entity,
+                                 const EntityType& outside_entity,
+                                 const size_t chunk) override final
+  {
+    grid_walker_.apply_local_chunk(intersection, inside_entity, outside_entity, chunk);
+  }
+
+  virtual void join_chunks() override final
+  {
+    grid_walker_.join_chunks();
+  }
+
   virtual void finalize() override final
   {
     grid_walker_.finalize();
@@ -186,8 +427,8 @@ public:
 
 private:
   WalkerType& grid_walker_;
-  std::unique_ptr< const ApplyOn::WhichEntity< GridViewType > > which_entities_;
-  std::unique_ptr< const ApplyOn::WhichIntersection< GridViewType > > which_intersections_;
+  const ApplyOn::WhichEntity< GridViewType >& which_entities_;
+  const ApplyOn::WhichIntersection< GridViewType >& which_intersections_;
 }; // class WalkerWrapper
 
 
@@ -200,8 +441,8 @@ public:
   typedef typename BaseType::EntityType            EntityType;
   typedef std::function< void(const EntityType&) > LambdaType;
 
-  Codim0LambdaWrapper(LambdaType lambda, const ApplyOn::WhichEntity< GridViewType >* where)
-    : lambda_(lambda)
+  Codim0LambdaWrapper(LambdaType lambda, const ApplyOn::WhichEntity< GridViewType >& where)
+    : lambda_(std::move(lambda))
     , where_(where)
   {}
 
@@ -209,7 +450,12 @@ public:
 
   virtual bool apply_on(const GridViewType& grid_view, const EntityType& entity) const override final
   {
-    return where_->apply_on(grid_view, entity);
+    return where_.apply_on(grid_view, entity);
+  }
+
+  virtual unsigned char entity_plan_flag() const override final
+  {
+    return where_.plan_flag();
   }
 
   virtual void apply_local(const EntityType& entity) override final
@@ -219,7 +465,7 @@ public:
 
 private:
   LambdaType lambda_;
-  std::unique_ptr< const ApplyOn::WhichEntity< GridViewType > > where_;
+  const ApplyOn::WhichEntity< GridViewType >& where_;
 }; // class Codim0LambdaWrapper
 
 template<class GridViewType>
@@ -232,14 +478,19 @@ public:
   typedef typename BaseType::IntersectionType IntersectionType;
   typedef std::function< void(const IntersectionType&, const EntityType&, const EntityType&) > LambdaType;
 
-  Codim1LambdaWrapper(LambdaType lambda, const ApplyOn::WhichIntersection< GridViewType >* where)
-    : lambda_(lambda)
+  Codim1LambdaWrapper(LambdaType lambda, const ApplyOn::WhichIntersection< GridViewType >& where)
+    : lambda_(std::move(lambda))
     , where_(where)
   {}
 
   virtual bool apply_on(const GridViewType& grid_view, const IntersectionType& intersection) const override final
   {
-    return where_->apply_on(grid_view, intersection);
+    return where_.apply_on(grid_view, intersection);
+  }
+
+  virtual unsigned char intersection_plan_flag() const override final
+  {
+    return where_.plan_flag();
   }
 
   virtual void apply_local(const IntersectionType& intersection,
@@ -251,7 +502,7 @@ public:
 
 private:
   LambdaType lambda_;
-  std::unique_ptr< const ApplyOn::WhichIntersection< GridViewType > > where_;
+  const ApplyOn::WhichIntersection< GridViewType >& where_;
 }; // class Codim1FunctorWrapper
 
 
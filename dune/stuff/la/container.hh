@@ -10,6 +10,7 @@
 #include "container/common.hh"
 #include "container/eigen.hh"
 #include "container/istl.hh"
+#include "container/istl-block.hh"
 
 #include <dune/stuff/common/logging.hh>
 
@@ -0,0 +1,80 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_LA_CONTAINER_ACCUMULATOR_HH
+#define DUNE_STUFF_LA_CONTAINER_ACCUMULATOR_HH
+
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace Dune {
+namespace Stuff {
+namespace LA {
+
+
+/**
+ * \brief Thread safe accumulation into a sparse matrix with a fixed pattern, e.g. from the functors of a parallel
+ *        Walker.
+ *
+ *        The backend of the matrix is made unique once on construction, afterwards all entries are added via the
+ *        unchecked fast path of the matrix (unchecked_add_to_entry(), see IstlRowMajorSparseMatrix and
+ *        EigenRowMajorSparseMatrix). Additions to the same row are serialized by one of num_locks locks (row ii is
+ *        guarded by lock ii % num_locks), additions to different rows mostly run in parallel. add_to_row() adds a
+ *        whole segment of a row, e.g. one row of a local matrix, while taking the lock only once.
+ *
+ *        The pattern of the matrix must not change while the accumulator is in use and all entries added to must be
+ *        contained in it. Nothing is buffered, so the matrix is up to date as soon as all threads are done.
+ */
+template< class MatrixImp >
+class MatrixAccumulator
+  : boost::noncopyable
+{
+public:
+  typedef MatrixImp                       MatrixType;
+  typedef typename MatrixType::ScalarType ScalarType;
+
+  explicit MatrixAccumulator(MatrixType& matrix, const size_t num_locks = 1024)
+    : matrix_(matrix)
+    , locks_(std::max(size_t(1), num_locks))
+  {
+    matrix_.backend();
+  }
+
+  void add_to_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    std::lock_guard< std::mutex > guard(locks_[ii % locks_.size()]);
+    matrix_.unchecked_add_to_entry(ii, jj, value);
+  }
+
+  //! adds values[kk] to the entry (ii, cols[kk]) for all kk
+  template< class ColumnsType, class ValuesType >
+  void add_to_row(const size_t ii, const ColumnsType& cols, const ValuesType& values)
+  {
+    assert(cols.size() <= values.size());
+    std::lock_guard< std::mutex > guard(locks_[ii % locks_.size()]);
+    for (size_t kk = 0; kk < cols.size(); ++kk)
+      matrix_.unchecked_add_to_entry(ii, cols[kk], values[kk]);
+  } // ... add_to_row(...)
+
+  MatrixType& matrix()
+  {
+    return matrix_;
+  }
+
+private:
+  MatrixType& matrix_;
+  std::vector< std::mutex > locks_;
+}; // class MatrixAccumulator
+
+
+} // namespace LA
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_LA_CONTAINER_ACCUMULATOR_HH
@@ -12,6 +12,7 @@
 #include <initializer_list>
 #include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 #include <complex>
 
@@ -24,6 +25,7 @@
 #include <dune/common/ftraits.hh>
 
 #include "interfaces.hh"
+#include "kernels.hh"
 #include "pattern.hh"
 
 namespace Dune {
@@ -65,6 +67,160 @@ public:
 };
 
 
+/**
+ *  \brief The BLAS-1 operations of CommonDenseVector on its backend, see the specialization for double.
+ */
+template< class ScalarType >
+struct CommonDenseVectorKernels
+{
+  typedef Dune::DynamicVector< ScalarType >                   BackendType;
+  typedef typename Dune::FieldTraits< ScalarType >::real_type RealType;
+
+  static ScalarType dot(const BackendType& xx, const BackendType& yy)
+  {
+    return xx * yy;
+  }
+
+  static RealType l1_norm(const BackendType& xx)
+  {
+    return xx.one_norm();
+  }
+
+  static RealType l2_norm(const BackendType& xx)
+  {
+    return xx.two_norm();
+  }
+
+  static RealType sup_norm(const BackendType& xx)
+  {
+    return xx.infinity_norm();
+  }
+
+  static std::pair< size_t, RealType > amax(const BackendType& xx)
+  {
+    auto result = std::make_pair(size_t(0), RealType(0));
+    for (size_t ii = 0; ii < xx.size(); ++ii) {
+      const auto value = std::abs(xx[ii]);
+      if (value > result.second) {
+        result.first = ii;
+        result.second = value;
+      }
+    }
+    return result;
+  } // ... amax(...)
+
+  static std::pair< ScalarType, RealType > dot_and_l2_norm(const BackendType& xx, const BackendType& yy)
+  {
+    return std::make_pair(dot(xx, yy), l2_norm(xx));
+  }
+
+  static void scal(const ScalarType& alpha, BackendType& xx)
+  {
+    xx *= alpha;
+  }
+
+  static void axpby(const ScalarType& alpha, const BackendType& xx, const ScalarType& beta, BackendType& yy)
+  {
+    for (size_t ii = 0; ii < yy.size(); ++ii)
+      yy[ii] = alpha * xx[ii] + beta * yy[ii];
+  }
+
+  static void axpy(const ScalarType& alpha, const BackendType& xx, BackendType& yy)
+  {
+    for (size_t ii = 0; ii < yy.size(); ++ii)
+      yy[ii] += alpha * xx[ii];
+  }
+
+  static void add(const BackendType& xx, const BackendType& yy, BackendType& result)
+  {
+    for (size_t ii = 0; ii < result.size(); ++ii)
+      result[ii] = xx[ii] + yy[ii];
+  }
+
+  static void sub(const BackendType& xx, const BackendType& yy, BackendType& result)
+  {
+    for (size_t ii = 0; ii < result.size(); ++ii)
+      result[ii] = xx[ii] - yy[ii];
+  }
+}; // struct CommonDenseVectorKernels
+
+
+/**
+ *  \brief Uses the vectorized Kernels, chosen at runtime for the cpu we are running on.
+ */
+template<>
+struct CommonDenseVectorKernels< double >
+{
+  typedef Dune::DynamicVector< double > BackendType;
+
+  static double dot(const BackendType& xx, const BackendType& yy)
+  {
+    return Kernels::dot(xx.size(), data(xx), data(yy));
+  }
+
+  static double l1_norm(const BackendType& xx)
+  {
+    return Kernels::l1_norm(xx.size(), data(xx));
+  }
+
+  static double l2_norm(const BackendType& xx)
+  {
+    return Kernels::l2_norm(xx.size(), data(xx));
+  }
+
+  static double sup_norm(const BackendType& xx)
+  {
+    return Kernels::sup_norm(xx.size(), data(xx));
+  }
+
+  static std::pair< size_t, double > amax(const BackendType& xx)
+  {
+    return Kernels::amax(xx.size(), data(xx));
+  }
+
+  static std::pair< double, double > dot_and_l2_norm(const BackendType& xx, const BackendType& yy)
+  {
+    return Kernels::dot_and_l2_norm(xx.size(), data(xx), data(yy));
+  }
+
+  static void scal(const double& alpha, BackendType& xx)
+  {
+    Kernels::scal(xx.size(), alpha, data(xx));
+  }
+
+  static void axpby(const double& alpha, const BackendType& xx, const double& beta, BackendType& yy)
+  {
+    Kernels::axpby(yy.size(), alpha, data(xx), beta, data(yy));
+  }
+
+  static void axpy(const double& alpha, const BackendType& xx, BackendType& yy)
+  {
+    Kernels::axpy(yy.size(), alpha, data(xx), data(yy));
+  }
+
+  static void add(const BackendType& xx, const BackendType& yy, BackendType& result)
+  {
+    Kernels::add(result.size(), data(xx), data(yy), data(result));
+  }
+
+  static void sub(const BackendType& xx, const BackendType& yy, BackendType& result)
+  {
+    Kernels::sub(result.size(), data(xx), data(yy), data(result));
+  }
+
+private:
+  static const double* data(const BackendType& xx)
+  {
+    return xx.size() > 0 ? &(xx[0]) : nullptr;
+  }
+
+  static double* data(BackendType& xx)
+  {
+    return xx.size() > 0 ? &(xx[0]) : nullptr;
+  }
+}; // struct CommonDenseVectorKernels< double >
+
+
 } // namespace internal
 
 
@@ -79,6 +235,7 @@ class CommonDenseVector
 {
   typedef CommonDenseVector< ScalarImp >                                               ThisType;
   typedef VectorInterface< internal::CommonDenseVectorTraits< ScalarImp >, ScalarImp > VectorInterfaceType;
+  typedef internal::CommonDenseVectorKernels< typename VectorInterfaceType::ScalarType > KernelsType;
   static_assert(!std::is_same< DUNE_STUFF_SSIZE_T, int >::value,
                 "You have to manually disable the constructor below which uses DUNE_STUFF_SSIZE_T!");
 public:
@@ -194,7 +351,7 @@ public:
 
   void scal(const ScalarType& alpha)
   {
-    backend() *= alpha;
+    KernelsType::scal(alpha, backend());
   } // ... scal(...)
 
   void axpy(const ScalarType& alpha, const ThisType& xx)
@@ -203,10 +360,7 @@ public:
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of x (" << xx.size() << ") does not match the size of this (" << size() << ")!");
     ensure_uniqueness();
-    auto& this_ref = *backend_;
-    const auto& xx_ref = *(xx.backend_);
-    for (size_t ii = 0; ii < this_ref.size(); ++ii)
-      this_ref[ii] += alpha * xx_ref[ii];
+    KernelsType::axpy(alpha, *(xx.backend_), *backend_);
   } // ... axpy(...)
 
   bool has_equal_shape(const ThisType& other) const
@@ -264,24 +418,46 @@ public:
     if (other.size() != size())
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
-    return backend_->operator*(*(other.backend_));
+    return KernelsType::dot(*backend_, *(other.backend_));
   } // ... dot(...)
 
   virtual RealType l1_norm() const override final
   {
-    return backend_->one_norm();
+    return KernelsType::l1_norm(*backend_);
   }
 
   virtual RealType l2_norm() const override final
   {
-    return backend_->two_norm();
+    return KernelsType::l2_norm(*backend_);
   }
 
   virtual RealType sup_norm() const override final
   {
-    return backend_->infinity_norm();
+    return KernelsType::sup_norm(*backend_);
   }
 
+  virtual std::pair< size_t, RealType > amax() const override final
+  {
+    return KernelsType::amax(*backend_);
+  }
+
+  virtual std::pair< ScalarType, RealType > dot_and_l2_norm(const ThisType& other) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    return KernelsType::dot_and_l2_norm(*backend_, *(other.backend_));
+  } // ... dot_and_l2_norm(...)
+
+  virtual void axpby(const ScalarType& alpha, const ThisType& xx, const ScalarType& beta) override final
+  {
+    if (xx.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of xx (" << xx.size() << ") does not match the size of this (" << size() << ")!");
+    ensure_uniqueness();
+    KernelsType::axpby(alpha, *(xx.backend_), beta, *backend_);
+  } // ... axpby(...)
+
   virtual void add(const ThisType& other, ThisType& result) const override final
   {
     if (other.size() != size())
@@ -291,8 +467,7 @@ public:
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of result (" << result.size() << ") does not match the size of this (" << size() << ")!");
     BackendType& result_ref = result.backend();
-    for (size_t ii = 0; ii < size(); ++ii)
-      result_ref[ii] = backend_->operator[](ii) + other.backend_->operator[](ii);
+    KernelsType::add(*backend_, *(other.backend_), result_ref);
   } // ... add(...)
 
   virtual void iadd(const ThisType& other) override final
@@ -300,7 +475,8 @@ public:
     if (other.size() != size())
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
-    backend() += *(other.backend_);
+    BackendType& this_ref = backend();
+    KernelsType::add(this_ref, *(other.backend_), this_ref);
   } // ... iadd(...)
 
   virtual void sub(const ThisType& other, ThisType& result) const override final
@@ -312,8 +488,7 @@ public:
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of result (" << result.size() << ") does not match the size of this (" << size() << ")!");
     BackendType& result_ref = result.backend();
-    for (size_t ii = 0; ii < size(); ++ii)
-      result_ref[ii] = backend_->operator[](ii) - other.backend_->operator[](ii);
+    KernelsType::sub(*backend_, *(other.backend_), result_ref);
   } // ... sub(...)
 
   virtual void isub(const ThisType& other) override final
@@ -321,7 +496,8 @@ public:
     if (other.size() != size())
       DUNE_THROW(Exceptions::shapes_do_not_match,
                  "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
-    backend() -= *(other.backend_);
+    BackendType& this_ref = backend();
+    KernelsType::sub(this_ref, *(other.backend_), this_ref);
   } // ... isub(...)
 
   /// \}
@@ -390,6 +566,11 @@ public:
     : backend_(new BackendType(rr, cc, ScalarType(0)))
   {}
 
+  /// This constructors ignores the given pattern and initializes the matrix with 0.
+  CommonDenseMatrix(const size_t rr, const size_t cc, const SparsityPatternCSR& /*pattern*/)
+    : backend_(new BackendType(rr, cc, ScalarType(0)))
+  {}
+
   CommonDenseMatrix(const ThisType& other)
     : backend_(other.backend_)
   {}
@@ -518,6 +699,24 @@ public:
     backend()[ii][jj] += value;
   } // ... add_to_entry(...)
 
+  virtual void add_local(const std::vector< size_t >& global_rows,
+                         const std::vector< size_t >& global_cols,
+                         const Dune::DynamicMatrix< ScalarType >& local_matrix) override final
+  {
+    assert(local_matrix.rows() >= global_rows.size());
+    assert(local_matrix.cols() >= global_cols.size());
+    auto& matrix = backend();
+    for (size_t ii = 0; ii < global_rows.size(); ++ii) {
+      assert(global_rows[ii] < rows());
+      auto& row = matrix[global_rows[ii]];
+      const auto& local_row = local_matrix[ii];
+      for (size_t jj = 0; jj < global_cols.size(); ++jj) {
+        assert(global_cols[jj] < cols());
+        row[global_cols[jj]] += local_row[jj];
+      }
+    }
+  } // ... add_local(...)
+
   void set_entry(const size_t ii, const size_t jj, const ScalarType& value)
   {
     assert(ii < rows());
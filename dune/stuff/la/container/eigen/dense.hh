@@ -417,6 +417,14 @@ public:
     backend_->setZero();
   }
 
+  /// This constructors ignores the given pattern and initializes the matrix with 0.
+  EigenDenseMatrix(const size_t rr, const size_t cc, const SparsityPatternCSR& /*pattern*/)
+    : backend_(new BackendType(internal::boost_numeric_cast< EIGEN_size_t >(rr),
+                               internal::boost_numeric_cast< EIGEN_size_t >(cc)))
+  {
+    backend_->setZero();
+  }
+
   EigenDenseMatrix(const ThisType& other) = default;
 
   /**
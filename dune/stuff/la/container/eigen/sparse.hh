@@ -6,6 +6,7 @@
 #ifndef DUNE_STUFF_LA_CONTAINER_EIGEN_SPARSE_HH
 #define DUNE_STUFF_LA_CONTAINER_EIGEN_SPARSE_HH
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -123,6 +124,50 @@ public:
     }
   } // EigenRowMajorSparseMatrix(...)
 
+  /**
+   * \brief Creates a sparse matrix by copying the arrays of the pattern directly into the compressed backend.
+   * \see   SparsityPatternBuilder
+   */
+  EigenRowMajorSparseMatrix(const size_t rr, const size_t cc, const SparsityPatternCSR& pattern)
+  {
+    backend_ = std::make_shared< BackendType >(internal::boost_numeric_cast< EIGEN_size_t >(rr),
+                                               internal::boost_numeric_cast< EIGEN_size_t >(cc));
+    if (rr > 0 && cc > 0) {
+      if (pattern.size() != rr)
+        DUNE_THROW(Exceptions::shapes_do_not_match,
+                   "The size of the pattern (" << pattern.size()
+                   << ") does not match the number of rows of this (" << rr << ")!");
+      typedef typename std::remove_reference< decltype(*backend_->outerIndexPtr()) >::type StorageIndexType;
+      const auto& row_offsets = pattern.row_offsets();
+      const auto& column_indices = pattern.column_indices();
+      // empty rows get an entry in the first column, as above
+      size_t nonzeros = pattern.nonzeros();
+      for (size_t row = 0; row < rr; ++row)
+        if (row_offsets[row] == row_offsets[row + 1])
+          ++nonzeros;
+      backend_->resizeNonZeros(internal::boost_numeric_cast< StorageIndexType >(nonzeros));
+      StorageIndexType* outer = backend_->outerIndexPtr();
+      StorageIndexType* inner = backend_->innerIndexPtr();
+      size_t kk = 0;
+      for (size_t row = 0; row < rr; ++row) {
+        outer[row] = StorageIndexType(kk);
+        if (row_offsets[row] == row_offsets[row + 1])
+          inner[kk++] = 0;
+        for (size_t jj = row_offsets[row]; jj < row_offsets[row + 1]; ++jj) {
+#ifndef NDEBUG
+          if (column_indices[jj] >= cc)
+            DUNE_THROW(Exceptions::shapes_do_not_match,
+                       "The size of row " << row << " of the pattern does not match the number of columns of this ("
+                       << cc << ")!");
+#endif // NDEBUG
+          inner[kk++] = StorageIndexType(column_indices[jj]);
+        }
+      }
+      outer[rr] = StorageIndexType(kk);
+      std::fill(backend_->valuePtr(), backend_->valuePtr() + kk, ScalarType(0));
+    }
+  } // EigenRowMajorSparseMatrix(...)
+
   explicit EigenRowMajorSparseMatrix(const size_t rr = 0, const size_t cc = 0)
   {
     backend_ = std::make_shared<BackendType>(rr, cc);
@@ -266,6 +311,67 @@ public:
                        internal::boost_numeric_cast< EIGEN_size_t >(jj)) += value;
   }
 
+  /**
+   * \brief Like add_to_entry(), but does not check if the backend is shared with another matrix.
+   * \note  Call backend() once before (as MatrixAccumulator does). Unlike coeffRef(), this never inserts an entry
+   *        into the pattern, so different entries may be added to concurrently. The entry has to be contained in the
+   *        pattern, which is only checked in debug builds.
+   */
+  void unchecked_add_to_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    assert(these_are_valid_indices(ii, jj));
+    const auto* inner = backend_->innerIndexPtr();
+    const auto row_begin = backend_->outerIndexPtr()[ii];
+    const auto row_end = backend_->isCompressed() ? backend_->outerIndexPtr()[ii + 1]
+                                                  : row_begin + backend_->innerNonZeroPtr()[ii];
+    const auto position = std::lower_bound(inner + row_begin, inner + row_end, EIGEN_size_t(jj)) - inner;
+#ifndef NDEBUG
+    if (position == row_end || inner[position] != EIGEN_size_t(jj))
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Entry (" << ii << ", " << jj << ") is not contained in the pattern of this!");
+#endif // NDEBUG
+    backend_->valuePtr()[position] += value;
+  } // ... unchecked_add_to_entry(...)
+
+  /**
+   * \brief Finds the column positions of each row once and walks them in the order of the sorted columns.
+   * \note  Entries not contained in the pattern are inserted (as in add_to_entry()), which is slow.
+   */
+  virtual void add_local(const std::vector< size_t >& global_rows,
+                         const std::vector< size_t >& global_cols,
+                         const Dune::DynamicMatrix< ScalarType >& local_matrix) override final
+  {
+    assert(local_matrix.rows() >= global_rows.size());
+    assert(local_matrix.cols() >= global_cols.size());
+    if (global_cols.empty())
+      return;
+    auto& matrix = backend();
+    const auto& order = internal::sorting_permutation(global_cols);
+    for (size_t ii = 0; ii < global_rows.size(); ++ii) {
+      assert(global_rows[ii] < rows());
+      const EIGEN_size_t row = internal::boost_numeric_cast< EIGEN_size_t >(global_rows[ii]);
+      const auto& local_row = local_matrix[ii];
+      const auto* inner = matrix.innerIndexPtr();
+      EIGEN_size_t row_end = matrix.isCompressed() ? matrix.outerIndexPtr()[row + 1]
+                                                   : matrix.outerIndexPtr()[row] + matrix.innerNonZeroPtr()[row];
+      EIGEN_size_t position = matrix.outerIndexPtr()[row];
+      for (const size_t jj : order) {
+        assert(global_cols[jj] < cols());
+        const EIGEN_size_t col = internal::boost_numeric_cast< EIGEN_size_t >(global_cols[jj]);
+        while (position < row_end && inner[position] < col)
+          ++position;
+        if (position < row_end && inner[position] == col) {
+          matrix.valuePtr()[position] += local_row[jj];
+        } else {
+          // the insertion may reallocate and moves the entries of this row behind position
+          matrix.coeffRef(row, col) += local_row[jj];
+          inner = matrix.innerIndexPtr();
+          row_end = matrix.outerIndexPtr()[row] + matrix.innerNonZeroPtr()[row];
+        }
+      }
+    }
+  } // ... add_local(...)
+
   void set_entry(const size_t ii, const size_t jj, const ScalarType& value)
   {
     assert(these_are_valid_indices(ii, jj));
@@ -0,0 +1,807 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff/
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_LA_CONTAINER_ISTL_BLOCK_HH
+#define DUNE_STUFF_LA_CONTAINER_ISTL_BLOCK_HH
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <initializer_list>
+#include <complex>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/typetraits.hh>
+#include <dune/common/ftraits.hh>
+
+#if HAVE_DUNE_ISTL
+# include <dune/istl/bvector.hh>
+# include <dune/istl/bcrsmatrix.hh>
+#endif
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/profiler.hh>
+#include <dune/stuff/common/math.hh>
+
+#include "interfaces.hh"
+#include "pattern.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace LA {
+
+// forward
+template< class ScalarImp, size_t blocksize >
+class IstlDenseBlockVector;
+
+template< class ScalarImp, size_t blocksize >
+class IstlBlockSparseMatrix;
+
+#if HAVE_DUNE_ISTL
+
+
+namespace internal {
+
+
+/**
+ * \brief Traits for IstlDenseBlockVector.
+ */
+template< class ScalarImp, size_t blocksize >
+class IstlDenseBlockVectorTraits
+{
+public:
+  typedef typename Dune::FieldTraits< ScalarImp >::field_type ScalarType;
+  typedef typename Dune::FieldTraits< ScalarImp >::real_type  RealType;
+  typedef IstlDenseBlockVector< ScalarImp, blocksize >        derived_type;
+  typedef BlockVector< FieldVector< ScalarType, blocksize > > BackendType;
+}; // class IstlDenseBlockVectorTraits
+
+
+/**
+ * \brief Traits for IstlBlockSparseMatrix.
+ */
+template< class ScalarImp, size_t blocksize >
+class IstlBlockSparseMatrixTraits
+{
+public:
+  typedef typename Dune::FieldTraits< ScalarImp >::field_type           ScalarType;
+  typedef typename Dune::FieldTraits< ScalarImp >::real_type            RealType;
+  typedef IstlBlockSparseMatrix< ScalarType, blocksize >                derived_type;
+  typedef BCRSMatrix< FieldMatrix< ScalarType, blocksize, blocksize > > BackendType;
+}; // class IstlBlockSparseMatrixTraits
+
+
+//! \throws Exceptions::shapes_do_not_match if size is not a multiple of blocksize
+template< size_t blocksize >
+size_t num_blocks(const size_t size)
+{
+  if (size % blocksize != 0)
+    DUNE_THROW(Exceptions::shapes_do_not_match,
+               "The given size (" << size << ") is not a multiple of the block size (" << blocksize << ")!");
+  return size / blocksize;
+} // ... num_blocks(...)
+
+
+} // namespace internal
+
+
+/**
+ * \brief A dense vector implementation of VectorInterface using a Dune::BlockVector with blocks of size blocksize.
+ *
+ *        The interface addresses the scalar entries, entry ii being the (ii % blocksize)-th entry of the
+ *        (ii / blocksize)-th block. Use this together with IstlBlockSparseMatrix for vector valued problems, the dofs
+ *        of which are numbered blockwise.
+ */
+template< class ScalarImp, size_t blocksize >
+class IstlDenseBlockVector
+  : public VectorInterface< internal::IstlDenseBlockVectorTraits< ScalarImp, blocksize >, ScalarImp >
+  , public ProvidesBackend< internal::IstlDenseBlockVectorTraits< ScalarImp, blocksize > >
+  , public ProvidesDataAccess< internal::IstlDenseBlockVectorTraits< ScalarImp, blocksize > >
+{
+  typedef IstlDenseBlockVector< ScalarImp, blocksize > ThisType;
+  static_assert(blocksize > 0, "");
+  static_assert(!std::is_same< DUNE_STUFF_SSIZE_T, int >::value,
+                "You have to manually disable the constructor below which uses DUNE_STUFF_SSIZE_T!");
+public:
+  typedef internal::IstlDenseBlockVectorTraits< ScalarImp, blocksize > Traits;
+  typedef typename Traits::ScalarType                                  ScalarType;
+  typedef typename Traits::RealType                                    RealType;
+  typedef typename Traits::BackendType                                 BackendType;
+
+  //! \throws Exceptions::shapes_do_not_match if ss is not a multiple of blocksize
+  explicit IstlDenseBlockVector(const size_t ss = 0, const ScalarType value = ScalarType(0))
+    : backend_(new BackendType(internal::num_blocks< blocksize >(ss)))
+  {
+    backend_->operator=(value);
+  }
+
+  /// This constructor is needed for the python bindings.
+  explicit IstlDenseBlockVector(const DUNE_STUFF_SSIZE_T ss, const ScalarType value = ScalarType(0))
+    : IstlDenseBlockVector(internal::boost_numeric_cast< size_t >(ss), value)
+  {}
+
+  /// This constructor is needed because marking the above one as explicit had no effect.
+  explicit IstlDenseBlockVector(const int ss, const ScalarType value = ScalarType(0))
+    : IstlDenseBlockVector(internal::boost_numeric_cast< size_t >(ss), value)
+  {}
+
+  explicit IstlDenseBlockVector(const std::vector< ScalarType >& other)
+    : backend_(new BackendType(internal::num_blocks< blocksize >(other.size())))
+  {
+    for (size_t ii = 0; ii < other.size(); ++ii)
+      get_entry_ref(ii) = other[ii];
+  }
+
+  explicit IstlDenseBlockVector(const std::initializer_list< ScalarType >& other)
+    : backend_(new BackendType(internal::num_blocks< blocksize >(other.size())))
+  {
+    size_t ii = 0;
+    for (auto element : other) {
+      get_entry_ref(ii) = element;
+      ++ii;
+    }
+  } // IstlDenseBlockVector(...)
+
+  IstlDenseBlockVector(const ThisType& other) = default;
+
+  explicit IstlDenseBlockVector(const BackendType& other,
+                                const bool /*prune*/ = false,
+                                const ScalarType /*eps*/ = Common::FloatCmp::DefaultEpsilon< ScalarType >::value())
+    : backend_(new BackendType(other))
+  {}
+
+  /**
+   *  \note Takes ownership of backend_ptr in the sense that you must not delete it afterwards!
+   */
+  explicit IstlDenseBlockVector(BackendType* backend_ptr)
+    : backend_(backend_ptr)
+  {}
+
+  explicit IstlDenseBlockVector(std::shared_ptr< BackendType > backend_ptr)
+    : backend_(backend_ptr)
+  {}
+
+  ThisType& operator=(const ThisType& other)
+  {
+    backend_ = other.backend_;
+    return *this;
+  }
+
+  /**
+   *  \note Does a deep copy.
+   */
+  ThisType& operator=(const BackendType& other)
+  {
+    backend_ = std::make_shared< BackendType >(other);
+    return *this;
+  }
+
+  /// \name Required by the ProvidesBackend interface.
+  /// \{
+
+  ThisType& operator=(const ScalarType& value)
+  {
+    backend() = value;
+    return *this;
+  }
+
+  BackendType& backend()
+  {
+    ensure_uniqueness();
+    return *backend_;
+  }
+
+  const BackendType& backend() const
+  {
+    ensure_uniqueness();
+    return *backend_;
+  }
+
+  /// \}
+  /// \name Required by ProvidesDataAccess.
+  /// \{
+
+  //! the blocks are stored contiguously, so these are all size() entries
+  ScalarType* data()
+  {
+    return &(backend()[0][0]);
+  }
+
+  /// \}
+  /// \name Required by ContainerInterface.
+  /// \{
+
+  ThisType copy() const
+  {
+    return ThisType(*backend_);
+  }
+
+  void scal(const ScalarType& alpha)
+  {
+    backend() *= alpha;
+  }
+
+  void axpy(const ScalarType& alpha, const ThisType& xx)
+  {
+    if (xx.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of x (" << xx.size() << ") does not match the size of this (" << size() << ")!");
+    backend().axpy(alpha, *(xx.backend_));
+  }
+
+  bool has_equal_shape(const ThisType& other) const
+  {
+    return size() == other.size();
+  }
+
+  /// \}
+  /// \name Required by VectorInterface.
+  /// \{
+
+  inline size_t size() const
+  {
+    return backend_->N() * blocksize;
+  }
+
+  void add_to_entry(const size_t ii, const ScalarType& value)
+  {
+    assert(ii < size());
+    backend()[ii / blocksize][ii % blocksize] += value;
+  }
+
+  void set_entry(const size_t ii, const ScalarType& value)
+  {
+    assert(ii < size());
+    backend()[ii / blocksize][ii % blocksize] = value;
+  }
+
+  ScalarType get_entry(const size_t ii) const
+  {
+    assert(ii < size());
+    return backend_->operator[](ii / blocksize)[ii % blocksize];
+  }
+
+private:
+  inline ScalarType& get_entry_ref(const size_t ii)
+  {
+    return backend()[ii / blocksize][ii % blocksize];
+  }
+
+  inline const ScalarType& get_entry_ref(const size_t ii) const
+  {
+    return backend_->operator[](ii / blocksize)[ii % blocksize];
+  }
+
+public:
+
+  /// \}
+  /// \name These methods override default implementations from VectorInterface..
+  /// \{
+
+  virtual ScalarType dot(const ThisType& other) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    return backend_->dot(*(other.backend_));
+  } // ... dot(...)
+
+  virtual RealType l1_norm() const override final
+  {
+    return backend_->one_norm();
+  }
+
+  virtual RealType l2_norm() const override final
+  {
+    return backend_->two_norm();
+  }
+
+  virtual RealType sup_norm() const override final
+  {
+    return backend_->infinity_norm();
+  }
+
+  virtual void add(const ThisType& other, ThisType& result) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    if (result.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of result (" << result.size() << ") does not match the size of this (" << size() << ")!");
+    result.backend() = *(backend_);
+    result.backend() += *(other.backend_);
+  } // ... add(...)
+
+  virtual ThisType add(const ThisType& other) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    ThisType result = copy();
+    result.backend_->operator+=(*(other.backend_));
+    return result;
+  } // ... add(...)
+
+  virtual void iadd(const ThisType& other) override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    backend() += *(other.backend_);
+  } // ... iadd(...)
+
+  virtual void sub(const ThisType& other, ThisType& result) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    if (result.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of result (" << result.size() << ") does not match the size of this (" << size() << ")!");
+    result.backend() = *(backend_);
+    result.backend() -= *(other.backend_);
+  } // ... sub(...)
+
+  virtual ThisType sub(const ThisType& other) const override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    ThisType result = copy();
+    result.backend_->operator-=(*(other.backend_));
+    return result;
+  } // ... sub(...)
+
+  virtual void isub(const ThisType& other) override final
+  {
+    if (other.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of other (" << other.size() << ") does not match the size of this (" << size() << ")!");
+    backend() -= *(other.backend_);
+  } // ... isub(...)
+
+  /// \}
+
+private:
+  /**
+   * \see ContainerInterface
+   */
+  inline void ensure_uniqueness() const
+  {
+    if (!backend_.unique())
+      backend_ = std::make_shared< BackendType >(*backend_);
+  } // ... ensure_uniqueness(...)
+
+  friend class VectorInterface< internal::IstlDenseBlockVectorTraits< ScalarType, blocksize >, ScalarType >;
+  friend class IstlBlockSparseMatrix< ScalarType, blocksize >;
+
+  mutable std::shared_ptr< BackendType > backend_;
+}; // class IstlDenseBlockVector
+
+
+/**
+ * \brief A sparse matrix implementation of the MatrixInterface using a Dune::BCRSMatrix with dense blocks of size
+ *        blocksize x blocksize.
+ *
+ *        Only one column index is stored per block, which saves up to blocksize^2 of the index memory of
+ *        IstlRowMajorSparseMatrix and speeds up mv(). As for IstlDenseBlockVector, the interface addresses the scalar
+ *        entries and the given sizes and patterns are those of the scalar matrix: a block is contained in the pattern
+ *        of this matrix if any of its entries is contained in the given pattern (all other entries of the block are
+ *        stored as zeros).
+ */
+template< class ScalarImp, size_t blocksize >
+class IstlBlockSparseMatrix
+  : public MatrixInterface< internal::IstlBlockSparseMatrixTraits< ScalarImp, blocksize >, ScalarImp >
+  , public ProvidesBackend< internal::IstlBlockSparseMatrixTraits< ScalarImp, blocksize > >
+{
+  typedef IstlBlockSparseMatrix< ScalarImp, blocksize > ThisType;
+  static_assert(blocksize > 0, "");
+  static_assert(!std::is_same< DUNE_STUFF_SSIZE_T, int >::value,
+                "You have to manually disable the constructor below which uses DUNE_STUFF_SSIZE_T!");
+public:
+  typedef internal::IstlBlockSparseMatrixTraits< ScalarImp, blocksize > Traits;
+  typedef typename Traits::BackendType                                  BackendType;
+  typedef typename Traits::ScalarType                                   ScalarType;
+  typedef typename Traits::RealType                                     RealType;
+
+  static std::string static_id() { return "stuff.la.container.istl.istlblocksparsematrix"; }
+
+  /**
+   * \brief This is the constructor of interest which creates a sparse matrix.
+   * \throws Exceptions::shapes_do_not_match if rr or cc is not a multiple of blocksize
+   */
+  IstlBlockSparseMatrix(const size_t rr, const size_t cc, const SparsityPatternDefault& patt)
+  {
+    if (patt.size() != rr)
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of the pattern (" << patt.size()
+                 << ") does not match the number of rows of this (" << rr << ")!");
+    build_sparse_matrix(rr, cc, patt);
+    backend_->operator*=(ScalarType(0));
+  } // ... IstlBlockSparseMatrix(...)
+
+  //! \see SparsityPatternBuilder
+  IstlBlockSparseMatrix(const size_t rr, const size_t cc, const SparsityPatternCSR& patt)
+  {
+    if (patt.size() != rr)
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of the pattern (" << patt.size()
+                 << ") does not match the number of rows of this (" << rr << ")!");
+    build_sparse_matrix(rr, cc, patt);
+    backend_->operator*=(ScalarType(0));
+  } // ... IstlBlockSparseMatrix(...)
+
+  explicit IstlBlockSparseMatrix(const size_t rr = 0, const size_t cc = 0)
+    : backend_(new BackendType(internal::num_blocks< blocksize >(rr),
+                               internal::num_blocks< blocksize >(cc),
+                               BackendType::row_wise))
+  {}
+
+  /// This constructor is needed for the python bindings.
+  explicit IstlBlockSparseMatrix(const DUNE_STUFF_SSIZE_T rr, const DUNE_STUFF_SSIZE_T cc = 0)
+    : IstlBlockSparseMatrix(internal::boost_numeric_cast< size_t >(rr), internal::boost_numeric_cast< size_t >(cc))
+  {}
+
+  /// This constructor is needed for the python bindings.
+  explicit IstlBlockSparseMatrix(const int rr, const int cc = 0)
+    : IstlBlockSparseMatrix(internal::boost_numeric_cast< size_t >(rr), internal::boost_numeric_cast< size_t >(cc))
+  {}
+
+  IstlBlockSparseMatrix(const ThisType& other) = default;
+
+  explicit IstlBlockSparseMatrix(const BackendType& mat)
+    : backend_(new BackendType(mat))
+  {}
+
+  /**
+   *  \note Takes ownership of backend_ptr in the sense that you must not delete it afterwards!
+   */
+  explicit IstlBlockSparseMatrix(BackendType* backend_ptr)
+    : backend_(backend_ptr)
+  {}
+
+  explicit IstlBlockSparseMatrix(std::shared_ptr< BackendType > backend_ptr)
+    : backend_(backend_ptr)
+  {}
+
+  ThisType& operator=(const ThisType& other)
+  {
+    backend_ = other.backend_;
+    return *this;
+  } // ... operator=(...)
+
+  /**
+   *  \note Does a deep copy.
+   */
+  ThisType& operator=(const BackendType& other)
+  {
+    backend_ = std::make_shared< BackendType >(other);
+    return *this;
+  } // ... operator=(...)
+
+  /// \name Required by the ProvidesBackend interface.
+  /// \{
+
+  BackendType& backend()
+  {
+    ensure_uniqueness();
+    return *backend_;
+  }
+
+  const BackendType& backend() const
+  {
+    ensure_uniqueness();
+    return *backend_;
+  }
+
+  /// \}
+  /// \name Required by ContainerInterface.
+  /// \{
+
+  ThisType copy() const
+  {
+    return ThisType(*backend_);
+  }
+
+  void scal(const ScalarType& alpha)
+  {
+    backend() *= alpha;
+  }
+
+  void axpy(const ScalarType& alpha, const ThisType& xx)
+  {
+    if (!has_equal_shape(xx))
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The shape of xx (" << xx.rows() << "x" << xx.cols()
+                 << ") does not match the shape of this (" << rows() << "x" << cols() << ")!");
+    backend().axpy(alpha, *(xx.backend_));
+  } // ... axpy(...)
+
+  bool has_equal_shape(const ThisType& other) const
+  {
+    return (rows() == other.rows()) && (cols() == other.cols());
+  }
+
+  /// \}
+  /// \name Required by MatrixInterface.
+  /// \{
+
+  inline size_t rows() const
+  {
+    return backend_->N() * blocksize;
+  }
+
+  inline size_t cols() const
+  {
+    return backend_->M() * blocksize;
+  }
+
+  inline void mv(const IstlDenseBlockVector< ScalarType, blocksize >& xx,
+                 IstlDenseBlockVector< ScalarType, blocksize >& yy) const
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".mv");
+    backend_->mv(*(xx.backend_), yy.backend());
+  }
+
+  void add_to_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    assert(these_are_valid_indices(ii, jj));
+    backend()[ii / blocksize][jj / blocksize][ii % blocksize][jj % blocksize] += value;
+  }
+
+  /**
+   * \brief Finds the block positions of each row once and walks them in the order of the sorted columns.
+   * \note  Throws Exceptions::index_out_of_range if the block of an entry is not contained in the pattern.
+   *        All entries are checked before the first one is added, so this is left unchanged if it throws.
+   */
+  virtual void add_local(const std::vector< size_t >& global_rows,
+                         const std::vector< size_t >& global_cols,
+                         const Dune::DynamicMatrix< ScalarType >& local_matrix) override final
+  {
+    assert(local_matrix.rows() >= global_rows.size());
+    assert(local_matrix.cols() >= global_cols.size());
+    if (global_cols.empty())
+      return;
+    ensure_uniqueness();
+    const auto& order = internal::sorting_permutation(global_cols);
+    // first check all entries, then add
+    for (const bool add : {false, true}) {
+      for (size_t ii = 0; ii < global_rows.size(); ++ii) {
+        assert(global_rows[ii] < rows());
+        auto& row = backend_->operator[](global_rows[ii] / blocksize);
+        const size_t row_in_block = global_rows[ii] % blocksize;
+        const auto& local_row = local_matrix[ii];
+        auto block = row.find(global_cols[order[0]] / blocksize);
+        for (const size_t jj : order) {
+          const size_t block_col = global_cols[jj] / blocksize;
+          while (block != row.end() && block.index() < block_col)
+            ++block;
+          if (block == row.end() || block.index() != block_col)
+            DUNE_THROW(Exceptions::index_out_of_range,
+                       "Entry (" << global_rows[ii] << ", " << global_cols[jj] << ") is not contained in the pattern!");
+          else if (add)
+            (*block)[row_in_block][global_cols[jj] % blocksize] += local_row[jj];
+        }
+      }
+    }
+  } // ... add_local(...)
+
+  void set_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    assert(these_are_valid_indices(ii, jj));
+    backend()[ii / blocksize][jj / blocksize][ii % blocksize][jj % blocksize] = value;
+  }
+
+  ScalarType get_entry(const size_t ii, const size_t jj) const
+  {
+    assert(ii < rows());
+    assert(jj < cols());
+    if (these_are_valid_indices(ii, jj))
+      return backend_->operator[](ii / blocksize)[jj / blocksize][ii % blocksize][jj % blocksize];
+    else
+      return ScalarType(0);
+  } // ... get_entry(...)
+
+  void clear_row(const size_t ii)
+  {
+    if (ii >= rows())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given ii (" << ii << ") is larger than the rows of this (" << rows() << ")!");
+    ensure_uniqueness();
+    auto& row = backend_->operator[](ii / blocksize);
+    for (auto block = row.begin(); block != row.end(); ++block)
+      (*block)[ii % blocksize] = ScalarType(0);
+  } // ... clear_row(...)
+
+  void clear_col(const size_t jj)
+  {
+    if (jj >= cols())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given jj (" << jj << ") is larger than the cols of this (" << cols() << ")!");
+    ensure_uniqueness();
+    for (size_t ii = 0; ii < backend_->N(); ++ii) {
+      auto& row = backend_->operator[](ii);
+      const auto block = row.find(jj / blocksize);
+      if (block != row.end())
+        for (size_t rr = 0; rr < blocksize; ++rr)
+          (*block)[rr][jj % blocksize] = ScalarType(0);
+    }
+  } // ... clear_col(...)
+
+  void unit_row(const size_t ii)
+  {
+    if (ii >= cols())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given ii (" << ii << ") is larger than the cols of this (" << cols() << ")!");
+    if (ii >= rows())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given ii (" << ii << ") is larger than the rows of this (" << rows() << ")!");
+    if (!backend_->exists(ii / blocksize, ii / blocksize))
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Diagonal entry (" << ii << ", " << ii << ") is not contained in the sparsity pattern!");
+    clear_row(ii);
+    backend_->operator[](ii / blocksize)[ii / blocksize][ii % blocksize][ii % blocksize] = ScalarType(1);
+  } // ... unit_row(...)
+
+  void unit_col(const size_t jj)
+  {
+    if (jj >= cols())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given jj (" << jj << ") is larger than the cols of this (" << cols() << ")!");
+    if (jj >= rows())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Given jj (" << jj << ") is larger than the rows of this (" << rows() << ")!");
+    if (!backend_->exists(jj / blocksize, jj / blocksize))
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "Diagonal entry (" << jj << ", " << jj << ") is not contained in the sparsity pattern!");
+    clear_col(jj);
+    backend_->operator[](jj / blocksize)[jj / blocksize][jj % blocksize][jj % blocksize] = ScalarType(1);
+  } // ... unit_col(...)
+
+  bool valid() const
+  {
+    for (size_t ii = 0; ii < backend_->N(); ++ii) {
+      const auto& row = backend_->operator[](ii);
+      for (auto block = row.begin(); block != row.end(); ++block)
+        for (size_t rr = 0; rr < blocksize; ++rr)
+          for (size_t cc = 0; cc < blocksize; ++cc)
+            if (Common::isnan((*block)[rr][cc]) || Common::isinf((*block)[rr][cc]))
+              return false;
+    }
+    return true;
+  } // ... valid(...)
+
+  //! \note Counts all entries of the stored blocks.
+  virtual size_t non_zeros() const override final
+  {
+    return backend_->nonzeroes() * blocksize * blocksize;
+  }
+
+  virtual SparsityPatternDefault pattern(const bool prune = false,
+                                         const typename Common::FloatCmp::DefaultEpsilon< ScalarType >::Type eps
+                                            = Common::FloatCmp::DefaultEpsilon< ScalarType >::value()) const override final
+  {
+    SparsityPatternDefault ret(rows());
+    for (size_t ii = 0; ii < backend_->N(); ++ii) {
+      const auto& row = backend_->operator[](ii);
+      for (auto block = row.begin(); block != row.end(); ++block)
+        for (size_t rr = 0; rr < blocksize; ++rr)
+          for (size_t cc = 0; cc < blocksize; ++cc)
+            if (!prune
+                || Common::FloatCmp::ne< Common::FloatCmp::Style::absolute >((*block)[rr][cc], ScalarType(0), eps))
+              ret.insert(ii * blocksize + rr, block.index() * blocksize + cc);
+    }
+    ret.sort();
+    return ret;
+  } // ... pattern(...)
+
+  /// \}
+
+private:
+  template< class PatternType >
+  void build_sparse_matrix(const size_t rr, const size_t cc, const PatternType& patt)
+  {
+    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".build");
+    const size_t block_rows = internal::num_blocks< blocksize >(rr);
+    const size_t block_cols = internal::num_blocks< blocksize >(cc);
+    // each block column is inserted once per block row, the rows of patt are visited in order so it suffices to
+    // remember the last block row a block column was inserted in
+    SparsityPatternDefault block_pattern(block_rows);
+    std::vector< size_t > last_block_row(block_cols, std::numeric_limits< size_t >::max());
+    for (size_t ii = 0; ii < patt.size(); ++ii) {
+      const size_t block_row = ii / blocksize;
+      for (const auto& jj : patt.inner(ii)) {
+        if (jj >= cc)
+          DUNE_THROW(Exceptions::shapes_do_not_match,
+                     "The size of row " << ii << " of the pattern does not match the number of columns of this ("
+                     << cc << ")!");
+        const size_t block_col = jj / blocksize;
+        if (last_block_row[block_col] != block_row) {
+          last_block_row[block_col] = block_row;
+          block_pattern.inner(block_row).push_back(block_col);
+        }
+      }
+    }
+    backend_ = std::make_shared< BackendType >(block_rows, block_cols, BackendType::random);
+    for (size_t ii = 0; ii < block_rows; ++ii) {
+      auto& columns = block_pattern.inner(ii);
+      std::sort(columns.begin(), columns.end());
+      backend_->setrowsize(ii, columns.size());
+    }
+    backend_->endrowsizes();
+    for (size_t ii = 0; ii < block_rows; ++ii)
+      for (const auto& jj : block_pattern.inner(ii))
+        backend_->addindex(ii, jj);
+    backend_->endindices();
+  } // ... build_sparse_matrix(...)
+
+  bool these_are_valid_indices(const size_t ii, const size_t jj) const
+  {
+    if (ii >= rows())
+      return false;
+    if (jj >= cols())
+      return false;
+    return backend_->exists(ii / blocksize, jj / blocksize);
+  } // ... these_are_valid_indices(...)
+
+  /**
+   * \see ContainerInterface
+   */
+  inline void ensure_uniqueness() const
+  {
+    if (!backend_.unique())
+      backend_ = std::make_shared< BackendType >(*backend_);
+  } // ... ensure_uniqueness(...)
+
+  mutable std::shared_ptr< BackendType > backend_;
+}; // class IstlBlockSparseMatrix
+
+
+#else // HAVE_DUNE_ISTL
+
+
+template< class ScalarImp, size_t blocksize >
+class IstlDenseBlockVector
+{
+  static_assert(Dune::AlwaysFalse< ScalarImp >::value, "You are missing dune-istl!");
+};
+
+template< class ScalarImp, size_t blocksize >
+class IstlBlockSparseMatrix
+{
+  static_assert(Dune::AlwaysFalse< ScalarImp >::value, "You are missing dune-istl!");
+};
+
+
+#endif // HAVE_DUNE_ISTL
+
+} // namespace LA
+namespace Common {
+
+#if HAVE_DUNE_ISTL
+
+
+template< class T, size_t blocksize >
+struct VectorAbstraction< LA::IstlDenseBlockVector< T, blocksize > >
+  : public LA::internal::VectorAbstractionBase< LA::IstlDenseBlockVector< T, blocksize > >
+{};
+
+
+template< class T, size_t blocksize >
+struct MatrixAbstraction< LA::IstlBlockSparseMatrix< T, blocksize > >
+  : public LA::internal::MatrixAbstractionBase< LA::IstlBlockSparseMatrix< T, blocksize > >
+{};
+
+
+#endif // HAVE_DUNE_ISTL
+
+} // namespace Common
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_LA_CONTAINER_ISTL_BLOCK_HH
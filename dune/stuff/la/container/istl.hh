@@ -406,6 +406,17 @@ public:
     backend_->operator*=(ScalarType(0));
   } // ... IstlRowMajorSparseMatrix(...)
 
+  //! \see SparsityPatternBuilder
+  IstlRowMajorSparseMatrix(const size_t rr, const size_t cc, const SparsityPatternCSR& patt)
+  {
+    if (patt.size() != rr)
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of the pattern (" << patt.size()
+                 << ") does not match the number of rows of this (" << rr << ")!");
+    build_sparse_matrix(rr, cc, patt);
+    backend_->operator*=(ScalarType(0));
+  } // ... IstlRowMajorSparseMatrix(...)
+
   explicit IstlRowMajorSparseMatrix(const size_t rr = 0, const size_t cc = 0)
     : backend_(new BackendType(rr, cc, BackendType::row_wise))
   {}
@@ -542,6 +553,51 @@ public:
     backend()[ii][jj][0][0] += value;
   }
 
+  /**
+   * \brief Like add_to_entry(), but does not check if the backend is shared with another matrix.
+   * \note  Call backend() once before (as MatrixAccumulator does). Different entries may be added to concurrently.
+   */
+  void unchecked_add_to_entry(const size_t ii, const size_t jj, const ScalarType& value)
+  {
+    assert(these_are_valid_indices(ii, jj));
+    backend_->operator[](ii)[jj][0][0] += value;
+  }
+
+  /**
+   * \brief Finds the column positions of each row once and walks them in the order of the sorted columns.
+   * \note  Throws Exceptions::index_out_of_range if an entry is not contained in the pattern.
+   *        All entries are checked before the first one is added, so this is left unchanged if it throws.
+   */
+  virtual void add_local(const std::vector< size_t >& global_rows,
+                         const std::vector< size_t >& global_cols,
+                         const Dune::DynamicMatrix< ScalarType >& local_matrix) override final
+  {
+    assert(local_matrix.rows() >= global_rows.size());
+    assert(local_matrix.cols() >= global_cols.size());
+    if (global_cols.empty())
+      return;
+    ensure_uniqueness();
+    const auto& order = internal::sorting_permutation(global_cols);
+    // first check all entries, then add
+    for (const bool add : {false, true}) {
+      for (size_t ii = 0; ii < global_rows.size(); ++ii) {
+        assert(global_rows[ii] < rows());
+        auto& row = backend_->operator[](global_rows[ii]);
+        const auto& local_row = local_matrix[ii];
+        auto entry = row.find(global_cols[order[0]]);
+        for (const size_t jj : order) {
+          while (entry != row.end() && entry.index() < global_cols[jj])
+            ++entry;
+          if (entry == row.end() || entry.index() != global_cols[jj])
+            DUNE_THROW(Exceptions::index_out_of_range,
+                       "Entry (" << global_rows[ii] << ", " << global_cols[jj] << ") is not contained in the pattern!");
+          else if (add)
+            (*entry)[0][0] += local_row[jj];
+        }
+      }
+    }
+  } // ... add_local(...)
+
   void set_entry(const size_t ii, const size_t jj, const ScalarType& value)
   {
     assert(these_are_valid_indices(ii, jj));
@@ -668,7 +724,8 @@ public:
   /// \}
 
 private:
-  void build_sparse_matrix(const size_t rr, const size_t cc, const SparsityPatternDefault& patt)
+  template< class PatternType >
+  void build_sparse_matrix(const size_t rr, const size_t cc, const PatternType& patt)
   {
     DUNE_STUFF_PROFILE_SCOPE(static_id() + ".build");
     backend_ = std::make_shared< BackendType >(rr, cc, BackendType::random);
@@ -0,0 +1,645 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff/
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include "kernels.hh"
+
+#include <atomic>
+#include <cmath>
+
+#include <dune/stuff/common/exceptions.hh>
+
+// the vectorized kernels are compiled for their instruction set by target attributes, so no special flags are needed
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define DUNE_STUFF_LA_KERNELS_AVX2 1
+# if defined(__clang__) || __GNUC__ >= 7
+#   define DUNE_STUFF_LA_KERNELS_AVX512 1
+# else
+#   define DUNE_STUFF_LA_KERNELS_AVX512 0
+# endif
+# include <immintrin.h>
+#else
+# define DUNE_STUFF_LA_KERNELS_AVX2 0
+# define DUNE_STUFF_LA_KERNELS_AVX512 0
+#endif
+
+namespace Dune {
+namespace Stuff {
+namespace LA {
+namespace Kernels {
+namespace {
+
+
+struct Table
+{
+  double (*dot)(const size_t, const double*, const double*);
+  double (*sum_abs)(const size_t, const double*);
+  double (*sum_squares)(const size_t, const double*);
+  double (*max_abs)(const size_t, const double*);
+  // adds to the last two arguments
+  void (*dot_and_sum_squares)(const size_t, const double*, const double*, double&, double&);
+  void (*scal)(const size_t, const double, double*);
+  void (*axpby)(const size_t, const double, const double*, const double, double*);
+  void (*add)(const size_t, const double*, const double*, double*);
+  void (*sub)(const size_t, const double*, const double*, double*);
+}; // struct Table
+
+
+/// \name Scalar variants, also used for the remainders of the AVX2 variants.
+/// \{
+
+double dot_scalar(const size_t size, const double* xx, const double* yy)
+{
+  double ret = 0;
+  for (size_t ii = 0; ii < size; ++ii)
+    ret += xx[ii] * yy[ii];
+  return ret;
+}
+
+double sum_abs_scalar(const size_t size, const double* xx)
+{
+  double ret = 0;
+  for (size_t ii = 0; ii < size; ++ii)
+    ret += std::abs(xx[ii]);
+  return ret;
+}
+
+double sum_squares_scalar(const size_t size, const double* xx)
+{
+  double ret = 0;
+  for (size_t ii = 0; ii < size; ++ii)
+    ret += xx[ii] * xx[ii];
+  return ret;
+}
+
+double max_abs_scalar(const size_t size, const double* xx)
+{
+  double ret = 0;
+  for (size_t ii = 0; ii < size; ++ii) {
+    const double value = std::abs(xx[ii]);
+    if (value > ret)
+      ret = value;
+  }
+  return ret;
+} // ... max_abs_scalar(...)
+
+void dot_and_sum_squares_scalar(const size_t size, const double* xx, const double* yy, double& dot, double& squares)
+{
+  for (size_t ii = 0; ii < size; ++ii) {
+    dot += xx[ii] * yy[ii];
+    squares += xx[ii] * xx[ii];
+  }
+}
+
+void scal_scalar(const size_t size, const double alpha, double* xx)
+{
+  for (size_t ii = 0; ii < size; ++ii)
+    xx[ii] *= alpha;
+}
+
+void axpby_scalar(const size_t size, const double alpha, const double* xx, const double beta, double* yy)
+{
+  for (size_t ii = 0; ii < size; ++ii)
+    yy[ii] = alpha * xx[ii] + beta * yy[ii];
+}
+
+void add_scalar(const size_t size, const double* xx, const double* yy, double* result)
+{
+  for (size_t ii = 0; ii < size; ++ii)
+    result[ii] = xx[ii] + yy[ii];
+}
+
+void sub_scalar(const size_t size, const double* xx, const double* yy, double* result)
+{
+  for (size_t ii = 0; ii < size; ++ii)
+    result[ii] = xx[ii] - yy[ii];
+}
+
+const Table scalar_table = {&dot_scalar,
+                            &sum_abs_scalar,
+                            &sum_squares_scalar,
+                            &max_abs_scalar,
+                            &dot_and_sum_squares_scalar,
+                            &scal_scalar,
+                            &axpby_scalar,
+                            &add_scalar,
+                            &sub_scalar};
+
+/// \}
+
+#if DUNE_STUFF_LA_KERNELS_AVX2
+
+/// \name AVX2 variants, the reductions use several accumulators to hide the latency of the fma.
+/// \{
+
+#define DUNE_STUFF_LA_KERNELS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+inline double sum_avx2(const __m256d& value)
+{
+  const __m128d pairs = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+inline double max_avx2(const __m256d& value)
+{
+  const __m128d pairs = _mm_max_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+  return _mm_cvtsd_f64(_mm_max_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+inline __m256d abs_avx2(const __m256d& value)
+{
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+double dot_avx2(const size_t size, const double* xx, const double* yy)
+{
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= size; ii += 16) {
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii), acc0);
+    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii + 4), _mm256_loadu_pd(yy + ii + 4), acc1);
+    acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii + 8), _mm256_loadu_pd(yy + ii + 8), acc2);
+    acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii + 12), _mm256_loadu_pd(yy + ii + 12), acc3);
+  }
+  for (; ii + 4 <= size; ii += 4)
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii), acc0);
+  const double ret = sum_avx2(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+  return ret + dot_scalar(size - ii, xx + ii, yy + ii);
+} // ... dot_avx2(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+double sum_abs_avx2(const size_t size, const double* xx)
+{
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= size; ii += 16) {
+    acc0 = _mm256_add_pd(abs_avx2(_mm256_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm256_add_pd(abs_avx2(_mm256_loadu_pd(xx + ii + 4)), acc1);
+    acc2 = _mm256_add_pd(abs_avx2(_mm256_loadu_pd(xx + ii + 8)), acc2);
+    acc3 = _mm256_add_pd(abs_avx2(_mm256_loadu_pd(xx + ii + 12)), acc3);
+  }
+  for (; ii + 4 <= size; ii += 4)
+    acc0 = _mm256_add_pd(abs_avx2(_mm256_loadu_pd(xx + ii)), acc0);
+  const double ret = sum_avx2(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+  return ret + sum_abs_scalar(size - ii, xx + ii);
+} // ... sum_abs_avx2(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+double sum_squares_avx2(const size_t size, const double* xx)
+{
+  return dot_avx2(size, xx, xx);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+double max_abs_avx2(const size_t size, const double* xx)
+{
+  // max_pd returns its second operand if one is NaN, so NaNs never get into the accumulators
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8) {
+    acc0 = _mm256_max_pd(abs_avx2(_mm256_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm256_max_pd(abs_avx2(_mm256_loadu_pd(xx + ii + 4)), acc1);
+  }
+  for (; ii + 4 <= size; ii += 4)
+    acc0 = _mm256_max_pd(abs_avx2(_mm256_loadu_pd(xx + ii)), acc0);
+  const double ret = max_avx2(_mm256_max_pd(acc0, acc1));
+  const double rest = max_abs_scalar(size - ii, xx + ii);
+  return rest > ret ? rest : ret;
+} // ... max_abs_avx2(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+void dot_and_sum_squares_avx2(const size_t size, const double* xx, const double* yy, double& dot, double& squares)
+{
+  __m256d dot0 = _mm256_setzero_pd(), dot1 = _mm256_setzero_pd();
+  __m256d squares0 = _mm256_setzero_pd(), squares1 = _mm256_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8) {
+    const __m256d xx0 = _mm256_loadu_pd(xx + ii);
+    const __m256d xx1 = _mm256_loadu_pd(xx + ii + 4);
+    dot0 = _mm256_fmadd_pd(xx0, _mm256_loadu_pd(yy + ii), dot0);
+    dot1 = _mm256_fmadd_pd(xx1, _mm256_loadu_pd(yy + ii + 4), dot1);
+    squares0 = _mm256_fmadd_pd(xx0, xx0, squares0);
+    squares1 = _mm256_fmadd_pd(xx1, xx1, squares1);
+  }
+  for (; ii + 4 <= size; ii += 4) {
+    const __m256d xx0 = _mm256_loadu_pd(xx + ii);
+    dot0 = _mm256_fmadd_pd(xx0, _mm256_loadu_pd(yy + ii), dot0);
+    squares0 = _mm256_fmadd_pd(xx0, xx0, squares0);
+  }
+  dot += sum_avx2(_mm256_add_pd(dot0, dot1));
+  squares += sum_avx2(_mm256_add_pd(squares0, squares1));
+  dot_and_sum_squares_scalar(size - ii, xx + ii, yy + ii, dot, squares);
+} // ... dot_and_sum_squares_avx2(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+void scal_avx2(const size_t size, const double alpha, double* xx)
+{
+  const __m256d factor = _mm256_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 4 <= size; ii += 4)
+    _mm256_storeu_pd(xx + ii, _mm256_mul_pd(factor, _mm256_loadu_pd(xx + ii)));
+  scal_scalar(size - ii, alpha, xx + ii);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+void axpby_avx2(const size_t size, const double alpha, const double* xx, const double beta, double* yy)
+{
+  const __m256d alphas = _mm256_set1_pd(alpha);
+  const __m256d betas = _mm256_set1_pd(beta);
+  size_t ii = 0;
+  for (; ii + 4 <= size; ii += 4)
+    _mm256_storeu_pd(yy + ii,
+                     _mm256_fmadd_pd(alphas, _mm256_loadu_pd(xx + ii), _mm256_mul_pd(betas, _mm256_loadu_pd(yy + ii))));
+  axpby_scalar(size - ii, alpha, xx + ii, beta, yy + ii);
+} // ... axpby_avx2(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+void add_avx2(const size_t size, const double* xx, const double* yy, double* result)
+{
+  size_t ii = 0;
+  for (; ii + 4 <= size; ii += 4)
+    _mm256_storeu_pd(result + ii, _mm256_add_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii)));
+  add_scalar(size - ii, xx + ii, yy + ii, result + ii);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+void sub_avx2(const size_t size, const double* xx, const double* yy, double* result)
+{
+  size_t ii = 0;
+  for (; ii + 4 <= size; ii += 4)
+    _mm256_storeu_pd(result + ii, _mm256_sub_pd(_mm256_loadu_pd(xx + ii), _mm256_loadu_pd(yy + ii)));
+  sub_scalar(size - ii, xx + ii, yy + ii, result + ii);
+}
+
+#undef DUNE_STUFF_LA_KERNELS_TARGET_AVX2
+
+const Table avx2_table = {&dot_avx2,
+                          &sum_abs_avx2,
+                          &sum_squares_avx2,
+                          &max_abs_avx2,
+                          &dot_and_sum_squares_avx2,
+                          &scal_avx2,
+                          &axpby_avx2,
+                          &add_avx2,
+                          &sub_avx2};
+
+/// \}
+
+#endif // DUNE_STUFF_LA_KERNELS_AVX2
+#if DUNE_STUFF_LA_KERNELS_AVX512
+
+/// \name AVX-512 variants, the remainders are handled by masked loads and stores.
+/// \{
+
+#define DUNE_STUFF_LA_KERNELS_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// the avx512f intrinsics of some gcc versions initialize their undefined vectors by themselves, which is reported
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wuninitialized"
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+inline __mmask8 remainder_mask(const size_t remainder)
+{
+  return __mmask8((1u << remainder) - 1u);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+double dot_avx512(const size_t size, const double* xx, const double* yy)
+{
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 32 <= size; ii += 32) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii), acc0);
+    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii + 8), _mm512_loadu_pd(yy + ii + 8), acc1);
+    acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii + 16), _mm512_loadu_pd(yy + ii + 16), acc2);
+    acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii + 24), _mm512_loadu_pd(yy + ii + 24), acc3);
+  }
+  for (; ii + 8 <= size; ii += 8)
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii), acc0);
+  if (ii < size) {
+    const __mmask8 mask = remainder_mask(size - ii);
+    acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, xx + ii), _mm512_maskz_loadu_pd(mask, yy + ii), acc1);
+  }
+  return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+} // ... dot_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+double sum_abs_avx512(const size_t size, const double* xx)
+{
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 32 <= size; ii += 32) {
+    acc0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii + 8)), acc1);
+    acc2 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii + 16)), acc2);
+    acc3 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii + 24)), acc3);
+  }
+  for (; ii + 8 <= size; ii += 8)
+    acc0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+  if (ii < size)
+    acc1 = _mm512_add_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(remainder_mask(size - ii), xx + ii)), acc1);
+  return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+} // ... sum_abs_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+double sum_squares_avx512(const size_t size, const double* xx)
+{
+  return dot_avx512(size, xx, xx);
+}
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+double max_abs_avx512(const size_t size, const double* xx)
+{
+  // max_pd returns its second operand if one is NaN, so NaNs never get into the accumulators
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= size; ii += 16) {
+    acc0 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+    acc1 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii + 8)), acc1);
+  }
+  for (; ii + 8 <= size; ii += 8)
+    acc0 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(xx + ii)), acc0);
+  if (ii < size)
+    acc1 = _mm512_max_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(remainder_mask(size - ii), xx + ii)), acc1);
+  return _mm512_reduce_max_pd(_mm512_max_pd(acc0, acc1));
+} // ... max_abs_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+void dot_and_sum_squares_avx512(const size_t size, const double* xx, const double* yy, double& dot, double& squares)
+{
+  __m512d dot0 = _mm512_setzero_pd(), dot1 = _mm512_setzero_pd();
+  __m512d squares0 = _mm512_setzero_pd(), squares1 = _mm512_setzero_pd();
+  size_t ii = 0;
+  for (; ii + 16 <= size; ii += 16) {
+    const __m512d xx0 = _mm512_loadu_pd(xx + ii);
+    const __m512d xx1 = _mm512_loadu_pd(xx + ii + 8);
+    dot0 = _mm512_fmadd_pd(xx0, _mm512_loadu_pd(yy + ii), dot0);
+    dot1 = _mm512_fmadd_pd(xx1, _mm512_loadu_pd(yy + ii + 8), dot1);
+    squares0 = _mm512_fmadd_pd(xx0, xx0, squares0);
+    squares1 = _mm512_fmadd_pd(xx1, xx1, squares1);
+  }
+  for (; ii < size; ii += 8) {
+    const __mmask8 mask = remainder_mask(size - ii < 8 ? size - ii : 8);
+    const __m512d xx0 = _mm512_maskz_loadu_pd(mask, xx + ii);
+    dot0 = _mm512_fmadd_pd(xx0, _mm512_maskz_loadu_pd(mask, yy + ii), dot0);
+    squares0 = _mm512_fmadd_pd(xx0, xx0, squares0);
+  }
+  dot += _mm512_reduce_add_pd(_mm512_add_pd(dot0, dot1));
+  squares += _mm512_reduce_add_pd(_mm512_add_pd(squares0, squares1));
+} // ... dot_and_sum_squares_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+void scal_avx512(const size_t size, const double alpha, double* xx)
+{
+  const __m512d factor = _mm512_set1_pd(alpha);
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8)
+    _mm512_storeu_pd(xx + ii, _mm512_mul_pd(factor, _mm512_loadu_pd(xx + ii)));
+  if (ii < size) {
+    const __mmask8 mask = remainder_mask(size - ii);
+    _mm512_mask_storeu_pd(xx + ii, mask, _mm512_mul_pd(factor, _mm512_maskz_loadu_pd(mask, xx + ii)));
+  }
+} // ... scal_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+void axpby_avx512(const size_t size, const double alpha, const double* xx, const double beta, double* yy)
+{
+  const __m512d alphas = _mm512_set1_pd(alpha);
+  const __m512d betas = _mm512_set1_pd(beta);
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8)
+    _mm512_storeu_pd(yy + ii,
+                     _mm512_fmadd_pd(alphas, _mm512_loadu_pd(xx + ii), _mm512_mul_pd(betas, _mm512_loadu_pd(yy + ii))));
+  if (ii < size) {
+    const __mmask8 mask = remainder_mask(size - ii);
+    const __m512d result = _mm512_fmadd_pd(alphas,
+                                           _mm512_maskz_loadu_pd(mask, xx + ii),
+                                           _mm512_mul_pd(betas, _mm512_maskz_loadu_pd(mask, yy + ii)));
+    _mm512_mask_storeu_pd(yy + ii, mask, result);
+  }
+} // ... axpby_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+void add_avx512(const size_t size, const double* xx, const double* yy, double* result)
+{
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8)
+    _mm512_storeu_pd(result + ii, _mm512_add_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii)));
+  if (ii < size) {
+    const __mmask8 mask = remainder_mask(size - ii);
+    _mm512_mask_storeu_pd(result + ii,
+                          mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, xx + ii), _mm512_maskz_loadu_pd(mask, yy + ii)));
+  }
+} // ... add_avx512(...)
+
+DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+void sub_avx512(const size_t size, const double* xx, const double* yy, double* result)
+{
+  size_t ii = 0;
+  for (; ii + 8 <= size; ii += 8)
+    _mm512_storeu_pd(result + ii, _mm512_sub_pd(_mm512_loadu_pd(xx + ii), _mm512_loadu_pd(yy + ii)));
+  if (ii < size) {
+    const __mmask8 mask = remainder_mask(size - ii);
+    _mm512_mask_storeu_pd(result + ii,
+                          mask,
+                          _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, xx + ii), _mm512_maskz_loadu_pd(mask, yy + ii)));
+  }
+} // ... sub_avx512(...)
+
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic pop
+#endif
+#undef DUNE_STUFF_LA_KERNELS_TARGET_AVX512
+
+const Table avx512_table = {&dot_avx512,
+                            &sum_abs_avx512,
+                            &sum_squares_avx512,
+                            &max_abs_avx512,
+                            &dot_and_sum_squares_avx512,
+                            &scal_avx512,
+                            &axpby_avx512,
+                            &add_avx512,
+                            &sub_avx512};
+
+/// \}
+
+#endif // DUNE_STUFF_LA_KERNELS_AVX512
+
+
+const Table& table_for(const InstructionSet set)
+{
+  switch (set) {
+#if DUNE_STUFF_LA_KERNELS_AVX512
+    case InstructionSet::avx512:
+      return avx512_table;
+#endif
+#if DUNE_STUFF_LA_KERNELS_AVX2
+    case InstructionSet::avx2:
+      return avx2_table;
+#endif
+    default:
+      return scalar_table;
+  }
+} // ... table_for(...)
+
+std::atomic< const Table* >& current_table()
+{
+  static std::atomic< const Table* > table(&table_for(best_instruction_set()));
+  return table;
+}
+
+inline const Table& kernels()
+{
+  return *current_table().load(std::memory_order_relaxed);
+}
+
+
+} // namespace
+
+
+std::string to_string(const InstructionSet set)
+{
+  switch (set) {
+    case InstructionSet::avx512:
+      return "avx512";
+    case InstructionSet::avx2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+} // ... to_string(...)
+
+bool supports(const InstructionSet set)
+{
+  switch (set) {
+#if DUNE_STUFF_LA_KERNELS_AVX512
+    case InstructionSet::avx512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f");
+#endif
+#if DUNE_STUFF_LA_KERNELS_AVX2
+    case InstructionSet::avx2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    case InstructionSet::scalar:
+      return true;
+    default:
+      return false;
+  }
+} // ... supports(...)
+
+InstructionSet best_instruction_set()
+{
+  for (const auto set : {InstructionSet::avx512, InstructionSet::avx2})
+    if (supports(set))
+      return set;
+  return InstructionSet::scalar;
+}
+
+InstructionSet instruction_set()
+{
+  const Table* table = current_table().load(std::memory_order_relaxed);
+#if DUNE_STUFF_LA_KERNELS_AVX512
+  if (table == &avx512_table)
+    return InstructionSet::avx512;
+#endif
+#if DUNE_STUFF_LA_KERNELS_AVX2
+  if (table == &avx2_table)
+    return InstructionSet::avx2;
+#endif
+  return InstructionSet::scalar;
+} // ... instruction_set(...)
+
+void use_instruction_set(const InstructionSet set)
+{
+  if (!supports(set))
+    DUNE_THROW(Exceptions::wrong_input_given,
+               "The instruction set '" << to_string(set) << "' is not supported on this machine!");
+  current_table().store(&table_for(set), std::memory_order_relaxed);
+}
+
+double dot(const size_t size, const double* xx, const double* yy)
+{
+  return kernels().dot(size, xx, yy);
+}
+
+double l1_norm(const size_t size, const double* xx)
+{
+  return kernels().sum_abs(size, xx);
+}
+
+double l2_norm(const size_t size, const double* xx)
+{
+  return std::sqrt(kernels().sum_squares(size, xx));
+}
+
+double sup_norm(const size_t size, const double* xx)
+{
+  return kernels().max_abs(size, xx);
+}
+
+std::pair< size_t, double > amax(const size_t size, const double* xx)
+{
+  // the maximum is one of the values, so the vectorized search for it is followed by a scan for its first position
+  const double max = kernels().max_abs(size, xx);
+  if (max > 0)
+    for (size_t ii = 0; ii < size; ++ii)
+      if (std::abs(xx[ii]) == max)
+        return std::make_pair(ii, max);
+  return std::make_pair(size_t(0), 0.0);
+} // ... amax(...)
+
+std::pair< double, double > dot_and_l2_norm(const size_t size, const double* xx, const double* yy)
+{
+  double dot = 0;
+  double squares = 0;
+  kernels().dot_and_sum_squares(size, xx, yy, dot, squares);
+  return std::make_pair(dot, std::sqrt(squares));
+}
+
+void scal(const size_t size, const double alpha, double* xx)
+{
+  kernels().scal(size, alpha, xx);
+}
+
+void axpy(const size_t size, const double alpha, const double* xx, double* yy)
+{
+  kernels().axpby(size, alpha, xx, 1.0, yy);
+}
+
+void axpby(const size_t size, const double alpha, const double* xx, const double beta, double* yy)
+{
+  kernels().axpby(size, alpha, xx, beta, yy);
+}
+
+void add(const size_t size, const double* xx, const double* yy, double* result)
+{
+  kernels().add(size, xx, yy, result);
+}
+
+void sub(const size_t size, const double* xx, const double* yy, double* result)
+{
+  kernels().sub(size, xx, yy, result);
+}
+
+
+} // namespace Kernels
+} // namespace LA
+} // namespace Stuff
+} // namespace Dune
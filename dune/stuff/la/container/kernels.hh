@@ -0,0 +1,94 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff/
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_LA_CONTAINER_KERNELS_HH
+#define DUNE_STUFF_LA_CONTAINER_KERNELS_HH
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace Dune {
+namespace Stuff {
+namespace LA {
+
+/**
+ *  \brief  Vectorized BLAS-1 kernels on contiguous arrays of doubles, as used by CommonDenseVector.
+ *
+ *          Each kernel exists as an AVX-512, an AVX2 and a scalar variant. The best one supported by the cpu we are
+ *          running on is chosen at runtime (on the first call), the build does not require any special flags. The
+ *          choice may be changed by use_instruction_set(), e.g. to compare the variants.
+ *  \note   The vectorized variants sum in a different order than the scalar ones, so results of reductions may differ
+ *          in the last bits.
+ */
+namespace Kernels {
+
+
+enum class InstructionSet
+{
+  scalar,
+  avx2,
+  avx512
+}; // enum class InstructionSet
+
+std::string to_string(const InstructionSet set);
+
+//! Whether the kernels for set are compiled in and supported by this cpu.
+bool supports(const InstructionSet set);
+
+//! The best set supported by this cpu, used by default.
+InstructionSet best_instruction_set();
+
+//! The set currently in use.
+InstructionSet instruction_set();
+
+//! Switches all kernels to set (for all threads), throws Exceptions::wrong_input_given if it is not supported.
+void use_instruction_set(const InstructionSet set);
+
+/// \name BLAS-1 kernels on arrays of the given size, which may be nullptr if size is zero.
+/// \{
+
+//! \return sum_i xx[i]*yy[i]
+double dot(const size_t size, const double* xx, const double* yy);
+
+//! \return sum_i |xx[i]|
+double l1_norm(const size_t size, const double* xx);
+
+//! \return sqrt(sum_i xx[i]^2)
+double l2_norm(const size_t size, const double* xx);
+
+//! \return max_i |xx[i]|, NaNs are ignored
+double sup_norm(const size_t size, const double* xx);
+
+//! \return the lowest index at which max_i |xx[i]| is attained and this value, (0, 0) if xx is zero or empty
+std::pair< size_t, double > amax(const size_t size, const double* xx);
+
+//! \return xx*yy and the l2-norm of xx in a single sweep
+std::pair< double, double > dot_and_l2_norm(const size_t size, const double* xx, const double* yy);
+
+//! xx = alpha*xx
+void scal(const size_t size, const double alpha, double* xx);
+
+//! yy = alpha*xx + yy
+void axpy(const size_t size, const double alpha, const double* xx, double* yy);
+
+//! yy = alpha*xx + beta*yy
+void axpby(const size_t size, const double alpha, const double* xx, const double beta, double* yy);
+
+//! result = xx + yy, result may be xx or yy
+void add(const size_t size, const double* xx, const double* yy, double* result);
+
+//! result = xx - yy, result may be xx or yy
+void sub(const size_t size, const double* xx, const double* yy, double* result);
+
+/// \}
+
+
+} // namespace Kernels
+} // namespace LA
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_LA_CONTAINER_KERNELS_HH
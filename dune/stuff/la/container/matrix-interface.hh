@@ -8,11 +8,15 @@
 #ifndef DUNE_STUFF_LA_CONTAINER_MATRIX_INTERFACE_HH
 #define DUNE_STUFF_LA_CONTAINER_MATRIX_INTERFACE_HH
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <iostream>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/ftraits.hh>
 
 #include <dune/stuff/common/crtp.hh>
@@ -40,6 +44,26 @@ class MatrixInterface {};
 
 
 } // namespace Tags
+namespace internal {
+
+
+/**
+ * \brief The permutation which sorts cols.
+ * \note  The returned vector is reused by the next call from the same thread.
+ */
+inline const std::vector< size_t >& sorting_permutation(const std::vector< size_t >& cols)
+{
+  static thread_local std::vector< size_t > permutation;
+  permutation.resize(cols.size());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::sort(permutation.begin(), permutation.end(), [&](const size_t ii, const size_t jj) {
+    return cols[ii] < cols[jj];
+  });
+  return permutation;
+} // ... sorting_permutation(...)
+
+
+} // namespace internal
 
 
 template< class Traits, class ScalarImp = typename Traits::ScalarType >
@@ -126,6 +150,21 @@ public:
   /// \note Those marked with vitual should be overriden by any devired class that can do better.
   /// \{
 
+  /**
+   * \brief Adds local_matrix[ii][jj] to the entry (global_rows[ii], global_cols[jj]) for all ii, jj, e.g. to add the
+   *        local matrix of an element at once.
+   */
+  virtual void add_local(const std::vector< size_t >& global_rows,
+                         const std::vector< size_t >& global_cols,
+                         const Dune::DynamicMatrix< ScalarType >& local_matrix)
+  {
+    assert(local_matrix.rows() >= global_rows.size());
+    assert(local_matrix.cols() >= global_cols.size());
+    for (size_t ii = 0; ii < global_rows.size(); ++ii)
+      for (size_t jj = 0; jj < global_cols.size(); ++jj)
+        add_to_entry(global_rows[ii], global_cols[jj], local_matrix[ii][jj]);
+  } // ... add_local(...)
+
   template< class XX >
   typename XX::derived_type operator*(const VectorInterface< XX, ScalarType >& xx) const
   {
@@ -8,6 +8,8 @@
 #include <cassert>
 #include <algorithm>
 
+#include <dune/stuff/common/exceptions.hh>
+
 #include "pattern.hh"
 
 namespace Dune {
@@ -81,6 +83,137 @@ void SparsityPatternDefault::sort()
 }
 
 
+// ============================
+// ==== SparsityPatternCSR ====
+// ============================
+SparsityPatternCSR::SparsityPatternCSR(const size_t _size)
+  : row_offsets_(_size + 1, 0)
+{}
+
+SparsityPatternCSR::SparsityPatternCSR(std::vector< size_t >&& row_offsets, std::vector< size_t >&& column_indices)
+  : row_offsets_(std::move(row_offsets))
+  , column_indices_(std::move(column_indices))
+{
+  if (row_offsets_.empty() || row_offsets_.front() != 0 || row_offsets_.back() != column_indices_.size())
+    DUNE_THROW(Exceptions::wrong_input_given,
+               "The row offsets have to start with 0 and end with the number of column indices ("
+               << column_indices_.size() << ")!");
+  for (size_t ii = 0; ii < size(); ++ii) {
+    if (row_offsets_[ii + 1] < row_offsets_[ii])
+      DUNE_THROW(Exceptions::wrong_input_given, "The row offsets have to be increasing (row " << ii << ")!");
+    for (size_t kk = row_offsets_[ii] + 1; kk < row_offsets_[ii + 1]; ++kk)
+      if (!(column_indices_[kk - 1] < column_indices_[kk]))
+        DUNE_THROW(Exceptions::wrong_input_given,
+                   "The column indices of each row have to be sorted and unique (row " << ii << ")!");
+  }
+} // SparsityPatternCSR(...)
+
+SparsityPatternCSR::SparsityPatternCSR(const SparsityPatternDefault& other)
+  : row_offsets_(other.size() + 1, 0)
+{
+  for (size_t ii = 0; ii < other.size(); ++ii) {
+    const auto& columns = other.inner(ii);
+    const auto row_begin = column_indices_.insert(column_indices_.end(), columns.begin(), columns.end());
+    std::sort(row_begin, column_indices_.end());
+    column_indices_.erase(std::unique(row_begin, column_indices_.end()), column_indices_.end());
+    row_offsets_[ii + 1] = column_indices_.size();
+  }
+} // SparsityPatternCSR(...)
+
+size_t SparsityPatternCSR::size() const
+{
+  return row_offsets_.size() - 1;
+}
+
+size_t SparsityPatternCSR::nonzeros() const
+{
+  return column_indices_.size();
+}
+
+typename SparsityPatternCSR::InnerType SparsityPatternCSR::inner(const size_t ii) const
+{
+  assert(ii < size() && "Wrong index requested!");
+  return InnerType(column_indices_.data() + row_offsets_[ii], column_indices_.data() + row_offsets_[ii + 1]);
+}
+
+bool SparsityPatternCSR::contains(const size_t ii, const size_t jj) const
+{
+  const auto row = inner(ii);
+  return std::binary_search(row.begin(), row.end(), jj);
+}
+
+const std::vector< size_t >& SparsityPatternCSR::row_offsets() const
+{
+  return row_offsets_;
+}
+
+const std::vector< size_t >& SparsityPatternCSR::column_indices() const
+{
+  return column_indices_;
+}
+
+bool SparsityPatternCSR::operator==(const SparsityPatternCSR& other) const
+{
+  return row_offsets_ == other.row_offsets_ && column_indices_ == other.column_indices_;
+}
+
+bool SparsityPatternCSR::operator!=(const SparsityPatternCSR& other) const
+{
+  return !(*this == other);
+}
+
+
+// ================================
+// ==== SparsityPatternBuilder ====
+// ================================
+SparsityPatternBuilder::SparsityPatternBuilder(const size_t _size, const size_t num_locks)
+  : rows_(_size)
+  , locks_(std::max(size_t(1), num_locks))
+{}
+
+size_t SparsityPatternBuilder::size() const
+{
+  return rows_.size();
+}
+
+void SparsityPatternBuilder::insert(const size_t row, const size_t col)
+{
+  assert(row < size() && "Wrong index requested!");
+  std::lock_guard< std::mutex > guard(locks_[row % locks_.size()]);
+  insert_into(rows_[row], col);
+}
+
+void SparsityPatternBuilder::insert(const std::vector< size_t >& rows, const std::vector< size_t >& cols)
+{
+  for (const auto& row : rows) {
+    assert(row < size() && "Wrong index requested!");
+    std::lock_guard< std::mutex > guard(locks_[row % locks_.size()]);
+    for (const auto& col : cols)
+      insert_into(rows_[row], col);
+  }
+} // ... insert(...)
+
+SparsityPatternCSR SparsityPatternBuilder::build()
+{
+  std::vector< size_t > row_offsets(size() + 1, 0);
+  for (size_t ii = 0; ii < size(); ++ii)
+    row_offsets[ii + 1] = row_offsets[ii] + rows_[ii].size();
+  std::vector< size_t > column_indices;
+  column_indices.reserve(row_offsets.back());
+  for (auto& row : rows_) {
+    column_indices.insert(column_indices.end(), row.begin(), row.end());
+    std::vector< size_t >().swap(row);
+  }
+  return SparsityPatternCSR(std::move(row_offsets), std::move(column_indices));
+} // ... build(...)
+
+void SparsityPatternBuilder::insert_into(std::vector< size_t >& row, const size_t col)
+{
+  const auto position = std::lower_bound(row.begin(), row.end(), col);
+  if (position == row.end() || *position != col)
+    row.insert(position, col);
+}
+
 } // namespace LA
 } // namespace Stuff
 } // namespace Dune
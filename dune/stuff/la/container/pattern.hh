@@ -7,9 +7,13 @@
 #define DUNE_STUFF_LA_CONTAINER_PATTERN_HH
 
 #include <cstddef>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <set>
 
+#include <boost/range/iterator_range.hpp>
+
 namespace Dune {
 namespace Stuff {
 namespace LA {
@@ -51,6 +55,85 @@ private:
 }; // class SparsityPatternDefault
 
 
+/**
+ * \brief Sparsity pattern in compressed row storage.
+ *
+ *        The column indices of row ii are column_indices()[row_offsets()[ii]], ...,
+ *        column_indices()[row_offsets()[ii + 1] - 1], sorted and unique. Use SparsityPatternBuilder to create one (in
+ *        parallel).
+ * \note  No backend uses the arrays as is. EigenRowMajorSparseMatrix fills its index arrays directly from them in
+ *        one pass (converting them to the index type of Eigen), the ISTL matrices still insert each entry (or block)
+ *        via addindex().
+ */
+class SparsityPatternCSR
+{
+public:
+  typedef boost::iterator_range< const size_t* > InnerType;
+
+  //! a pattern with _size empty rows
+  explicit SparsityPatternCSR(const size_t _size = 0);
+
+  //! \throws Exceptions::wrong_input_given if the arrays do not form a valid pattern
+  SparsityPatternCSR(std::vector< size_t >&& row_offsets, std::vector< size_t >&& column_indices);
+
+  //! the rows of other do not need to be sorted, duplicate entries are removed
+  explicit SparsityPatternCSR(const SparsityPatternDefault& other);
+
+  size_t size() const;
+
+  size_t nonzeros() const;
+
+  InnerType inner(const size_t ii) const;
+
+  bool contains(const size_t ii, const size_t jj) const;
+
+  const std::vector< size_t >& row_offsets() const;
+
+  const std::vector< size_t >& column_indices() const;
+
+  bool operator==(const SparsityPatternCSR& other) const;
+
+  bool operator!=(const SparsityPatternCSR& other) const;
+
+private:
+  std::vector< size_t > row_offsets_;
+  std::vector< size_t > column_indices_;
+}; // class SparsityPatternCSR
+
+
+/**
+ * \brief Collects the entries of a SparsityPatternCSR, possibly from several threads at once.
+ *
+ *        Each row is kept sorted and without duplicates while inserting, so repeated insertions of the same entry (as
+ *        in an assembly over elements) do not take up memory and the rows take no more memory than the ones of a
+ *        SparsityPatternDefault. Insertions into the same row are serialized by one of num_locks locks (row ii is
+ *        guarded by lock ii % num_locks, as in MatrixAccumulator), insertions into different rows mostly run in
+ *        parallel. build() allocates the arrays of the SparsityPatternCSR with their exact sizes and moves the rows
+ *        over one by one, freeing each row once it is copied.
+ */
+class SparsityPatternBuilder
+{
+public:
+  explicit SparsityPatternBuilder(const size_t _size, const size_t num_locks = 1024);
+
+  size_t size() const;
+
+  void insert(const size_t row, const size_t col);
+
+  //! inserts all pairs of rows and cols, e.g. the global indices of the test and ansatz functions of an element
+  void insert(const std::vector< size_t >& rows, const std::vector< size_t >& cols);
+
+  //! Moves all rows into a SparsityPatternCSR, the builder is empty afterwards.
+  SparsityPatternCSR build();
+
+private:
+  static void insert_into(std::vector< size_t >& row, const size_t col);
+
+  std::vector< std::vector< size_t > > rows_;
+  std::vector< std::mutex > locks_;
+}; // class SparsityPatternBuilder
+
+
 } // namespace LA
 } // namespace Stuff
 } // namespace Dune
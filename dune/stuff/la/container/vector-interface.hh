@@ -272,6 +272,29 @@ public:
     return amax().second;
   }
 
+  /**
+   *  \brief  The scalar product with other and the l2-norm of the vector, as needed in orthogonalization loops.
+   *  \return A pair of dot(other) and l2_norm().
+   *  \note   If you override this method please use exceptions instead of assertions (for the python bindings).
+   */
+  virtual std::pair< ScalarType, RealType > dot_and_l2_norm(const derived_type& other) const
+  {
+    return std::make_pair(dot(other), l2_norm());
+  }
+
+  /**
+   *  \brief  BLAS AXPBY operation, this = alpha*xx + beta*this.
+   *  \note   If you override this method please use exceptions instead of assertions (for the python bindings).
+   */
+  virtual void axpby(const ScalarType& alpha, const derived_type& xx, const ScalarType& beta)
+  {
+    if (xx.size() != size())
+      DUNE_THROW(Exceptions::shapes_do_not_match,
+                 "The size of xx (" << xx.size() << ") does not match the size of this (" << size() << ")!");
+    this->as_imp().scal(beta);
+    this->as_imp().axpy(alpha, xx);
+  } // ... axpby(...)
+
   virtual ScalarType standard_deviation() const
   {
     const ScalarType mu = mean();
@@ -21,6 +21,7 @@
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/memory.hh>
 #include <dune/stuff/la/container/istl.hh>
+#include <dune/stuff/la/container/istl-block.hh>
 #include <dune/stuff/la/solver/istl_amg.hh>
 
 #include <dune/common/version.hh>
@@ -36,10 +37,13 @@ namespace LA {
 /**
  * \not
  **/
-template <class S, class CommunicatorType >
+template <class S,
+          class CommunicatorType,
+          class MatrixImp = IstlRowMajorSparseMatrix< S >,
+          class VectorImp = IstlDenseVector< S > >
 struct IstlSolverTraits {
-  typedef typename IstlDenseVector< S >::BackendType IstlVectorType;
-  typedef typename IstlRowMajorSparseMatrix< S >::BackendType IstlMatrixType;
+  typedef typename VectorImp::BackendType IstlVectorType;
+  typedef typename MatrixImp::BackendType IstlMatrixType;
   typedef OverlappingSchwarzOperator< IstlMatrixType,
                          IstlVectorType, IstlVectorType, CommunicatorType > MatrixOperatorType;
   typedef OverlappingSchwarzScalarProduct< IstlVectorType, CommunicatorType > ScalarproductType;
@@ -59,10 +63,10 @@ struct IstlSolverTraits {
   }
 };
 
-template <class S >
-struct IstlSolverTraits<S, SequentialCommunication> {
-  typedef typename IstlDenseVector< S >::BackendType IstlVectorType;
-  typedef typename IstlRowMajorSparseMatrix< S >::BackendType IstlMatrixType;
+template <class S, class MatrixImp, class VectorImp >
+struct IstlSolverTraits<S, SequentialCommunication, MatrixImp, VectorImp> {
+  typedef typename VectorImp::BackendType IstlVectorType;
+  typedef typename MatrixImp::BackendType IstlMatrixType;
   typedef MatrixAdapter< IstlMatrixType,
                          IstlVectorType, IstlVectorType> MatrixOperatorType;
   typedef SeqScalarProduct< IstlVectorType > ScalarproductType;
@@ -83,25 +87,32 @@ struct IstlSolverTraits<S, SequentialCommunication> {
 };
 
 
-template< class S, class CommunicatorType >
-class Solver< IstlRowMajorSparseMatrix< S >, CommunicatorType >
+namespace internal {
+
+
+/**
+ * \brief The dune-istl solvers, for IstlRowMajorSparseMatrix and IstlBlockSparseMatrix.
+ */
+template< class MatrixImp, class VectorImp, class CommunicatorType >
+class IstlSolver
   : protected SolverUtils
 {
+  typedef typename MatrixImp::ScalarType S;
 public:
-  typedef IstlRowMajorSparseMatrix< S > MatrixType;
+  typedef MatrixImp                     MatrixType;
   typedef typename MatrixType::RealType R;
 
 #if !DUNE_VERSION_NEWER(DUNE_ISTL, 2, 4)
   static_assert(!std::is_same< S, std::complex< R > >::value, "the dune-istl solver does not work with complex yet!");
 #endif
 
-  Solver(const MatrixType& matrix)
+  IstlSolver(const MatrixType& matrix)
     : matrix_(matrix)
     , communicator_(new CommunicatorType())
   {}
 
-  Solver(const MatrixType& matrix,
-         const CommunicatorType& communicator)
+  IstlSolver(const MatrixType& matrix,
+             const CommunicatorType& communicator)
     : matrix_(matrix)
     , communicator_(communicator)
   {}
@@ -163,12 +174,12 @@ public:
     return Common::Configuration();
   } // ... options(...)
 
-  void apply(const IstlDenseVector< S >& rhs, IstlDenseVector< S >& solution) const
+  void apply(const VectorImp& rhs, VectorImp& solution) const
   {
     apply(rhs, solution, types()[0]);
   }
 
-  void apply(const IstlDenseVector< S >& rhs, IstlDenseVector< S >& solution, const std::string& type) const
+  void apply(const VectorImp& rhs, VectorImp& solution, const std::string& type) const
   {
     apply(rhs, solution, options(type));
   }
@@ -186,9 +197,9 @@ public:
   /**
    *  \note does a copy of the rhs
    */
-  void apply(const IstlDenseVector< S >& rhs, IstlDenseVector< S >& solution, const Common::Configuration& opts) const
+  void apply(const VectorImp& rhs, VectorImp& solution, const Common::Configuration& opts) const
   {
-    typedef IstlSolverTraits<S,CommunicatorType> Traits;
+    typedef IstlSolverTraits< S, CommunicatorType, MatrixImp, VectorImp > Traits;
     typedef typename Traits::IstlVectorType IstlVectorType;
     typedef typename Traits::MatrixOperatorType MatrixOperatorType;
     typedef BiCGSTABSolver< IstlVectorType > BiCgSolverType;
@@ -202,14 +213,15 @@ public:
       const auto type = opts.get< std::string >("type");
       SolverUtils::check_given(type, types());
       const Common::Configuration default_opts = options(type);
-      IstlDenseVector< S > writable_rhs = rhs.copy();
+      VectorImp writable_rhs = rhs.copy();
 
       if (type.substr(0, 13) == "bicgstab.amg.") {
-        solver_result = AmgApplicator< S, CommunicatorType >(matrix_, communicator_.storage_access()).call(writable_rhs,
-                                                                                                         solution,
-                                                                                                         opts,
-                                                                                                         default_opts,
-                                                                                                         type.substr(13));
+        typedef AmgApplicator< S, CommunicatorType, MatrixImp, VectorImp > AmgApplicatorType;
+        solver_result = AmgApplicatorType(matrix_, communicator_.storage_access()).call(writable_rhs,
+                                                                                        solution,
+                                                                                        opts,
+                                                                                        default_opts,
+                                                                                        type.substr(13));
       } else if (type == "bicgstab.ilut") {
         auto matrix_operator = Traits::make_operator(matrix_.backend(), communicator_.storage_access());
         typedef SeqILUn< typename MatrixType::BackendType,
@@ -306,6 +318,49 @@ public:
 private:
   const MatrixType& matrix_;
   const Common::ConstStorageProvider< CommunicatorType > communicator_;
+}; // class IstlSolver
+
+
+} // namespace internal
+
+
+template< class S, class CommunicatorType >
+class Solver< IstlRowMajorSparseMatrix< S >, CommunicatorType >
+  : public internal::IstlSolver< IstlRowMajorSparseMatrix< S >, IstlDenseVector< S >, CommunicatorType >
+{
+  typedef internal::IstlSolver< IstlRowMajorSparseMatrix< S >, IstlDenseVector< S >, CommunicatorType > BaseType;
+public:
+  using typename BaseType::MatrixType;
+
+  Solver(const MatrixType& matrix)
+    : BaseType(matrix)
+  {}
+
+  Solver(const MatrixType& matrix, const CommunicatorType& communicator)
+    : BaseType(matrix, communicator)
+  {}
+}; // class Solver
+
+
+template< class S, size_t blocksize, class CommunicatorType >
+class Solver< IstlBlockSparseMatrix< S, blocksize >, CommunicatorType >
+  : public internal::IstlSolver< IstlBlockSparseMatrix< S, blocksize >,
+                                 IstlDenseBlockVector< S, blocksize >,
+                                 CommunicatorType >
+{
+  typedef internal::IstlSolver< IstlBlockSparseMatrix< S, blocksize >,
+                                IstlDenseBlockVector< S, blocksize >,
+                                CommunicatorType > BaseType;
+public:
+  using typename BaseType::MatrixType;
+
+  Solver(const MatrixType& matrix)
+    : BaseType(matrix)
+  {}
+
+  Solver(const MatrixType& matrix, const CommunicatorType& communicator)
+    : BaseType(matrix, communicator)
+  {}
 }; // class Solver
 
 
@@ -318,6 +373,12 @@ class Solver< IstlRowMajorSparseMatrix< S >, CommunicatorType >
   static_assert(Dune::AlwaysFalse< S >::value, "You are missing dune-istl!");
 };
 
+template< class S, size_t blocksize, class CommunicatorType >
+class Solver< IstlBlockSparseMatrix< S, blocksize >, CommunicatorType >
+{
+  static_assert(Dune::AlwaysFalse< S >::value, "You are missing dune-istl!");
+};
+
 
 #endif // HAVE_DUNE_ISTL
 
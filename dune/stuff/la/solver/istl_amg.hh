@@ -61,14 +61,34 @@ public:
 
 };
 
+namespace internal {
+
+
+//! the norm of the matrix blocks used for the coarsening: the entry itself for scalar, the Frobenius norm for blocks
+template< class IstlMatrixType >
+struct AmgNorm
+{
+  typedef typename std::conditional< IstlMatrixType::block_type::rows == 1,
+                                     Amg::FirstDiagonal,
+                                     Amg::FrobeniusNorm >::type type;
+}; // struct AmgNorm
+
+
+} // namespace internal
+
+
 //! the general, parallel case
-template< class S, class CommunicatorType >
+template< class S,
+          class CommunicatorType,
+          class MatrixImp = IstlRowMajorSparseMatrix< S >,
+          class VectorImp = IstlDenseVector< S > >
 class AmgApplicator
 {
-  typedef IstlRowMajorSparseMatrix< S >              MatrixType;
-  typedef typename MatrixType::RealType              R;
-  typedef typename MatrixType::BackendType           IstlMatrixType;
-  typedef typename IstlDenseVector< S >::BackendType IstlVectorType;
+  typedef MatrixImp                                          MatrixType;
+  typedef typename MatrixType::RealType                      R;
+  typedef typename MatrixType::BackendType                   IstlMatrixType;
+  typedef typename VectorImp::BackendType                    IstlVectorType;
+  typedef typename internal::AmgNorm< IstlMatrixType >::type NormType;
 
 public:
   AmgApplicator(const MatrixType& matrix,
@@ -77,8 +97,8 @@ public:
     , communicator_(comm)
   {}
 
-  InverseOperatorResult call(IstlDenseVector< S >& rhs,
-                             IstlDenseVector< S >& solution,
+  InverseOperatorResult call(VectorImp& rhs,
+                             VectorImp& solution,
                              const Common::Configuration& opts,
                              const Common::Configuration& default_opts,
                              const std::string& smoother_type)
@@ -128,8 +148,7 @@ public:
                                                         default_opts.get< size_t >("preconditioner.anisotropy_dim")));
     amg_parameters.setDebugLevel(opts.get("preconditioner.verbose",
                                           default_opts.get< int >("preconditioner.verbose")));
-    Amg::CoarsenCriterion< Amg::UnSymmetricCriterion< IstlMatrixType, Amg::FirstDiagonal > >
-        amg_criterion(amg_parameters);
+    Amg::CoarsenCriterion< Amg::UnSymmetricCriterion< IstlMatrixType, NormType > > amg_criterion(amg_parameters);
     if (smoother_type == "ilu0") {
       typedef Amg::AMG< MatrixOperatorType, IstlVectorType, SmootherType_ILU, CommunicatorType > PreconditionerType_ILU;
       PreconditionerType_ILU preconditioner(matrix_operator, amg_criterion, smoother_parameters_ILU, communicator_);
@@ -184,13 +203,14 @@ protected:
 
 
 //! specialization for our faux type \ref SequentialCommunication
-template< class S >
-class AmgApplicator< S, SequentialCommunication >
+template< class S, class MatrixImp, class VectorImp >
+class AmgApplicator< S, SequentialCommunication, MatrixImp, VectorImp >
 {
-  typedef IstlRowMajorSparseMatrix< S >              MatrixType;
-  typedef typename MatrixType::RealType              R;
-  typedef typename MatrixType::BackendType           IstlMatrixType;
-  typedef typename IstlDenseVector< S >::BackendType IstlVectorType;
+  typedef MatrixImp                                          MatrixType;
+  typedef typename MatrixType::RealType                      R;
+  typedef typename MatrixType::BackendType                   IstlMatrixType;
+  typedef typename VectorImp::BackendType                    IstlVectorType;
+  typedef typename internal::AmgNorm< IstlMatrixType >::type NormType;
 
 public:
   AmgApplicator(const MatrixType& matrix, const SequentialCommunication& comm)
@@ -198,8 +218,8 @@ public:
     , communicator_(comm)
   {}
 
-  InverseOperatorResult call(IstlDenseVector< S >& rhs,
-                             IstlDenseVector< S >& solution,
+  InverseOperatorResult call(VectorImp& rhs,
+                             VectorImp& solution,
                              const Common::Configuration& opts,
                              const Common::Configuration& default_opts,
                              const std::string& smoother_type)
@@ -208,7 +228,7 @@ public:
     MatrixOperatorType matrix_operator(matrix_.backend());
 
     // define the scalar product
-    Dune::SeqScalarProduct< typename IstlDenseVector< S >::BackendType > scalar_product;
+    Dune::SeqScalarProduct< IstlVectorType > scalar_product;
 
     // define the AMG as the preconditioner for the BiCGStab solver
     Amg::Parameters amg_parameters(opts.get("preconditioner.max_level",
@@ -225,8 +245,7 @@ public:
                                                         default_opts.get< size_t >("preconditioner.anisotropy_dim")));
     amg_parameters.setDebugLevel(opts.get("preconditioner.verbose",
                                           default_opts.get< int >("preconditioner.verbose")));
-    Amg::CoarsenCriterion< Amg::UnSymmetricCriterion< IstlMatrixType, Amg::FirstDiagonal > >
-        amg_criterion(amg_parameters);
+    Amg::CoarsenCriterion< Amg::UnSymmetricCriterion< IstlMatrixType, NormType > > amg_criterion(amg_parameters);
 
     InverseOperatorResult stats;
     if (smoother_type == "ilu0") {
@@ -279,7 +298,7 @@ protected:
 #else //HAVE_DUNE_ISTL
 
 
-template< class S, class T >
+template< class S, class T, class MatrixImp = void, class VectorImp = void >
 class AmgApplicator
 {
   static_assert(Dune::AlwaysFalse< S >::value, "You are missing dune-istl!");
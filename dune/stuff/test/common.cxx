@@ -15,6 +15,7 @@
 #include <dune/stuff/test/gtest/gtest.h>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/parallel/threadmanager.hh>
 
 #include "common.hh"
 
@@ -137,6 +138,20 @@ unsigned int grid_elements()
 } // ... grid_elements(...)
 
 
+ScopedThreads::ScopedThreads(const size_t count)
+  : previous_(threadManager().max_threads())
+{
+  DSC_CONFIG.set("threading.max_count", count, true);
+  threadManager().set_max_threads(count);
+}
+
+ScopedThreads::~ScopedThreads()
+{
+  DSC_CONFIG.set("threading.max_count", previous_, true);
+  threadManager().set_max_threads(previous_);
+}
+
+
 } // namespace Test
 } // namespace Stuff
 } // namespace Dune
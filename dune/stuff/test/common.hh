@@ -88,6 +88,24 @@ void print_collected_eoc_study_results(const std::map< std::string, std::vector<
 unsigned int grid_elements();
 
 
+/**
+ * \brief Sets the number of threads of threadManager() (and "threading.max_count") for its lifetime.
+ *
+ *        The test binaries use a single thread unless configured otherwise, use this to run the threaded code paths
+ *        with several workers nonetheless.
+ */
+class ScopedThreads
+{
+public:
+  explicit ScopedThreads(const size_t count);
+
+  ~ScopedThreads();
+
+private:
+  const size_t previous_;
+}; // class ScopedThreads
+
+
 } // namespace Test
 } // namespace Stuff
 } // namespace Dune
@@ -0,0 +1,87 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/stuff/common/mapped_data.hh>
+
+using namespace Dune::Stuff::Common;
+
+
+TEST(MappedDataFile, creates_and_maps_cache)
+{
+  const std::string filename = "mapped_data_test.dat";
+  std::remove((filename + ".bin").c_str());
+  {
+    std::ofstream datafile(filename);
+    for (size_t ii = 0; ii < 100; ++ii)
+      datafile << 0.5*ii - 3.0 << ((ii % 7) ? " " : "\n");
+  }
+  {
+    const MappedDataFile data(filename);
+    EXPECT_TRUE(data.mapped());
+    ASSERT_EQ(size_t(100), data.size());
+    EXPECT_EQ(-1.5, data[3]);
+    EXPECT_EQ(-3.0, data.min());
+    EXPECT_EQ(46.5, data.max());
+  }
+  // the ascii file is not needed anymore
+  std::remove(filename.c_str());
+  {
+    const MappedDataFile data(filename);
+    EXPECT_TRUE(data.mapped());
+    ASSERT_EQ(size_t(100), data.size());
+    EXPECT_EQ(46.5, data[99]);
+  }
+  std::remove((filename + ".bin").c_str());
+  EXPECT_THROW(MappedDataFile data(filename), Dune::IOError);
+} // TEST(MappedDataFile, creates_and_maps_cache)
+
+TEST(MappedDataFile, rejects_corrupt_cache)
+{
+  const std::string filename = "mapped_data_corrupt.dat";
+  {
+    std::ofstream datafile(filename);
+    datafile << "1 2 3 4";
+  }
+  {
+    const MappedDataFile data(filename);
+    EXPECT_TRUE(data.mapped());
+  }
+  {
+    // overwrite the maximal value in the header
+    std::fstream cache(filename + ".bin", std::ios::in | std::ios::out | std::ios::binary);
+    const double wrong = 17.0;
+    cache.seekp(6*sizeof(double));
+    cache.write(reinterpret_cast< const char* >(&wrong), sizeof(wrong));
+  }
+  {
+    const MappedDataFile data(filename);
+    ASSERT_EQ(size_t(4), data.size());
+    EXPECT_EQ(2.0, data[1]);
+    EXPECT_EQ(4.0, data.max());
+  }
+  std::remove(filename.c_str());
+  std::remove((filename + ".bin").c_str());
+} // TEST(MappedDataFile, rejects_corrupt_cache)
+
+TEST(MappedDataFile, rejects_empty_file)
+{
+  const std::string filename = "mapped_data_empty.dat";
+  std::remove((filename + ".bin").c_str());
+  {
+    std::ofstream datafile(filename);
+    datafile << "\n";
+  }
+  EXPECT_THROW(MappedDataFile data(filename), Dune::IOError);
+  std::remove(filename.c_str());
+  std::remove((filename + ".bin").c_str());
+} // TEST(MappedDataFile, rejects_empty_file)
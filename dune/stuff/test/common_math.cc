@@ -67,6 +67,12 @@ TYPED_TEST(MinMaxAvgTest, All){
   mmCheck<MinMaxAvg<TypeParam>, TypeParam>(mma);
   auto mmb = mma;
   mmCheck<MinMaxAvg<TypeParam>, TypeParam>(mmb);
+  MinMaxAvg<TypeParam> lower, upper;
+  lower(-4);lower(0);
+  upper(-1);upper(1);
+  lower.join(upper);
+  EXPECT_EQ(lower.count(), 4u);
+  mmCheck<MinMaxAvg<TypeParam>, TypeParam>(lower);
 }
 
 TEST(OtherMath, Range) {
@@ -10,7 +10,10 @@
 #include <array>
 #include <initializer_list>
 #include <vector>
+#include <atomic>
+#include <thread>
 #include <dune/stuff/common/parallel/threadmanager.hh>
+#include <dune/stuff/common/parallel/threadpool.hh>
 #include <dune/stuff/common/parallel/threadstorage.hh>
 #include <dune/stuff/common/parallel/helper.hh>
 
@@ -81,3 +84,61 @@ TYPED_TEST(ThreadValueTest, All) {
 TEST(ThreadManagerTBB, All) {
 
 }
+
+TEST(WorkStealingPool, ParallelFor) {
+  for (size_t threads : {1, 2, 4}) {
+    WorkStealingPool pool(threads);
+    EXPECT_EQ(pool.size(), threads);
+    std::vector<std::atomic<size_t>> hits(1000);
+    for (auto& hit : hits)
+      hit = 0;
+    std::atomic<size_t> max_worker(0);
+    pool.parallel_for(0, hits.size(), 4 * threads, [&](size_t first, size_t last) {
+      size_t worker = WorkStealingPool::current_worker();
+      size_t current = max_worker;
+      while (worker > current && !max_worker.compare_exchange_weak(current, worker)) {}
+      for (size_t ii = first; ii < last; ++ii)
+        ++hits[ii];
+    });
+    for (const auto& hit : hits)
+      EXPECT_EQ(hit, 1u);
+    EXPECT_LT(max_worker, threads);
+    EXPECT_THROW(pool.parallel_for(0, 10, 10, [](size_t first, size_t) {
+                   if (first == 3)
+                     DUNE_THROW(Dune::InvalidStateException, "");
+                 }),
+                 Dune::InvalidStateException);
+  }
+}
+
+TEST(WorkStealingPool, ConcurrentRuns) {
+  WorkStealingPool pool(4);
+  std::atomic<size_t> count(0);
+  std::vector<std::thread> callers;
+  for (size_t tt = 0; tt < 4; ++tt)
+    callers.emplace_back([&]() {
+      for (size_t rr = 0; rr < 10; ++rr)
+        pool.parallel_for(0, 1000, 16, [&](size_t first, size_t last) { count += last - first; });
+    });
+  for (auto& caller : callers)
+    caller.join();
+  EXPECT_EQ(40000u, count.load());
+}
+
+TEST(ThreadManager, PoolOutlivesResize) {
+  auto& manager = threadManager();
+  const size_t threads = manager.max_threads();
+  FallbackPerThreadValue<size_t> counts(size_t(0));
+  const auto pool = manager.pool();
+  manager.set_max_threads(threads + 2);
+  const auto larger_pool = manager.pool();
+#if !HAVE_TBB // with tbb the thread count is given by the configuration
+  EXPECT_EQ(threads + 2, larger_pool->size());
+  EXPECT_EQ(threads, pool->size());
+#endif
+  // the previous pool is still alive and usable
+  for (const auto& current : {pool, larger_pool})
+    current->parallel_for(0, 1000, 4 * current->size(), [&](size_t first, size_t last) { *counts += last - first; });
+  EXPECT_EQ(2000u, counts.sum());
+  manager.set_max_threads(threads);
+}
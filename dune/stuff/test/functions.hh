@@ -65,8 +65,15 @@ protected:
   void dynamic_interface_check(const FunctionImp& func, GridType& grid) const
   {
 #if HAVE_DUNE_GRID
-    for (const auto& entity : Common::entityRange(grid.leafGridView()))
+    std::unique_ptr< LocalfunctionType > reused_local_func;
+    for (const auto& entity : Common::entityRange(grid.leafGridView())) {
       std::unique_ptr< LocalfunctionType > local_func = func.local_function(entity);
+      // a reused local function has to behave like a new one
+      func.reuse_local_function(entity, reused_local_func);
+      const auto xx = entity.geometry().local(entity.geometry().center());
+      EXPECT_EQ(local_func->order(), reused_local_func->order());
+      EXPECT_EQ(local_func->evaluate(xx), reused_local_func->evaluate(xx));
+    }
 #endif
     std::string tp = func.type();
     std::string nm = func.name();
@@ -86,6 +86,9 @@ TYPED_TEST(CheckerboardFunctionSGridEntityTest, provides_required_methods) {
 
 # include <dune/grid/yaspgrid.hh>
 
+# include <dune/stuff/common/ranges.hh>
+# include <dune/stuff/grid/provider/cube.hh>
+
 typedef Dune::YaspGrid< 1 >::Codim< 0 >::Entity DuneYaspGrid1dEntityType;
 typedef Dune::YaspGrid< 2 >::Codim< 0 >::Entity DuneYaspGrid2dEntityType;
 typedef Dune::YaspGrid< 3 >::Codim< 0 >::Entity DuneYaspGrid3dEntityType;
@@ -125,6 +128,46 @@ TYPED_TEST(CheckerboardFunctionYaspGridEntityTest, provides_required_methods) {
   this->check();
 }
 
+TEST(CheckerboardFunction, precomputed_subdomains) {
+  typedef Dune::YaspGrid< 2 > GridType;
+  typedef Dune::Stuff::Functions::Checkerboard< DuneYaspGrid2dEntityType, double, 2, double, 1, 1 > FunctionType;
+  const auto grid = Dune::Stuff::Grid::Providers::Cube< GridType >(0.0, 1.0, 8).grid_ptr();
+  const auto grid_view = grid->leafGridView();
+  const auto function = FunctionType::create(FunctionType::default_config());
+  std::vector< double > expected;
+  for (const auto& entity : Dune::Stuff::Common::entityRange(grid_view)) {
+    const auto center = entity.geometry().local(entity.geometry().center());
+    expected.push_back(function->local_function(entity)->evaluate(center)[0]);
+  }
+  function->precompute(grid_view);
+  std::unique_ptr< FunctionType::LocalfunctionType > local_function;
+  size_t ii = 0;
+  for (const auto& entity : Dune::Stuff::Common::entityRange(grid_view)) {
+    const auto center = entity.geometry().local(entity.geometry().center());
+    EXPECT_EQ(expected[ii], function->local_function(entity)->evaluate(center)[0]);
+    function->reuse_local_function(entity, local_function);
+    EXPECT_EQ(expected[ii], local_function->evaluate(center)[0]);
+    ++ii;
+  }
+} // TEST(CheckerboardFunction, precomputed_subdomains)
+
+TEST(CheckerboardFunction, precomputed_subdomains_after_refinement) {
+  typedef Dune::YaspGrid< 2 > GridType;
+  typedef Dune::Stuff::Functions::Checkerboard< DuneYaspGrid2dEntityType, double, 2, double, 1, 1 > FunctionType;
+  const auto grid = Dune::Stuff::Grid::Providers::Cube< GridType >(0.0, 1.0, 4).grid_ptr();
+  const auto reference = FunctionType::create(FunctionType::default_config());
+  const auto function = FunctionType::create(FunctionType::default_config());
+  function->precompute(grid->leafGridView());
+  // all leaf elements (also those with an index within the stored ones) are new, none may get a stale subdomain
+  grid->globalRefine(1);
+  const auto leaf_view = grid->leafGridView();
+  for (const auto& entity : Dune::Stuff::Common::entityRange(leaf_view)) {
+    const auto center = entity.geometry().local(entity.geometry().center());
+    EXPECT_EQ(reference->local_function(entity)->evaluate(center)[0],
+              function->local_function(entity)->evaluate(center)[0]);
+  }
+} // TEST(CheckerboardFunction, precomputed_subdomains_after_refinement)
+
 # if HAVE_ALUGRID
 #   include <dune/grid/alugrid.hh>
 
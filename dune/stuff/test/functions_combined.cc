@@ -6,6 +6,7 @@
 #include "main.hxx"
 
 #include <memory>
+#include <vector>
 
 #include <boost/numeric/conversion/cast.hpp>
 
@@ -97,6 +98,50 @@ TYPED_TEST(DifferenceFunctionTest, evaluate_check) {
   }
 } // DifferenceFunctionTest, evaluate_check
 
+TYPED_TEST(DifferenceFunctionTest, batch_evaluate_check) {
+  auto grid_ptr = this->create_grid();
+  auto func = this->create(1.0, 2.0);
+  typedef typename TestFixture::FunctionType::LocalfunctionType::RangeType RangeType;
+  std::vector< RangeType > values;
+  for (const auto& entity : Stuff::Common::entityRange(grid_ptr->leafGridView())) {
+    const auto local_func = func->local_function(entity);
+    const auto& quadrature
+        = QuadratureRules< double, TypeParam::value >::rule(entity.type(),
+                                                            boost::numeric_cast< int >(local_func->order() + 2));
+    values.assign(quadrature.size(), RangeType(0));
+    local_func->evaluate(quadrature, values);
+    for (const auto& value : values)
+      EXPECT_EQ(value[0], -1.0);
+  }
+} // DifferenceFunctionTest, batch_evaluate_check
+
+TYPED_TEST(DifferenceFunctionTest, fused_evaluate_check) {
+  typedef typename DifferenceFunctionType< typename TestFixture::GridType >::ConstantFunctionType ConstantFunctionType;
+  typedef Functions::Product< ConstantFunctionType, ConstantFunctionType > ProductType;
+  typedef Functions::Sum< typename TestFixture::FunctionType, ProductType > SumType;
+  typedef typename TestFixture::FunctionType::LocalfunctionType::RangeType RangeType;
+  auto grid_ptr = this->create_grid();
+  const auto difference = this->create(1.0, 2.0);
+  const ConstantFunctionType two(2.0);
+  const ConstantFunctionType three(3.0);
+  const ProductType product(two, three);
+  // (1 - 2) + 2*3, the local functions of difference and product are fused into the one of sum
+  const SumType sum(*difference, product);
+  std::unique_ptr< typename SumType::LocalfunctionType > local_func;
+  std::vector< RangeType > values;
+  for (const auto& entity : Stuff::Common::entityRange(grid_ptr->leafGridView())) {
+    sum.reuse_local_function(entity, local_func);
+    EXPECT_EQ(local_func->order(), size_t(0));
+    const auto& quadrature = QuadratureRules< double, TypeParam::value >::rule(entity.type(), 2);
+    for (const auto& element : quadrature)
+      EXPECT_EQ(local_func->evaluate(element.position())[0], 5.0);
+    values.assign(quadrature.size(), RangeType(0));
+    local_func->evaluate(quadrature, values);
+    for (size_t ii = 0; ii < quadrature.size(); ++ii)
+      EXPECT_EQ(values[ii][0], 5.0);
+  }
+} // DifferenceFunctionTest, fused_evaluate_check
+
 
 #else // HAVE_DUNE_GRID
 
@@ -104,5 +149,7 @@ TYPED_TEST(DifferenceFunctionTest, evaluate_check) {
 TEST(DISABLED_FlatTopFunctionTest, static_interface_check) {}
 TEST(DISABLED_DifferenceFunctionTest, dynamic_interface_check) {}
 TEST(DISABLED_DifferenceFunctionTest, evaluate_check) {}
+TEST(DISABLED_DifferenceFunctionTest, batch_evaluate_check) {}
+TEST(DISABLED_DifferenceFunctionTest, fused_evaluate_check) {}
 
 #endif // HAVE_DUNE_GRID
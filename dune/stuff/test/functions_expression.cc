@@ -6,11 +6,16 @@
 #include "main.hxx"
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 
 #include <dune/stuff/functions/interfaces.hh>
 #include <dune/stuff/functions/expression.hh>
+#include <dune/stuff/functions/expression/base.hh>
+#include <dune/stuff/functions/expression/mathexpr.hh>
+#include <dune/stuff/functions/expression/program.hh>
 
 
 // we need this nasty code generation because the testing::Types< ... > only accepts 50 arguments
@@ -51,6 +56,89 @@
 // TEST_STRUCT_GENERATOR
 
 
+TEST(MathExpressionBase, concurrent_evaluation) {
+  typedef Dune::Stuff::Functions::MathExpressionBase< double, 2, double, 2 > ExpressionType;
+  const ExpressionType expression("x",
+                                  std::vector< std::string >({"sin(x[0])*exp(-x[1]*x[1])+3", "x[0]^2-(x[1]+1)/(x[0]+2)"}));
+  const size_t num_points = 1000;
+  const size_t num_threads = 4;
+  typedef std::vector< Dune::FieldVector< double, 2 > > ValuesType;
+  ValuesType expected(num_points);
+  for (size_t ii = 0; ii < num_points; ++ii)
+    expression.evaluate(Dune::FieldVector< double, 2 >({0.001*ii, -0.002*ii}), expected[ii]);
+  std::vector< ValuesType > results(num_threads, ValuesType(num_points));
+  std::vector< std::thread > threads;
+  for (size_t tt = 0; tt < num_threads; ++tt)
+    threads.emplace_back([&, tt]() {
+      for (size_t ii = 0; ii < num_points; ++ii)
+        expression.evaluate(Dune::FieldVector< double, 2 >({0.001*ii, -0.002*ii}), results[tt][ii]);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  for (size_t tt = 0; tt < num_threads; ++tt)
+    for (size_t ii = 0; ii < num_points; ++ii)
+      EXPECT_EQ(expected[ii], results[tt][ii]);
+} // TEST(MathExpressionBase, concurrent_evaluation)
+
+TEST(MathExpressionBase, batch_evaluation) {
+  typedef Dune::Stuff::Functions::MathExpressionBase< double, 2, double, 3 > ExpressionType;
+  const ExpressionType expression("x", std::vector< std::string >({"sin(x[0])*exp(-x[1]*x[1])+3",
+                                                                   "x[0]^2-(x[1]+1)/(x[0]+2)",
+                                                                   "sqrt(x[0]*x[0]+x[1]*x[1])"}));
+  // not a multiple of the number of lanes
+  std::vector< Dune::FieldVector< double, 2 > > points;
+  for (size_t ii = 0; ii < 21; ++ii)
+    points.emplace_back(Dune::FieldVector< double, 2 >({0.1*ii - 1.0, 0.05*ii}));
+  std::vector< Dune::FieldVector< double, 3 > > values;
+  expression.evaluate(points, values);
+  ASSERT_EQ(points.size(), values.size());
+  Dune::FieldVector< double, 3 > expected;
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    expression.evaluate(points[ii], expected);
+    EXPECT_EQ(expected, values[ii]);
+  }
+  expression.evaluate(std::vector< Dune::FieldVector< double, 2 > >(), values);
+  EXPECT_EQ(0u, values.size());
+} // TEST(MathExpressionBase, batch_evaluation)
+
+TEST(MathExpressionProgram, folds_and_shares_subexpressions) {
+  Dune::Stuff::Functions::MathExpressionProgram program("x", 2);
+  const std::vector< std::string > values = {"2*3+x[0]", "x[0]*x[1]+sin(x[0])^2-3", "atan(x[0],x[1])", "ln(x[0])",
+                                             "sqrt(abs(x[1]))/2+1e-3*x[0]", "x[1]/x[0]", "3 rt x[1]", "4.5"};
+  const std::vector< std::string > gradients = {"x[1]+2*sin(x[0])*cos(x[0])", "x[0]"};
+  const size_t values_group = program.add(values);
+  const size_t gradients_group = program.add(gradients);
+  EXPECT_EQ(values.size(), program.size(values_group));
+  EXPECT_EQ(gradients.size(), program.size(gradients_group));
+  // 2*3 is folded, 6+x[0] remains
+  Dune::Stuff::Functions::MathExpressionProgram folded("x", 2);
+  EXPECT_EQ(1u, folded.num_instructions(folded.add({"2*3+x[0]"})));
+  // subexpressions of previous groups are reused
+  const size_t num_registers = program.num_registers();
+  const size_t shared_group = program.add({"sin(x[0])^2", "x[0]*x[1]", "2*sin(x[0])"});
+  EXPECT_EQ(num_registers, program.num_registers());
+  EXPECT_EQ(4u, program.num_instructions(shared_group));
+  // both commutative operations are shared independent of the order of their operands
+  program.add({"x[1]*x[0]", "sin(x[0])*2"});
+  EXPECT_EQ(num_registers, program.num_registers());
+  // same results as the parsed tree, including invalid values
+  double x[2];
+  RVar x_0("x[0]", &x[0]);
+  RVar x_1("x[1]", &x[1]);
+  PRVar variables[2] = {&x_0, &x_1};
+  std::vector< double > results(values.size());
+  for (double x_0_value : {-1.5, -0.3, 0.0, 0.7, 2.0}) {
+    for (double x_1_value : {-2.0, 0.0, 0.4, 1.1}) {
+      x[0] = x_0_value;
+      x[1] = x_1_value;
+      program.evaluate(values_group, x, results.data());
+      for (size_t ii = 0; ii < values.size(); ++ii)
+        EXPECT_EQ(ROperation(values[ii].c_str(), 2, variables).Val(), results[ii]) << values[ii];
+    }
+  }
+} // TEST(MathExpressionProgram, folds_and_shares_subexpressions)
+
+
 #if HAVE_DUNE_GRID
 
 # include <dune/grid/sgrid.hh>
@@ -0,0 +1,90 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if HAVE_DUNE_GRID
+# include <dune/grid/sgrid.hh>
+#endif
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/random_ellipsoids_function.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Dune::Stuff;
+
+typedef SGrid< 2, 2 > RandomEllipsoidsGridType;
+typedef RandomEllipsoidsGridType::Codim< 0 >::Entity RandomEllipsoidsEntityType;
+typedef Functions::RandomEllipsoidsFunction< RandomEllipsoidsEntityType, double, 2, double, 1, 1 >
+    RandomEllipsoidsFunctionType;
+
+TEST(RandomEllipsoidsFunction, bucketed_evaluation_matches_brute_force) {
+  static const size_t dimDomain = 2;
+  typedef Common::FieldVector< double, dimDomain > CoordinateType;
+  Common::Configuration ellipsoid_cfg;
+  ellipsoid_cfg["ellipsoids.count"] = "20";
+  ellipsoid_cfg["ellipsoids.children"] = "2";
+  ellipsoid_cfg["ellipsoids.min_radius"] = "0.05";
+  ellipsoid_cfg["ellipsoids.max_radius"] = "0.2";
+  const RandomEllipsoidsFunctionType function(CoordinateType(0.), CoordinateType(1.), ellipsoid_cfg);
+  const auto& ellipsoids = function.ellipsoids();
+  ASSERT_GT(ellipsoids.size(), size_t(20));
+  // the buckets of the function, see RandomEllipsoidsFunction::build_index()
+  CoordinateType index_lower_left = ellipsoids[0].lower_left();
+  CoordinateType index_upper_right = ellipsoids[0].upper_right();
+  for (const auto& ellipsoid : ellipsoids) {
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      index_lower_left[dd] = std::min(index_lower_left[dd], ellipsoid.lower_left()[dd]);
+      index_upper_right[dd] = std::max(index_upper_right[dd], ellipsoid.upper_right()[dd]);
+    }
+  }
+  const size_t buckets_per_dim = std::max(size_t(1), size_t(std::pow(double(ellipsoids.size()), 1.0/dimDomain)));
+  CoordinateType bucket_width = index_upper_right - index_lower_left;
+  bucket_width /= double(buckets_per_dim);
+  // the faces of this grid lie on all bucket boundaries, its outermost elements are outside of all buckets
+  const unsigned int num_elements = static_cast< unsigned int >(2*buckets_per_dim + 4);
+  const Grid::Providers::Cube< RandomEllipsoidsGridType > grid_provider(index_lower_left - bucket_width,
+                                                                       index_upper_right + bucket_width,
+                                                                       num_elements);
+  const auto& reference_element = ReferenceElements< double, dimDomain >::general(GeometryType(GeometryType::cube,
+                                                                                               dimDomain));
+  std::vector< FieldVector< double, dimDomain > > local_points;
+  for (int ii = 0; ii < reference_element.size(dimDomain); ++ii)
+    local_points.push_back(reference_element.position(ii, dimDomain));
+  for (const auto& quadrature_point : QuadratureRules< double, dimDomain >::rule(reference_element.type(), 4))
+    local_points.push_back(quadrature_point.position());
+  size_t inside = 0;
+  for (const auto& entity : Common::entityRange(grid_provider.grid().leafGridView())) {
+    const auto local_function = function.local_function(entity);
+    for (const auto& local_point : local_points) {
+      const auto global_point = entity.geometry().global(local_point);
+      bool contained = false;
+      for (const auto& ellipsoid : ellipsoids)
+        contained = contained || ellipsoid.contains(global_point);
+      inside += contained;
+      EXPECT_EQ(contained ? 1. : 0., local_function->evaluate(local_point)[0]) << global_point;
+    }
+  }
+  EXPECT_GT(inside, size_t(0));
+} // TEST(RandomEllipsoidsFunction, bucketed_evaluation_matches_brute_force)
+
+
+#else // HAVE_DUNE_GRID
+
+TEST(DISABLED_RandomEllipsoidsFunction, bucketed_evaluation_matches_brute_force) {}
+
+#endif // HAVE_DUNE_GRID
@@ -5,7 +5,13 @@
 
 #include "main.hxx"
 
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 
@@ -95,6 +101,98 @@ TYPED_TEST(Spe10Model2FunctionTestYaspGridEntityTest, provides_required_methods)
   this->check();
 }
 
+typedef Dune::Stuff::Functions::Spe10::Model2< DuneYaspGrid3dEntityType, double, 3, double, 3, 3 > Spe10Model2Type;
+
+//! the number of cells of the data written by region_of_interest, much less than the one of the SPE10 data
+static const Dune::Stuff::Common::FieldVector< unsigned int, 3 > spe10_test_cells({12u, 24u, 10u});
+
+//! the value of cell (x, y, z) in direction dim of the data written by region_of_interest
+static size_t spe10_test_value(const size_t dim, const size_t xx, const size_t yy, const size_t zz)
+{
+  return 1 + xx + spe10_test_cells[0]*(yy + spe10_test_cells[1]*(zz + spe10_test_cells[2]*dim));
+}
+
+static Spe10Model2Type::DomainType spe10_point(const double xx, const double yy, const double zz)
+{
+  Spe10Model2Type::DomainType ret;
+  ret[0] = xx;
+  ret[1] = yy;
+  ret[2] = zz;
+  return ret;
+}
+
+//! the diagonal of the permeability
+static std::array< double, 3 > spe10_evaluate(const Spe10Model2Type& function, const Spe10Model2Type::DomainType& xx)
+{
+  Spe10Model2Type::RangeType ret(0);
+  function.evaluate(xx, ret);
+  return {{ret[0][0], ret[1][1], ret[2][2]}};
+}
+
+TEST(Spe10Model2, region_of_interest) {
+  typedef Dune::Stuff::Common::FieldVector< unsigned int, 3 > CellIndexType;
+  const auto& num_cells = spe10_test_cells;
+  const auto& upper_right = Spe10Model2Type::default_upper_right;
+  const std::string filename = "spe10_model2_test.dat";
+  std::remove((filename + ".bin").c_str());
+  {
+    std::ofstream datafile(filename);
+    for (size_t dim = 0; dim < 3; ++dim)
+      for (size_t zz = 0; zz < num_cells[2]; ++zz)
+        for (size_t yy = 0; yy < num_cells[1]; ++yy)
+          for (size_t xx = 0; xx < num_cells[0]; ++xx)
+            datafile << spe10_test_value(dim, xx, yy, zz) << "\n";
+  }
+  const CellIndexType roi_lower_left({2u, 5u, 3u});
+  const CellIndexType roi_upper_right({10u, 20u, 7u});
+  const Spe10Model2Type full(filename, upper_right, CellIndexType(0u), num_cells, true, num_cells);
+  const Spe10Model2Type lazy(filename, upper_right, roi_lower_left, roi_upper_right, true, num_cells);
+  const Spe10Model2Type copied(filename, upper_right, roi_lower_left, roi_upper_right, false, num_cells);
+  const auto cell_center = [&](const double xx, const double yy, const double zz) {
+    return spe10_point((xx + 0.5)*upper_right[0]/num_cells[0],
+                       (yy + 0.5)*upper_right[1]/num_cells[1],
+                       (zz + 0.5)*upper_right[2]/num_cells[2]);
+  };
+  // within the region, all of them give the values of the data file
+  for (size_t zz = roi_lower_left[2]; zz < roi_upper_right[2]; ++zz)
+    for (size_t yy = roi_lower_left[1]; yy < roi_upper_right[1]; ++yy)
+      for (size_t xx = roi_lower_left[0]; xx < roi_upper_right[0]; ++xx) {
+        const auto point = cell_center(xx, yy, zz);
+        const auto expected = spe10_evaluate(full, point);
+        for (size_t dim = 0; dim < 3; ++dim)
+          EXPECT_EQ(double(spe10_test_value(dim, xx, yy, zz)), expected[dim]);
+        EXPECT_EQ(expected, spe10_evaluate(lazy, point));
+        EXPECT_EQ(expected, spe10_evaluate(copied, point));
+      }
+  // outside of the region (and the domain), the nearest cell of the region is used
+  const double inf = std::numeric_limits< double >::infinity();
+  const double nan = std::numeric_limits< double >::quiet_NaN();
+  const std::vector< Spe10Model2Type::DomainType > outside = {cell_center(0, 0, 0),
+                                                              cell_center(11, 23, 9),
+                                                              cell_center(-5, 12, 100),
+                                                              spe10_point(-inf, inf, 1e300),
+                                                              spe10_point(nan, nan, nan)};
+  const std::vector< std::array< size_t, 3 > > nearest = {{{2, 5, 3}}, {{9, 19, 6}}, {{2, 12, 6}},
+                                                          {{2, 19, 6}}, {{2, 5, 3}}};
+  for (size_t ii = 0; ii < outside.size(); ++ii) {
+    const auto expected = spe10_evaluate(full, cell_center(nearest[ii][0], nearest[ii][1], nearest[ii][2]));
+    EXPECT_EQ(expected, spe10_evaluate(lazy, outside[ii])) << outside[ii];
+    EXPECT_EQ(expected, spe10_evaluate(copied, outside[ii])) << outside[ii];
+  }
+  // invalid regions
+  EXPECT_THROW(Spe10Model2Type(filename, upper_right, roi_upper_right, roi_lower_left, true, num_cells),
+               Dune::RangeError);
+  EXPECT_THROW(Spe10Model2Type(filename, upper_right, roi_lower_left, CellIndexType({10u, 20u, 11u}), true, num_cells),
+               Dune::RangeError);
+  // too few values for the cells of the SPE10 data
+  EXPECT_THROW(Spe10Model2Type(filename, upper_right, roi_lower_left, roi_upper_right), Dune::IOError);
+  std::remove(filename.c_str());
+  std::remove((filename + ".bin").c_str());
+  // without data, evaluate() throws
+  const Spe10Model2Type missing(filename);
+  EXPECT_THROW(spe10_evaluate(missing, cell_center(0, 0, 0)), Dune::IOError);
+} // TEST(Spe10Model2, region_of_interest)
+
 //# if HAVE_ALUGRID
 //#   include <dune/stuff/common/disable_warnings.hh>
 //#     include <dune/grid/alugrid.hh>
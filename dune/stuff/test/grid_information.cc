@@ -62,6 +62,19 @@ struct GridInfoTest : public ::testing::Test
     EXPECT_EQ(griddim*2, maxNumberOfNeighbors(gv));
   }
 
+  void check_threaded() {
+    // the test binaries use a single thread by default, the reducers are only split and joined with several
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto gv = grid_prv.grid().leafGridView();
+    check_dimensions(DimensionsType(gv, true), gv.size(0));
+    const Statistics serial(gv);
+    const Statistics threaded(gv, true);
+    EXPECT_EQ(serial.numberOfIntersections, threaded.numberOfIntersections);
+    EXPECT_EQ(serial.numberOfInnerIntersections, threaded.numberOfInnerIntersections);
+    EXPECT_EQ(serial.numberOfBoundaryIntersections, threaded.numberOfBoundaryIntersections);
+    EXPECT_DOUBLE_EQ(serial.maxGridWidth, threaded.maxGridWidth);
+  }
+
   void print(std::ostream& out) {
     const auto& gv = grid_prv.grid().leafGridView();
     printInfo(gv, out);
@@ -71,6 +84,7 @@ struct GridInfoTest : public ::testing::Test
 TYPED_TEST_CASE(GridInfoTest, GridDims);
 TYPED_TEST(GridInfoTest, Misc) {
   this->check();
+  this->check_threaded();
   this->print(dev_null);
 }
 
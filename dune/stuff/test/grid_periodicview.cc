@@ -282,6 +282,66 @@ struct PeriodicViewTestYaspCube
     this->check(hr_partially_periodic_grid_view, hyperrectangle_grid_view, is_simplex, 4);
     this->check(hr_fully_periodic_grid_view, hyperrectangle_grid_view, is_simplex, 5);
   } // void checks_for_all_grids(...)
+
+  // checks the hashed lookup of the periodic partners on a grid with a different number of elements per direction
+  void check_periodic_partners()
+  {
+    DSC::Configuration grid_config = GridProviderType::default_config();
+    grid_config["lower_left"] = "[0.0 0.0 0.0 0.0]";
+    grid_config["upper_right"] = "[2.0 3.0 1.0 4.0]";
+    const std::vector< size_t > num_elements = {13, 7, 5, 3};
+    grid_config["num_elements"] = "[13 7 5 3]";
+    GridProviderType grid_provider = *(GridProviderType::create(grid_config));
+    const std::shared_ptr< const GridType > grid = grid_provider.grid_ptr();
+    const GridViewType grid_view = grid->leafGridView();
+    const DomainType upper_right = DSC::fromString< DomainType >("[2.0 3.0 1.0 4.0]");
+    std::bitset< dimDomain > periodic_directions;
+    periodic_directions.set();
+    const PeriodicGridViewType periodic_grid_view(grid_view, periodic_directions);
+
+    size_t periodic_count = 0;
+    for (const auto& entity : DSC::entityRange(periodic_grid_view)) {
+      const PeriodicIntersectionIteratorType i_it_end = periodic_grid_view.iend(entity);
+      for (PeriodicIntersectionIteratorType i_it = periodic_grid_view.ibegin(entity); i_it != i_it_end; ++i_it) {
+        const PeriodicIntersectionType& intersection = *i_it;
+        if (!intersection.boundary())
+          continue;
+        EXPECT_TRUE(intersection.neighbor());
+        ++periodic_count;
+        // the partner is the intersection of outside() with indexInOutside(), its center is shifted by the period
+        const EntityPointerType outside = intersection.outside();
+        const int index_in_outside = intersection.indexInOutside();
+        size_t found = 0;
+        const PeriodicIntersectionIteratorType o_it_end = periodic_grid_view.iend(*outside);
+        for (PeriodicIntersectionIteratorType o_it = periodic_grid_view.ibegin(*outside); o_it != o_it_end; ++o_it) {
+          if (o_it->indexInInside() != index_in_outside)
+            continue;
+          ++found;
+          EXPECT_TRUE(o_it->boundary() && o_it->neighbor());
+          const DomainType center = intersection.geometry().center();
+          DomainType shifted_center = o_it->geometry().center();
+          for (size_t ii = 0; ii < dimDomain; ++ii) {
+            if (Dune::Stuff::Common::FloatCmp::eq(shifted_center[ii] + upper_right[ii], center[ii]))
+              shifted_center[ii] += upper_right[ii];
+            else if (Dune::Stuff::Common::FloatCmp::eq(shifted_center[ii] - upper_right[ii], center[ii]))
+              shifted_center[ii] -= upper_right[ii];
+          }
+          EXPECT_TRUE(Dune::Stuff::Common::FloatCmp::eq(center, shifted_center));
+          EXPECT_EQ(intersection.indexInInside(), o_it->indexInOutside());
+        }
+        EXPECT_EQ(size_t(1), found);
+      }
+    }
+    size_t expected_count = 0;
+    for (size_t ii = 0; ii < dimDomain; ++ii) {
+      size_t faces = 2;
+      for (size_t jj = 0; jj < dimDomain; ++jj)
+        if (jj != ii)
+          faces *= num_elements[jj];
+      expected_count += faces;
+    }
+    EXPECT_EQ(expected_count, periodic_count);
+  } // void check_periodic_partners()
 }; // ... struct PeriodicViewTestYaspCube ...
 
 template< class GridImp >
@@ -319,6 +379,28 @@ struct PeriodicViewTestALUCube
     this->check(partially_periodic_grid_view, grid_view, is_simplex, 7);
     this->check(fully_periodic_grid_view, grid_view, is_simplex, 8);
   } // void additional_checks_for_alu(...)
+
+  // a boundary intersection without a partner on the opposite side of the grid is an error
+  void check_non_conforming_boundaries()
+  {
+    GridProviderType grid_provider = *(GridProviderType::create());
+    const std::shared_ptr< GridType > grid = grid_provider.grid_ptr();
+    const GridViewType coarse_grid_view = grid->leafGridView();
+    for (const auto& entity : DSC::entityRange(coarse_grid_view)) {
+      if (entity.hasBoundaryIntersections()) {
+        grid->mark(1, entity);
+        break;
+      }
+    }
+    grid->preAdapt();
+    grid->adapt();
+    grid->postAdapt();
+    const GridViewType grid_view = grid->leafGridView();
+    std::bitset< dimDomain > periodic_directions;
+    EXPECT_NO_THROW(PeriodicGridViewType(grid_view, periodic_directions));
+    periodic_directions.set();
+    EXPECT_THROW(PeriodicGridViewType(grid_view, periodic_directions), Dune::InvalidStateException);
+  } // void check_non_conforming_boundaries()
 }; // ... struct PeriodicViewTestALUCube ...
 
 template< class GridImp >
@@ -336,6 +418,11 @@ TYPED_TEST(PeriodicViewTestYaspCube, check_yaspcube)
   this->checks_for_all_grids(false);
 }
 
+TYPED_TEST(PeriodicViewTestYaspCube, check_periodic_partners)
+{
+  this->check_periodic_partners();
+}
+
 # if HAVE_ALUGRID
 
 typedef testing::Types<
@@ -353,6 +440,11 @@ TYPED_TEST(PeriodicViewTestALUCube, check_alucube)
   this->additional_checks_for_alu(false);
 }
 
+TYPED_TEST(PeriodicViewTestALUCube, check_non_conforming_boundaries)
+{
+  this->check_non_conforming_boundaries();
+}
+
 TYPED_TEST_CASE(PeriodicViewTestALUSimplex, ALUSimplexGridTypes);
 TYPED_TEST(PeriodicViewTestALUSimplex, check_alusimplex)
 {
@@ -363,12 +455,14 @@ TYPED_TEST(PeriodicViewTestALUSimplex, check_alusimplex)
 # else // HAVE_ALUGRID
 
 TEST(DISABLED_PeriodicViewTestALUCube, check_alucube) {}
+TEST(DISABLED_PeriodicViewTestALUCube, check_non_conforming_boundaries) {}
 TEST(DISABLED_PeriodicViewTestALUSimplex, check_alusimplex) {}
 
 # endif // HAVE_ALUGRID
 #else // HAVE_DUNE_GRID
 
 TEST(DISABLED_PeriodicViewTestYaspCube, check_yaspcube) {}
+TEST(DISABLED_PeriodicViewTestYaspCube, check_periodic_partners) {}
 
 #endif // HAVE_DUNE_GRID
 
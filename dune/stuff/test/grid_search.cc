@@ -0,0 +1,111 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#if HAVE_DUNE_GRID
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/stuff/grid/search.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/common/ranges.hh>
+
+using namespace Dune::Stuff;
+
+typedef testing::Types< Int<1>, Int<2>, Int<3> > GridDims;
+
+template < class T >
+struct EntitySearchTest : public ::testing::Test
+{
+  static const size_t griddim = T::value;
+  typedef Dune::YaspGrid< griddim > GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridViewType::template Codim< 0 >::Geometry::GlobalCoordinate DomainType;
+
+  const DSG::Providers::Cube< GridType > grid_prv;
+  EntitySearchTest()
+    : grid_prv(0.0, 1.0, 6)
+  {}
+
+  void check() const
+  {
+    const auto grid_view = grid_prv.grid().leafGridView();
+    const auto& index_set = grid_view.indexSet();
+    std::vector< DomainType > centers;
+    for (const auto& entity : DSC::entityRange(grid_view))
+      centers.push_back(entity.geometry().center());
+    const auto search = DSG::make_entity_indexed_search(grid_view);
+    EXPECT_EQ(size_t(grid_view.size(0)), search.size());
+    const auto found = search(centers);
+    ASSERT_EQ(centers.size(), found.size());
+    size_t ii = 0;
+    for (const auto& entity : DSC::entityRange(grid_view)) {
+      ASSERT_NE(nullptr, found[ii]);
+      EXPECT_EQ(index_set.index(entity), index_set.index(**found[ii]));
+      ++ii;
+    }
+    // corners and points outside, also far away and at infinity
+    std::vector< DomainType > points(2, DomainType(0.0));
+    points[1] = DomainType(2.0);
+    points.push_back(DomainType(1e300));
+    points.push_back(DomainType(-1e300));
+    points.push_back(DomainType(std::numeric_limits< double >::infinity()));
+    points.push_back(DomainType(-std::numeric_limits< double >::infinity()));
+    const auto corners = search(points);
+    ASSERT_EQ(points.size(), corners.size());
+    ASSERT_NE(nullptr, corners[0]);
+    for (size_t jj = 1; jj < points.size(); ++jj)
+      EXPECT_EQ(nullptr, corners[jj]);
+    // same as the linear search
+    auto inlevel_search = DSG::make_entity_in_level_search(grid_view);
+    const auto expected = inlevel_search(std::vector< DomainType >(1, DomainType(0.0)));
+    EXPECT_EQ(index_set.index(**expected[0]), index_set.index(**corners[0]));
+  }
+
+  void check_batch() const
+  {
+    // the test binaries use a single thread by default, find_all() only splits the points with several
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto grid_view = grid_prv.grid().leafGridView();
+    std::vector< DomainType > points;
+    for (const auto& entity : DSC::entityRange(grid_view))
+      points.push_back(entity.geometry().center());
+    points.push_back(DomainType(2.0));
+    std::shuffle(points.begin(), points.end(), std::mt19937(42));
+    const auto search = DSG::make_entity_indexed_search(grid_view);
+    for (const bool use_threads : {false, true}) {
+      std::vector< size_t > indices;
+      search.find_all(points, indices, use_threads);
+      ASSERT_EQ(points.size(), indices.size());
+      for (size_t ii = 0; ii < points.size(); ++ii) {
+        size_t expected = search.size();
+        search.find(points[ii], expected);
+        EXPECT_EQ(expected, indices[ii]);
+      }
+      EXPECT_EQ(size_t(1), size_t(std::count(indices.begin(), indices.end(), search.size())));
+    }
+  }
+};
+
+TYPED_TEST_CASE(EntitySearchTest, GridDims);
+TYPED_TEST(EntitySearchTest, indexed_search) {
+  this->check();
+}
+TYPED_TEST(EntitySearchTest, batch_search) {
+  this->check_batch();
+}
+
+#else // HAVE_DUNE_GRID
+
+TEST(DISABLED_EntitySearchTest, indexed_search) {}
+TEST(DISABLED_EntitySearchTest, batch_search) {}
+
+#endif // HAVE_DUNE_GRID
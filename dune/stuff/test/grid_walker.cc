@@ -7,7 +7,10 @@
 
 #if HAVE_DUNE_GRID
 
+# include <atomic>
+
 # include <dune/stuff/grid/walker.hh>
+# include <dune/stuff/grid/walker/static.hh>
 # include <dune/stuff/grid/provider/cube.hh>
 # include <dune/stuff/common/parallel/partitioner.hh>
 # include <dune/stuff/common/logstreams.hh>
@@ -23,6 +26,40 @@ using namespace std;
 
 typedef testing::Types< Int<1>, Int<2>, Int<3> > GridDims;
 
+//! counts the calls of the virtual hooks, the functors are still applied by the base implementation
+template< class GridViewType >
+class CountingWalker
+  : public Walker< GridViewType >
+{
+  typedef Walker< GridViewType > BaseType;
+public:
+  typedef typename BaseType::EntityType EntityType;
+  typedef typename BaseType::IntersectionType IntersectionType;
+
+  explicit CountingWalker(const GridViewType& grid_view)
+    : BaseType(grid_view)
+    , entity_calls(0)
+    , intersection_calls(0)
+  {}
+
+  virtual void apply_local(const EntityType& entity) override
+  {
+    ++entity_calls;
+    BaseType::apply_local(entity);
+  }
+
+  virtual void apply_local(const IntersectionType& intersection,
+                           const EntityType& inside_entity,
+                           const EntityType& outside_entity) override
+  {
+    ++intersection_calls;
+    BaseType::apply_local(intersection, inside_entity, outside_entity);
+  }
+
+  std::atomic< size_t > entity_calls;
+  std::atomic< size_t > intersection_calls;
+};
+
 template < class T >
 struct GridWalkerTest : public ::testing::Test
 {
@@ -38,6 +75,8 @@ struct GridWalkerTest : public ::testing::Test
   {}
 
   void check_count() {
+    // the test binaries use a single thread by default
+    const Dune::Stuff::Test::ScopedThreads threads(4);
     const auto gv = grid_prv.grid().leafGridView();
     Walker<GridViewType> walker(gv);
     const auto correct_size = gv.size(0);
@@ -61,6 +100,177 @@ struct GridWalkerTest : public ::testing::Test
       test();
       EXPECT_EQ(count, correct_size);
     }
+    // exceptions thrown by the functors on any worker are forwarded to the caller
+    Walker<GridViewType> throwing_walker(gv);
+    throwing_walker.add([&](const EntityType& entity) {
+                          if (gv.indexSet().index(entity) == size_t(gv.size(0) - 1))
+                            DUNE_THROW(Dune::InvalidStateException, "");
+                        });
+    EXPECT_THROW(throwing_walker.walk(true), Dune::InvalidStateException);
+  }
+
+  void check_intersection_count() {
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto gv = grid_prv.grid().leafGridView();
+    Walker<GridViewType> walker(gv);
+    size_t correct_size = 0;
+    for (const auto& entity : DSC::entityRange(gv))
+      for (const auto& DUNE_UNUSED(intersection) : DSC::intersectionRange(gv, entity))
+        ++correct_size;
+    atomic<size_t> entity_count(0);
+    atomic<size_t> intersection_count(0);
+    auto entity_counter = [&](const EntityType&){entity_count++;};
+    auto intersection_counter = [&](const IntersectionType&, const EntityType&, const EntityType&){intersection_count++;};
+    for (bool use_threads : {false, true}) {
+      entity_count = 0;
+      intersection_count = 0;
+      walker.add(entity_counter);
+      walker.add(intersection_counter);
+      walker.walk(use_threads);
+      EXPECT_EQ(entity_count, gv.size(0));
+      EXPECT_EQ(intersection_count, correct_size);
+    }
+  }
+
+  void check_colored() {
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto gv = grid_prv.grid().leafGridView();
+    const auto& index_set = gv.indexSet();
+    ColoredPartitioner<GridViewType> partitioner(gv, 4 * threadManager().current_threads());
+    EXPECT_GT(partitioner.colors(), size_t(1));
+    // partitions touching the same entity must have different colors
+    for (const auto& entity : DSC::entityRange(gv)) {
+      std::vector<size_t> colors(1, partitioner.color(partitioner.partition(entity)));
+      for (const auto& intersection : DSC::intersectionRange(gv, entity)) {
+        if (intersection.neighbor()) {
+          const auto neighbor_ptr = intersection.outside();
+          const auto neighbor_partition = partitioner.partition(*neighbor_ptr);
+          if (neighbor_partition != partitioner.partition(entity))
+            colors.push_back(partitioner.color(neighbor_partition));
+        }
+      }
+      std::sort(colors.begin(), colors.end());
+      EXPECT_EQ(std::unique(colors.begin(), colors.end()), colors.end());
+    }
+    // entities of different partitions with a common vertex must have different colors
+    std::vector<std::vector<size_t>> partitions_of_vertex(index_set.size(griddim));
+    for (const auto& entity : DSC::entityRange(gv))
+      for (int ii = 0; ii < entity.geometry().corners(); ++ii)
+        partitions_of_vertex[index_set.subIndex(entity, ii, griddim)].push_back(partitioner.partition(entity));
+    for (auto& partitions : partitions_of_vertex) {
+      std::sort(partitions.begin(), partitions.end());
+      partitions.erase(std::unique(partitions.begin(), partitions.end()), partitions.end());
+      std::vector<size_t> colors;
+      for (const auto& partition : partitions)
+        colors.push_back(partitioner.color(partition));
+      std::sort(colors.begin(), colors.end());
+      EXPECT_EQ(std::unique(colors.begin(), colors.end()), colors.end());
+    }
+    // non-atomic writes to inside and outside data
+    std::vector<size_t> visits(index_set.size(0), 0);
+    Walker<GridViewType> walker(gv);
+    walker.add([&](const IntersectionType&, const EntityType& inside, const EntityType& outside) {
+                 ++visits[index_set.index(inside)];
+                 ++visits[index_set.index(outside)];
+               },
+               new DSG::ApplyOn::InnerIntersections<GridViewType>());
+    walker.walk_colored(partitioner);
+    for (const auto& entity : DSC::entityRange(gv)) {
+      size_t neighbors = 0;
+      for (const auto& intersection : DSC::intersectionRange(gv, entity))
+        neighbors += intersection.neighbor();
+      EXPECT_EQ(visits[index_set.index(entity)], 2 * neighbors);
+    }
+  }
+
+  void check_static() {
+    const auto gv = grid_prv.grid().leafGridView();
+    size_t entity_count = 0, intersection_count = 0, boundary_count = 0, walker_boundary_count = 0;
+    auto entity_counter = [&](const EntityType&){entity_count++;};
+    auto intersection_counter = [&](const IntersectionType&, const EntityType&, const EntityType&){intersection_count++;};
+    auto boundary_counter = [&](const IntersectionType&, const EntityType&, const EntityType&){boundary_count++;};
+    auto static_walker = make_static_walker(gv,
+                                            entity_counter,
+                                            intersection_counter,
+                                            filter(boundary_counter, ApplyOn::BoundaryIntersections<GridViewType>()));
+    static_walker.walk();
+    Walker<GridViewType> walker(gv);
+    walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){walker_boundary_count++;},
+               new DSG::ApplyOn::BoundaryIntersections<GridViewType>());
+    walker.walk();
+    EXPECT_EQ(entity_count, gv.size(0));
+    EXPECT_EQ(intersection_count, gv.size(0) * 2 * griddim);
+    EXPECT_EQ(boundary_count, walker_boundary_count);
+  }
+
+  void check_replay() {
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto gv = grid_prv.grid().leafGridView();
+    const TraversalPlan<GridViewType> plan(gv);
+    EXPECT_EQ(plan.size(), gv.size(0));
+    for (const bool use_threads : {false, true}) {
+      std::atomic<size_t> walk_boundary_count(0), walk_inner_count(0);
+      Walker<GridViewType> walker(gv);
+      walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){walk_boundary_count++;},
+                 new DSG::ApplyOn::BoundaryIntersections<GridViewType>());
+      walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){walk_inner_count++;},
+                 new DSG::ApplyOn::InnerIntersectionsPrimally<GridViewType>());
+      walker.walk(use_threads);
+      std::atomic<size_t> replay_entity_count(0), replay_boundary_count(0), replay_inner_count(0);
+      std::atomic<size_t> replay_filtered_count(0);
+      auto boundaries = [=](const GridViewType&, const IntersectionType& inter){return inter.boundary();};
+      walker.add([&](const EntityType&){replay_entity_count++;});
+      walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){replay_boundary_count++;},
+                 new DSG::ApplyOn::BoundaryIntersections<GridViewType>());
+      walker.add([&](const IntersectionType& inter, const EntityType& inside, const EntityType& outside){
+                   EXPECT_NE(gv.indexSet().index(inside), gv.indexSet().index(outside));
+                   EXPECT_EQ(gv.indexSet().index(outside), gv.indexSet().index(*inter.outside()));
+                   replay_inner_count++;
+                 },
+                 new DSG::ApplyOn::InnerIntersectionsPrimally<GridViewType>());
+      walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){replay_filtered_count++;},
+                 new DSG::ApplyOn::FilteredIntersections<GridViewType>(boundaries));
+      walker.replay(plan, use_threads);
+      EXPECT_EQ(replay_entity_count.load(), gv.size(0));
+      EXPECT_EQ(replay_boundary_count.load(), walk_boundary_count.load());
+      EXPECT_EQ(replay_inner_count.load(), walk_inner_count.load());
+      EXPECT_EQ(replay_filtered_count.load(), walk_boundary_count.load());
+    }
+  }
+
+  void check_derived() {
+    const Dune::Stuff::Test::ScopedThreads threads(4);
+    const auto gv = grid_prv.grid().leafGridView();
+    const TraversalPlan<GridViewType> plan(gv);
+    const size_t intersections = gv.size(0) * 2 * griddim;
+    CountingWalker<GridViewType> walker(gv);
+    std::list<std::function<void()>> walks({ [&]{ walker.walk(false); },
+                                             [&]{ walker.walk(true); },
+                                             [&]{ walker.replay(plan, false); },
+                                             [&]{ walker.replay(plan, true); } });
+    for (const auto& walk : walks) {
+      walker.entity_calls = 0;
+      walker.intersection_calls = 0;
+      std::atomic<size_t> entity_count(0), intersection_count(0);
+      walker.add([&](const EntityType&){entity_count++;});
+      walker.add([&](const IntersectionType&, const EntityType&, const EntityType&){intersection_count++;});
+      walk();
+      EXPECT_EQ(walker.entity_calls.load(), gv.size(0));
+      EXPECT_EQ(walker.intersection_calls.load(), intersections);
+      EXPECT_EQ(entity_count.load(), gv.size(0));
+      EXPECT_EQ(intersection_count.load(), intersections);
+    }
+  }
+
+  void check_move() {
+    static_assert(std::is_move_constructible<Walker<GridViewType>>::value, "");
+    const auto gv = grid_prv.grid().leafGridView();
+    size_t count = 0;
+    Walker<GridViewType> walker(gv);
+    walker.add([&](const EntityType&){count++;}, new DSG::ApplyOn::AllEntities<GridViewType>());
+    Walker<GridViewType> moved(std::move(walker));
+    moved.walk();
+    EXPECT_EQ(count, gv.size(0));
   }
 
   void check_apply_on() {
@@ -84,6 +294,12 @@ struct GridWalkerTest : public ::testing::Test
 TYPED_TEST_CASE(GridWalkerTest, GridDims);
 TYPED_TEST(GridWalkerTest, Misc) {
   this->check_count();
+  this->check_intersection_count();
+  this->check_colored();
+  this->check_static();
+  this->check_replay();
+  this->check_derived();
+  this->check_move();
   this->check_apply_on();
 }
 
@@ -0,0 +1,129 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#if HAVE_DUNE_GRID
+
+# include <atomic>
+# include <cstdlib>
+# include <new>
+
+# include <dune/common/timer.hh>
+
+# include <dune/stuff/grid/walker.hh>
+# include <dune/stuff/grid/provider/cube.hh>
+
+// counts all allocations of this test binary
+static std::atomic< size_t > allocations(0);
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+using namespace Dune::Stuff;
+using namespace Dune::Stuff::Grid;
+
+typedef Dune::YaspGrid< 2 > GridType;
+typedef GridType::LeafGridView GridViewType;
+typedef DSG::Entity< GridViewType >::Type       EntityType;
+typedef DSG::Intersection< GridViewType >::Type IntersectionType;
+
+struct EntityCounter
+  : public Functor::Codim0< GridViewType >
+{
+  virtual void apply_local(const EntityType& /*entity*/) override final
+  {
+    ++count;
+  }
+
+  size_t count = 0;
+};
+
+struct IntersectionCounter
+  : public Functor::Codim1< GridViewType >
+{
+  virtual void apply_local(const IntersectionType& /*intersection*/,
+                           const EntityType& /*inside_entity*/,
+                           const EntityType& /*outside_entity*/) override final
+  {
+    ++count;
+  }
+
+  size_t count = 0;
+};
+
+static const size_t rebuilds = 100000;
+
+// adds the same functors over and over again, as in a time loop
+TEST(GridWalker, rebuild_does_not_allocate)
+{
+  const DSG::Providers::Cube< GridType > grid_provider(0.0, 1.0, 2);
+  const auto grid_view = grid_provider.grid().leafGridView();
+  EntityCounter entities;
+  IntersectionCounter all_intersections, boundary_intersections, filtered_intersections;
+  const ApplyOn::FilteredIntersections< GridViewType >::FilterType boundary_filter
+      = [](const GridViewType&, const IntersectionType& intersection) { return intersection.boundary(); };
+  Walker< GridViewType > walker(grid_view);
+  const auto fill = [&]() {
+    walker.add(entities);
+    walker.add(all_intersections);
+    walker.add(boundary_intersections, ApplyOn::BoundaryIntersections< GridViewType >::instance());
+    walker.add(filtered_intersections,
+               walker.make_filter< ApplyOn::FilteredIntersections< GridViewType > >(boundary_filter));
+  };
+  // the first walk provides the memory
+  fill();
+  walker.walk();
+  const size_t boundary_count = boundary_intersections.count;
+  EXPECT_EQ(filtered_intersections.count, boundary_count);
+
+  Dune::Timer timer;
+  const size_t allocations_before = allocations;
+  for (size_t ii = 0; ii < rebuilds; ++ii) {
+    fill();
+    walker.clear();
+  }
+  const size_t rebuild_allocations = allocations - allocations_before;
+  const double elapsed = timer.elapsed();
+  EXPECT_EQ(rebuild_allocations, 0u);
+
+  // the legacy way, each filter given by new
+  timer.reset();
+  const size_t legacy_allocations_before = allocations;
+  for (size_t ii = 0; ii < rebuilds; ++ii) {
+    walker.add(entities, new ApplyOn::AllEntities< GridViewType >());
+    walker.add(all_intersections, new ApplyOn::AllIntersections< GridViewType >());
+    walker.add(boundary_intersections, new ApplyOn::BoundaryIntersections< GridViewType >());
+    walker.add(filtered_intersections, new ApplyOn::FilteredIntersections< GridViewType >(boundary_filter));
+    walker.clear();
+  }
+  const size_t legacy_allocations = allocations - legacy_allocations_before;
+  const double legacy_elapsed = timer.elapsed();
+  EXPECT_GE(legacy_allocations, 4 * rebuilds);
+
+  DSC::TimedLogger().get("walker_rebuild").info() << rebuilds << " walker rebuilds: "
+                                                  << elapsed << "s, " << rebuild_allocations << " allocations "
+                                                  << "(filters by new: " << legacy_elapsed << "s, "
+                                                  << legacy_allocations << " allocations)" << std::endl;
+
+  // the refilled walker still works
+  fill();
+  walker.walk();
+  EXPECT_EQ(boundary_intersections.count, 2 * boundary_count);
+  EXPECT_EQ(filtered_intersections.count, 2 * boundary_count);
+  EXPECT_EQ(entities.count, 2 * size_t(grid_view.size(0)));
+} // TEST(GridWalker, rebuild_does_not_allocate)
+
+#endif // HAVE_DUNE_GRID
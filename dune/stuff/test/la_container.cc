@@ -7,9 +7,13 @@
 
 #include "main.hxx"
 
+#include <algorithm>
 #include <complex>
 #include <memory>
 #include <type_traits>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
 
 #include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/common/float_cmp.hh>
@@ -44,6 +48,7 @@ typedef testing::Types<
 #if HAVE_DUNE_ISTL
                       , Dune::Stuff::LA::IstlDenseVector< double >
                       , Dune::Stuff::LA::IstlDenseVector< std::complex< double > >
+                      , Dune::Stuff::LA::IstlDenseBlockVector< double, 2 >
 #endif
                       > VectorTypes;
 
@@ -75,6 +80,8 @@ typedef testing::Types<
                                  , Dune::Stuff::LA::IstlDenseVector< double > >
                       , std::pair< Dune::Stuff::LA::IstlRowMajorSparseMatrix< std::complex< double > >
                                  , Dune::Stuff::LA::IstlDenseVector< std::complex< double > > >
+                      , std::pair< Dune::Stuff::LA::IstlBlockSparseMatrix< double, 2 >
+                                 , Dune::Stuff::LA::IstlDenseBlockVector< double, 2 > >
 #endif
                       > MatrixVectorCombinations;
 
@@ -96,6 +103,8 @@ typedef testing::Types<
                       , Dune::Stuff::LA::IstlRowMajorSparseMatrix< double >
                       , Dune::Stuff::LA::IstlDenseVector< std::complex< double > >
                       , Dune::Stuff::LA::IstlRowMajorSparseMatrix< std::complex< double > >
+                      , Dune::Stuff::LA::IstlDenseBlockVector< double, 2 >
+                      , Dune::Stuff::LA::IstlBlockSparseMatrix< double, 2 >
 #endif
                       > ContainerTypes;
 
@@ -660,6 +669,27 @@ struct VectorTest
     for (size_t ii = 0; ii < dim; ++ii) {
       EXPECT_TRUE(DSC::FloatCmp::eq(ScalarType(1), ones[ii])) << "check copy-on-write";
     }
+
+    //test axpby
+    VectorImp result_axpby = testvector_4;
+    result_axpby.axpby(ScalarType(2.75), testvector_3, ScalarType(-0.5));
+    correct_result = testvector_4;
+    correct_result.scal(ScalarType(-0.5));
+    correct_result.axpy(ScalarType(2.75), testvector_3);
+    EXPECT_EQ(correct_result, result_axpby);
+    a = ones;
+    a.axpby(ScalarType(2), testvector_3, ScalarType(3));
+    for (size_t ii = 0; ii < dim; ++ii) {
+      EXPECT_TRUE(DSC::FloatCmp::eq(ScalarType(1), ones[ii])) << "check copy-on-write";
+    }
+    VectorImp wrong_size(2*dim);
+    EXPECT_THROW(a.axpby(ScalarType(1), wrong_size, ScalarType(1)), Stuff::Exceptions::shapes_do_not_match);
+
+    //test dot_and_l2_norm
+    const auto dot_and_l2_norm = testvector_5.dot_and_l2_norm(testvector_4);
+    EXPECT_DOUBLE_EQ(std::real(testvector_5.dot(testvector_4)), std::real(dot_and_l2_norm.first));
+    EXPECT_DOUBLE_EQ(RealType(std::sqrt(20.0625)), dot_and_l2_norm.second);
+    EXPECT_THROW(a.dot_and_l2_norm(wrong_size), Stuff::Exceptions::shapes_do_not_match);
   } //void produces_correct_results() const
 }; // struct VectorTest
 
@@ -716,6 +746,10 @@ struct MatrixTest
         pattern.inner(ii).push_back(jj);
     }
     MatrixImp d_by_size_and_pattern(dim, dim, pattern);
+    const MatrixImp d_by_size_and_compressed_pattern(dim, dim, Stuff::LA::SparsityPatternCSR(pattern));
+    for (size_t ii = 0; ii < dim; ++ii)
+      for (size_t jj = 0; jj < dim; ++jj)
+        EXPECT_DOUBLE_OR_COMPLEX_EQ(D_RealType(0), d_by_size_and_compressed_pattern.get_entry(ii, jj));
     size_t d_rows = d_by_size.rows();
     EXPECT_EQ(dim, d_rows);
     size_t d_cols = d_by_size.cols();
@@ -768,6 +802,23 @@ struct MatrixTest
         EXPECT_DOUBLE_OR_COMPLEX_EQ(D_RealType(2*ii + 2*jj + 1), d_by_size_and_pattern.get_entry(ii, jj));
       }
     }
+    // local rows and cols are not sorted, local entries are added to the global ones
+    const std::vector< size_t > local_rows = {dim - 1, 0};
+    const std::vector< size_t > local_cols = {2, dim - 1, 0};
+    Dune::DynamicMatrix< D_ScalarType > local_matrix(local_rows.size(), local_cols.size());
+    for (size_t ii = 0; ii < local_rows.size(); ++ii)
+      for (size_t jj = 0; jj < local_cols.size(); ++jj)
+        local_matrix[ii][jj] = D_ScalarType(local_rows[ii] * dim + local_cols[jj]);
+    d_by_size_and_pattern.add_local(local_rows, local_cols, local_matrix);
+    d_by_size_and_pattern.InterfaceType::add_local(local_rows, local_cols, local_matrix);
+    for (size_t ii = 0; ii < d_rows; ++ii) {
+      for (size_t jj = 0; jj < d_cols; ++jj) {
+        const bool local = std::count(local_rows.begin(), local_rows.end(), ii)
+                           && std::count(local_cols.begin(), local_cols.end(), jj);
+        EXPECT_DOUBLE_OR_COMPLEX_EQ(D_RealType(2*ii + 2*jj + 1) + (local ? D_RealType(2*(ii*dim + jj)) : D_RealType(0)),
+                                    d_by_size_and_pattern.get_entry(ii, jj));
+      }
+    }
   } //void fulfills_interface() const
 
   void produces_correct_results() const
@@ -983,3 +1034,87 @@ TYPED_TEST(MatrixTest, produces_correct_results) {
   this->produces_correct_results();
 }
 
+
+#if HAVE_DUNE_ISTL
+
+TEST(IstlBlockSparseMatrix, behaves_like_the_scalar_matrix)
+{
+  typedef Stuff::LA::IstlRowMajorSparseMatrix< double >  ScalarMatrixType;
+  typedef Stuff::LA::IstlDenseVector< double >           ScalarVectorType;
+  typedef Stuff::LA::IstlBlockSparseMatrix< double, 3 >  BlockMatrixType;
+  typedef Stuff::LA::IstlDenseBlockVector< double, 3 >   BlockVectorType;
+  // a tridiagonal matrix of size 9, the blocks (0, 1), (1, 0), (1, 2) and (2, 1) are only partially occupied
+  const size_t size = 9;
+  Stuff::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = (ii > 0 ? ii - 1 : 0); jj < std::min(ii + 2, size); ++jj)
+      pattern.inner(ii).push_back(jj);
+  ScalarMatrixType scalar_matrix(size, size, pattern);
+  BlockMatrixType block_matrix(size, size, pattern);
+  EXPECT_EQ(size, block_matrix.rows());
+  EXPECT_EQ(size, block_matrix.cols());
+  EXPECT_EQ(size_t(7*9), block_matrix.non_zeros());
+  ScalarVectorType scalar_vector(size);
+  BlockVectorType block_vector(size);
+  for (size_t ii = 0; ii < size; ++ii) {
+    scalar_vector.set_entry(ii, 1.0 + ii);
+    block_vector.set_entry(ii, 1.0 + ii);
+    for (const size_t jj : pattern.inner(ii)) {
+      scalar_matrix.set_entry(ii, jj, ii == jj ? 2.0 : -1.0 - ii);
+      block_matrix.set_entry(ii, jj, ii == jj ? 2.0 : -1.0 - ii);
+    }
+  }
+  ScalarVectorType scalar_result(size);
+  BlockVectorType block_result(size);
+  scalar_matrix.mv(scalar_vector, scalar_result);
+  block_matrix.mv(block_vector, block_result);
+  for (size_t ii = 0; ii < size; ++ii) {
+    EXPECT_EQ(scalar_result[ii], block_result[ii]);
+    for (size_t jj = 0; jj < size; ++jj)
+      EXPECT_EQ(scalar_matrix.get_entry(ii, jj), block_matrix.get_entry(ii, jj));
+  }
+  EXPECT_EQ(scalar_matrix.pattern(true), block_matrix.pattern(true));
+  EXPECT_EQ(pattern, block_matrix.pruned().pattern(true));
+  // sizes have to be multiples of the block size
+  EXPECT_THROW(BlockMatrixType(size + 1, size), Stuff::Exceptions::shapes_do_not_match);
+  EXPECT_THROW(BlockVectorType(size - 1), Stuff::Exceptions::shapes_do_not_match);
+  // the pattern has to fit into the matrix
+  pattern.inner(size - 1).push_back(size);
+  EXPECT_THROW(BlockMatrixType(size, size, pattern), Stuff::Exceptions::shapes_do_not_match);
+} // TEST(IstlBlockSparseMatrix, behaves_like_the_scalar_matrix)
+
+TEST(IstlSparseMatrices, add_local_outside_of_pattern)
+{
+  // a tridiagonal pattern, for blocks of size 2 the blocks (0, 2) and (2, 0) are not contained in it
+  const size_t size = 6;
+  Stuff::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = (ii > 0 ? ii - 1 : 0); jj < std::min(ii + 2, size); ++jj)
+      pattern.inner(ii).push_back(jj);
+  Stuff::LA::IstlRowMajorSparseMatrix< double > scalar_matrix(size, size, pattern);
+  Stuff::LA::IstlBlockSparseMatrix< double, 2 > block_matrix(size, size, pattern);
+  Dune::DynamicMatrix< double > local_matrix(1, 2, 1.);
+  scalar_matrix.add_local({1}, {0, 2}, local_matrix);
+  block_matrix.add_local({1}, {0, 3}, local_matrix);
+  EXPECT_EQ(1., scalar_matrix.get_entry(1, 2));
+  EXPECT_EQ(1., block_matrix.get_entry(1, 3));
+  EXPECT_THROW(scalar_matrix.add_local({1}, {0, 3}, local_matrix), Stuff::Exceptions::index_out_of_range);
+  EXPECT_THROW(scalar_matrix.add_local({5}, {3, 0}, local_matrix), Stuff::Exceptions::index_out_of_range);
+  EXPECT_THROW(block_matrix.add_local({1}, {0, 4}, local_matrix), Stuff::Exceptions::index_out_of_range);
+  EXPECT_THROW(block_matrix.add_local({5}, {3, 0}, local_matrix), Stuff::Exceptions::index_out_of_range);
+  // the first row is contained in the pattern, the second is not, nothing is added
+  const Dune::DynamicMatrix< double > two_rows(2, 2, 1.);
+  EXPECT_THROW(scalar_matrix.add_local({4, 1}, {3, 4}, two_rows), Stuff::Exceptions::index_out_of_range);
+  EXPECT_THROW(block_matrix.add_local({4, 1}, {3, 4}, two_rows), Stuff::Exceptions::index_out_of_range);
+  for (const size_t jj : {3, 4}) {
+    EXPECT_EQ(0., scalar_matrix.get_entry(4, jj));
+    EXPECT_EQ(0., block_matrix.get_entry(4, jj));
+  }
+} // TEST(IstlSparseMatrices, add_local_outside_of_pattern)
+
+#else // HAVE_DUNE_ISTL
+
+TEST(DISABLED_IstlBlockSparseMatrix, behaves_like_the_scalar_matrix) {}
+TEST(DISABLED_IstlSparseMatrices, add_local_outside_of_pattern) {}
+
+#endif // HAVE_DUNE_ISTL
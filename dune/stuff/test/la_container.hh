@@ -69,6 +69,32 @@ public:
     return matrix;
   }
 };
+
+template< class S, size_t blocksize >
+class ContainerFactory< Dune::Stuff::LA::IstlDenseBlockVector< S, blocksize > >
+{
+public:
+  static Dune::Stuff::LA::IstlDenseBlockVector< S, blocksize > create(const size_t size)
+  {
+    return Dune::Stuff::LA::IstlDenseBlockVector< S, blocksize >(size, S(1));
+  }
+};
+
+template< class S, size_t blocksize >
+class ContainerFactory< Dune::Stuff::LA::IstlBlockSparseMatrix< S, blocksize > >
+{
+public:
+  static Dune::Stuff::LA::IstlBlockSparseMatrix< S, blocksize > create(const size_t size)
+  {
+    Dune::Stuff::LA::SparsityPatternDefault pattern(size);
+    for (size_t ii = 0; ii < size; ++ii)
+      pattern.inner(ii).push_back(ii);
+    Dune::Stuff::LA::IstlBlockSparseMatrix< S, blocksize > matrix(size, size, pattern);
+    for (size_t ii = 0; ii < size; ++ii)
+      matrix.unit_row(ii);
+    return matrix;
+  }
+};
 #endif // HAVE_DUNE_ISTL
 
 
@@ -0,0 +1,113 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <algorithm>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/parallel/threadmanager.hh>
+#include <dune/stuff/la/container/accumulator.hh>
+#include <dune/stuff/la/container/eigen.hh>
+#include <dune/stuff/la/container/istl.hh>
+#include <dune/stuff/la/container/pattern.hh>
+
+using namespace Dune::Stuff;
+
+
+// assembles the 1d P1 stiffness matrix (without the mesh size, with an element dependent factor) in parallel and
+// compares it to the serially assembled one
+template< class MatrixType >
+void check_parallel_assembly()
+{
+  const Dune::Stuff::Test::ScopedThreads threads(4);
+  const size_t num_elements = 1000;
+  LA::SparsityPatternBuilder builder(num_elements + 1);
+  for (size_t ee = 0; ee < num_elements; ++ee)
+    builder.insert(std::vector< size_t >({ee, ee + 1}), std::vector< size_t >({ee, ee + 1}));
+  const auto pattern = builder.build();
+  MatrixType matrix(num_elements + 1, num_elements + 1, pattern);
+  MatrixType serial_matrix(num_elements + 1, num_elements + 1, pattern);
+  const auto factor = [](const size_t ee) { return 1. + double(ee % 7); };
+  {
+    // few locks, so that different rows share a lock, too
+    LA::MatrixAccumulator< MatrixType > accumulator(matrix, 3);
+    const auto pool = threadManager().pool();
+    ASSERT_EQ(size_t(4), pool->size());
+    // one chunk per element, so that neighboring elements (which share a row) are likely processed concurrently
+    pool->parallel_for(0, num_elements, num_elements, [&](const size_t first, const size_t last) {
+      for (size_t ee = first; ee < last; ++ee) {
+        const std::vector< size_t > indices = {ee, ee + 1};
+        accumulator.add_to_row(ee, indices, std::vector< double >({factor(ee), -factor(ee)}));
+        accumulator.add_to_entry(ee + 1, ee, -factor(ee));
+        accumulator.add_to_entry(ee + 1, ee + 1, factor(ee));
+      }
+    });
+  }
+  for (size_t ee = 0; ee < num_elements; ++ee) {
+    serial_matrix.add_to_entry(ee, ee, factor(ee));
+    serial_matrix.add_to_entry(ee, ee + 1, -factor(ee));
+    serial_matrix.add_to_entry(ee + 1, ee, -factor(ee));
+    serial_matrix.add_to_entry(ee + 1, ee + 1, factor(ee));
+  }
+  for (size_t ii = 0; ii <= num_elements; ++ii)
+    for (size_t jj = (ii > 0 ? ii - 1 : 0); jj <= std::min(ii + 1, num_elements); ++jj)
+      EXPECT_EQ(serial_matrix.get_entry(ii, jj), matrix.get_entry(ii, jj)) << "entry (" << ii << ", " << jj << ")";
+} // ... check_parallel_assembly(...)
+
+
+#if HAVE_DUNE_ISTL
+
+TEST(MatrixAccumulator, istl_parallel_assembly)
+{
+  check_parallel_assembly< LA::IstlRowMajorSparseMatrix< double > >();
+}
+
+#else // HAVE_DUNE_ISTL
+
+TEST(DISABLED_MatrixAccumulator, istl_parallel_assembly) {}
+
+#endif // HAVE_DUNE_ISTL
+#if HAVE_EIGEN
+
+TEST(MatrixAccumulator, eigen_parallel_assembly)
+{
+  check_parallel_assembly< LA::EigenRowMajorSparseMatrix< double > >();
+}
+
+# ifndef NDEBUG
+
+// the unchecked fast path does not insert entries, in debug builds it throws for entries not in the pattern
+TEST(MatrixAccumulator, eigen_entry_not_in_pattern)
+{
+  typedef LA::EigenRowMajorSparseMatrix< double > MatrixType;
+  LA::SparsityPatternDefault pattern(3);
+  pattern.inner(0) = {0, 1};
+  pattern.inner(1) = {1, 2};
+  pattern.inner(2) = {2};
+  MatrixType matrix(3, 3, pattern);
+  LA::MatrixAccumulator< MatrixType > accumulator(matrix);
+  accumulator.add_to_entry(1, 2, 1.);
+  EXPECT_THROW(accumulator.add_to_entry(0, 2, 1.), Exceptions::index_out_of_range);
+  EXPECT_THROW(accumulator.add_to_entry(1, 0, 1.), Exceptions::index_out_of_range);
+  EXPECT_THROW(accumulator.add_to_row(2, std::vector< size_t >({1, 2}), std::vector< double >({1., 1.})),
+               Exceptions::index_out_of_range);
+  EXPECT_EQ(1., matrix.get_entry(1, 2));
+  EXPECT_EQ(0., matrix.get_entry(1, 1));
+  EXPECT_EQ(0., matrix.get_entry(2, 2));
+} // TEST(MatrixAccumulator, eigen_entry_not_in_pattern)
+
+# else // NDEBUG
+
+TEST(DISABLED_MatrixAccumulator, eigen_entry_not_in_pattern) {}
+
+# endif // NDEBUG
+#else // HAVE_EIGEN
+
+TEST(DISABLED_MatrixAccumulator, eigen_parallel_assembly) {}
+TEST(DISABLED_MatrixAccumulator, eigen_entry_not_in_pattern) {}
+
+#endif // HAVE_EIGEN
@@ -0,0 +1,156 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/common.hh>
+#include <dune/stuff/la/container/kernels.hh>
+
+using namespace Dune::Stuff;
+using namespace Dune::Stuff::LA;
+
+
+// switches back to the default instruction set when leaving the scope
+struct ScopedInstructionSet
+{
+  explicit ScopedInstructionSet(const Kernels::InstructionSet set)
+  {
+    Kernels::use_instruction_set(set);
+  }
+
+  ~ScopedInstructionSet()
+  {
+    Kernels::use_instruction_set(Kernels::best_instruction_set());
+  }
+}; // struct ScopedInstructionSet
+
+
+static std::vector< double > random_values(const size_t size, const unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution< double > distribution(-1., 1.);
+  std::vector< double > values(size);
+  for (auto& value : values)
+    value = distribution(generator);
+  return values;
+}
+
+
+TEST(Kernels, instruction_sets)
+{
+  EXPECT_TRUE(Kernels::supports(Kernels::InstructionSet::scalar));
+  EXPECT_TRUE(Kernels::supports(Kernels::best_instruction_set()));
+  EXPECT_EQ(Kernels::best_instruction_set(), Kernels::instruction_set());
+  {
+    ScopedInstructionSet scalar(Kernels::InstructionSet::scalar);
+    EXPECT_EQ(Kernels::InstructionSet::scalar, Kernels::instruction_set());
+  }
+  EXPECT_EQ(Kernels::best_instruction_set(), Kernels::instruction_set());
+  for (const auto set : {Kernels::InstructionSet::avx2, Kernels::InstructionSet::avx512}) {
+    if (!Kernels::supports(set))
+      EXPECT_THROW(Kernels::use_instruction_set(set), Exceptions::wrong_input_given);
+  }
+} // TEST(Kernels, instruction_sets)
+
+TEST(Kernels, agree_with_scalar_variants)
+{
+  const double tolerance = 1e-13;
+  // all remainders of the vectorized loops and a length where those are irrelevant
+  for (const size_t size : {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100003}) {
+    const auto xx = random_values(size, 1);
+    const auto yy = random_values(size, 2);
+    auto with_nan = xx;
+    if (size > 0) {
+      with_nan[size / 2] = 3.;
+      with_nan[size - 1] = -3.;
+      with_nan[0] = std::numeric_limits< double >::quiet_NaN();
+    }
+    std::vector< double > expected_axpby = yy, expected_scal = xx, expected_add(size), expected_sub = xx;
+    double expected_dot, expected_l1_norm, expected_l2_norm;
+    std::pair< size_t, double > expected_amax;
+    {
+      ScopedInstructionSet scalar(Kernels::InstructionSet::scalar);
+      expected_dot = Kernels::dot(size, xx.data(), yy.data());
+      expected_l1_norm = Kernels::l1_norm(size, xx.data());
+      expected_l2_norm = Kernels::l2_norm(size, xx.data());
+      expected_amax = Kernels::amax(size, with_nan.data());
+      Kernels::axpby(size, 0.25, xx.data(), -1.5, expected_axpby.data());
+      Kernels::scal(size, 1.75, expected_scal.data());
+      Kernels::add(size, xx.data(), yy.data(), expected_add.data());
+      Kernels::sub(size, expected_sub.data(), yy.data(), expected_sub.data());
+    }
+    if (size > 1) {
+      EXPECT_EQ(size / 2, expected_amax.first);
+      EXPECT_EQ(3., expected_amax.second);
+    }
+    for (const auto set : {Kernels::InstructionSet::scalar,
+                           Kernels::InstructionSet::avx2,
+                           Kernels::InstructionSet::avx512}) {
+      if (!Kernels::supports(set))
+        continue;
+      ScopedInstructionSet current(set);
+      const double scale = std::max(1., double(size));
+      EXPECT_NEAR(expected_dot, Kernels::dot(size, xx.data(), yy.data()), tolerance * scale);
+      EXPECT_NEAR(expected_l1_norm, Kernels::l1_norm(size, xx.data()), tolerance * scale);
+      EXPECT_NEAR(expected_l2_norm, Kernels::l2_norm(size, xx.data()), tolerance * scale);
+      EXPECT_EQ(expected_amax, Kernels::amax(size, with_nan.data()));
+      EXPECT_EQ(expected_amax.second, Kernels::sup_norm(size, with_nan.data()));
+      const auto dot_and_l2_norm = Kernels::dot_and_l2_norm(size, xx.data(), yy.data());
+      EXPECT_NEAR(expected_dot, dot_and_l2_norm.first, tolerance * scale);
+      EXPECT_NEAR(expected_l2_norm, dot_and_l2_norm.second, tolerance * scale);
+      auto result = yy;
+      Kernels::axpby(size, 0.25, xx.data(), -1.5, result.data());
+      for (size_t ii = 0; ii < size; ++ii)
+        EXPECT_NEAR(expected_axpby[ii], result[ii], tolerance);
+      result = xx;
+      Kernels::scal(size, 1.75, result.data());
+      EXPECT_EQ(expected_scal, result);
+      Kernels::add(size, xx.data(), yy.data(), result.data());
+      EXPECT_EQ(expected_add, result);
+      result = xx;
+      Kernels::sub(size, result.data(), yy.data(), result.data());
+      EXPECT_EQ(expected_sub, result);
+    }
+  }
+} // TEST(Kernels, agree_with_scalar_variants)
+
+TEST(Kernels, used_by_common_dense_vector)
+{
+  const size_t size = 1001;
+  const auto values = random_values(size, 3);
+  CommonDenseVector< double > xx(size), yy(size, 0.5);
+  for (size_t ii = 0; ii < size; ++ii)
+    xx[ii] = values[ii];
+  xx[17] = -2.;
+  const auto expected_dot = xx.dot(yy);
+  const auto expected_l2_norm = xx.l2_norm();
+  for (const auto set : {Kernels::InstructionSet::scalar,
+                         Kernels::InstructionSet::avx2,
+                         Kernels::InstructionSet::avx512}) {
+    if (!Kernels::supports(set))
+      continue;
+    ScopedInstructionSet current(set);
+    EXPECT_EQ(std::make_pair(size_t(17), 2.), xx.amax());
+    const auto dot_and_l2_norm = yy.dot_and_l2_norm(xx);
+    EXPECT_NEAR(expected_dot, dot_and_l2_norm.first, 1e-12);
+    EXPECT_NEAR(0.5 * std::sqrt(double(size)), dot_and_l2_norm.second, 1e-12);
+    EXPECT_NEAR(expected_l2_norm, xx.l2_norm(), 1e-12);
+    // copy-on-write
+    auto zz = yy;
+    zz.axpby(2., xx, -1.);
+    for (size_t ii = 0; ii < size; ++ii) {
+      EXPECT_EQ(0.5, yy.get_entry(ii));
+      EXPECT_NEAR(2. * xx.get_entry(ii) - 0.5, zz.get_entry(ii), 1e-15);
+    }
+  }
+} // TEST(Kernels, used_by_common_dense_vector)
@@ -0,0 +1,67 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/parallel/threadmanager.hh>
+#include <dune/stuff/la/container/pattern.hh>
+
+using namespace Dune::Stuff;
+using namespace Dune::Stuff::LA;
+
+
+TEST(SparsityPatternCSR, from_default)
+{
+  SparsityPatternDefault pattern(3);
+  pattern.insert(0, 2);
+  pattern.insert(0, 0);
+  pattern.inner(2).push_back(1);
+  pattern.inner(2).push_back(1);
+  const SparsityPatternCSR compressed(pattern);
+  ASSERT_EQ(size_t(3), compressed.size());
+  EXPECT_EQ(size_t(3), compressed.nonzeros());
+  EXPECT_EQ(std::vector< size_t >({0, 2, 2, 3}), compressed.row_offsets());
+  EXPECT_EQ(std::vector< size_t >({0, 2, 1}), compressed.column_indices());
+  EXPECT_TRUE(compressed.contains(0, 2));
+  EXPECT_FALSE(compressed.contains(0, 1));
+  EXPECT_TRUE(compressed.inner(1).empty());
+  EXPECT_THROW(SparsityPatternCSR(std::vector< size_t >({0, 2}), std::vector< size_t >({1, 1})),
+               Exceptions::wrong_input_given);
+} // TEST(SparsityPatternCSR, from_default)
+
+TEST(SparsityPatternBuilder, build)
+{
+  // the pattern of a 1d P1 discretization with 100 elements, each entry is inserted by several elements
+  const size_t num_elements = 100;
+  SparsityPatternDefault expected(num_elements + 1);
+  SparsityPatternBuilder builder(num_elements + 1);
+  for (size_t ee = 0; ee < num_elements; ++ee) {
+    const std::vector< size_t > indices = {ee + 1, ee};
+    for (const auto& ii : indices)
+      for (const auto& jj : indices)
+        expected.insert(ii, jj);
+    builder.insert(indices, indices);
+  }
+  const auto pattern = builder.build();
+  EXPECT_EQ(SparsityPatternCSR(expected), pattern);
+  EXPECT_EQ(size_t(3*(num_elements + 1) - 2), pattern.nonzeros());
+  // the builder is empty afterwards
+  EXPECT_EQ(size_t(0), builder.build().nonzeros());
+  // the same, inserted concurrently, with few locks so that different rows share a lock, too
+  const Dune::Stuff::Test::ScopedThreads threads(4);
+  const auto pool = threadManager().pool();
+  ASSERT_EQ(size_t(4), pool->size());
+  SparsityPatternBuilder threaded_builder(num_elements + 1, 3);
+  pool->parallel_for(0, num_elements, num_elements, [&](const size_t first, const size_t last) {
+    for (size_t ee = first; ee < last; ++ee) {
+      threaded_builder.insert(std::vector< size_t >({ee + 1, ee}), std::vector< size_t >({ee + 1, ee}));
+      threaded_builder.insert(ee, ee);
+    }
+  });
+  EXPECT_EQ(pattern, threaded_builder.build());
+} // TEST(SparsityPatternBuilder, build)
@@ -35,6 +35,7 @@ typedef testing::Types< std::tuple< CommonDenseMatrix< double >, CommonDenseVect
 #endif // HAVE_EIGEN
 #if HAVE_DUNE_ISTL
                       , std::tuple< IstlRowMajorSparseMatrix< double >, IstlDenseVector< double >, IstlDenseVector< double > >
+                      , std::tuple< IstlBlockSparseMatrix< double, 2 >, IstlDenseBlockVector< double, 2 >, IstlDenseBlockVector< double, 2 > >
 #endif
                       > MatrixVectorCombinations;
 